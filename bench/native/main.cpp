@@ -0,0 +1,106 @@
+/*
+ * bench/native/main.cpp - Host build of the platform-independent kernels (pio run -e native)
+ *
+ * Times the same font, morph-table, easing and mirror-codec code the firmware uses, so changes to
+ * them can be profiled with host tools (perf, callgrind) before flashing. The TFT renderer and
+ * /api/state serialization need the Arduino core; env:cyd_bench covers those on the device.
+ * Output is the include/bench.h JSON lines format, in nanoseconds.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "config.h"
+#include "fonts.h"
+#include "easing.h"
+#include "morph.h"
+#include "mirror_codec.h"
+#include "bench.h"
+
+static const uint32_t ITERS = 200;
+static volatile uint32_t sink;   // results go here so the optimizer can't drop a kernel
+
+static uint8_t frameA[LED_MATRIX_H][LED_MATRIX_W];
+static uint8_t frameB[LED_MATRIX_H][LED_MATRIX_W];
+static uint8_t msg[MIRROR_CODEC_HDR + LED_MATRIX_W * LED_MATRIX_H];
+
+static Pt pointPool[FONT_MAX_SET_PIXELS];
+static MorphIdx orderPool[(size_t)FONT_MAX_SET_PIXELS * 10];
+
+static void emit(const BenchResult& r) {
+  char line[192];
+  benchFormat(r, line, sizeof(line));
+  puts(line);
+}
+
+// Six digits side by side (no colons); the last one at the given intensity
+static void composeClock(uint8_t (*f)[LED_MATRIX_W], const FontDesc& font, const char* digits, uint8_t lastV) {
+  memset(f, 0, LED_MATRIX_W * LED_MATRIX_H);
+  for (int i = 0; i < 6; i++) {
+    const GlyphRef g = font.digit(digits[i] - '0');
+    const int x0 = i * (font.w + FONT_GAP);
+    for (int y = 0; y < g.h && y < LED_MATRIX_H; y++) {
+      for (int x = 0; x < g.w && x0 + x < LED_MATRIX_W; x++) {
+        if (g.px(x, y)) f[y][x0 + x] = i == 5 ? lastV : 255;
+      }
+    }
+  }
+}
+
+int main() {
+  printf("{\"benchStart\":\"%s\",\"matrix\":[%d,%d],\"host\":true}\n", FIRMWARE_VERSION, LED_MATRIX_W,
+         LED_MATRIX_H);
+  uint32_t kernels = 0;
+  auto run = [&](const BenchResult& r) { emit(r); kernels++; };
+
+  // Morph tables for every font: point lists, one cold pair, all 100 pairs
+  for (int f = 0; f < FONT_STYLE_COUNT; f++) {
+    const FontDesc& font = FONTS[f];
+    MorphSet set{};
+    set.pts = pointPool;
+    set.order = orderPool;
+    set.capPts = FONT_MAX_SET_PIXELS;
+    char name[64];
+
+    snprintf(name, sizeof(name), "buildPixelsFromGlyph.%s", font.name);
+    run(benchRun(name, ITERS, [&] { sink = (uint32_t)buildPixelsFromGlyph(font.digit(8), pointPool, FONT_MAX_SET_PIXELS); }));
+
+    snprintf(name, sizeof(name), "morphBind.%s", font.name);
+    run(benchRun(name, ITERS, [&] { set.rows = nullptr; }, [&] { sink = morphBind(set, font.digit(0)); }));
+
+    snprintf(name, sizeof(name), "morphPair.cold.%s", font.name);
+    run(benchRun(name, ITERS, [&] { set.ready[1] &= (uint16_t)~(1u << 8); },
+                 [&] { sink = *morphPair(set, 1, 8); }));
+
+    snprintf(name, sizeof(name), "morphTables.%s", font.name);
+    run(benchRun(name, 20, [&] { memset(set.ready, 0, sizeof(set.ready)); }, [&] {
+      for (int a = 0; a < 10; a++) {
+        for (int b = 0; b < 10; b++) sink = *morphPair(set, a, b);
+      }
+    }));
+  }
+
+  // Easing: one frame's worth of lookups for a busy animation
+  run(benchRun("easeQ8.x1024", ITERS, [] {
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < 1024; i++) acc += (uint32_t)easeQ8((uint8_t)(i % EASE_CURVE_COUNT), i * 64);
+    sink = acc;
+  }));
+
+  // Mirror codec: keyframe and one-second delta with the last digit mid-fade
+  composeClock(frameA, FONTS[0], "123456", 255);
+  composeClock(frameB, FONTS[0], "123457", 128);
+  run(benchRun("mirrorEncode.key", ITERS, [] {
+    sink = (uint32_t)mirrorEncode(&frameB[0][0], nullptr, 2, 2, LED_MATRIX_W, LED_MATRIX_H, msg);
+  }));
+  run(benchRun("mirrorEncode.delta", ITERS, [] {
+    sink = (uint32_t)mirrorEncode(&frameB[0][0], &frameA[0][0], 2, 1, LED_MATRIX_W, LED_MATRIX_H, msg);
+  }));
+  run(benchRun("mirrorEncode.same", ITERS, [] {
+    sink = (uint32_t)mirrorEncode(&frameA[0][0], &frameA[0][0], 2, 1, LED_MATRIX_W, LED_MATRIX_H, msg);
+  }));
+
+  printf("{\"benchEnd\":%u}\n", (unsigned)kernels);
+  return 0;
+}
@@ -0,0 +1,93 @@
+/*
+ * bench.h - Kernel timing harness for the benchmark builds (env:cyd_bench, env:native)
+ *
+ * benchRun() times each iteration of a kernel separately and keeps min / median / p90 / max / mean,
+ * so one preempted iteration shows up in max instead of skewing the whole result. On the ESP32 the
+ * unit is CPU cycles (esp_cpu_get_cycle_count(), the current core's CCOUNT register); on a host it
+ * is nanoseconds from steady_clock. benchFormat() prints one JSON object per line:
+ *
+ *   {"bench":"renderFBToTFT.full","iters":50,"min":...,"median":...,"p90":...,"max":...,"mean":...,"unit":"cycles"}
+ *
+ * Only the newest BENCH_MAX_SAMPLES iterations feed the percentiles; mean covers all of them.
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <algorithm>
+
+#ifndef BENCH_MAX_SAMPLES
+#define BENCH_MAX_SAMPLES 128
+#endif
+
+#ifdef ESP_PLATFORM
+#include <esp_idf_version.h>
+#if ESP_IDF_VERSION_MAJOR >= 5
+#include <esp_cpu.h>
+static inline uint32_t benchNow() { return (uint32_t)esp_cpu_get_cycle_count(); }
+#else
+#include <hal/cpu_hal.h>   // IDF 4.x (Arduino-ESP32 2.x) name for the same register
+static inline uint32_t benchNow() { return cpu_hal_get_cycle_count(); }
+#endif
+#define BENCH_UNIT "cycles"
+#else
+#include <chrono>
+static inline uint32_t benchNow() {
+  return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+#define BENCH_UNIT "ns"
+#endif
+
+struct BenchResult {
+  const char* name;
+  uint32_t iters;
+  uint32_t min, median, p90, max, mean;
+};
+
+/**
+ * Run fn() iters times, timing each call; prep() runs before each call, outside the timed region
+ * (reset state so every iteration does the same work)
+ */
+template <typename Prep, typename Fn>
+static BenchResult benchRun(const char* name, uint32_t iters, Prep&& prep, Fn&& fn) {
+  static uint32_t samples[BENCH_MAX_SAMPLES];
+  uint64_t total = 0;
+  for (uint32_t i = 0; i < iters; i++) {
+    prep();
+    const uint32_t t0 = benchNow();
+    fn();
+    const uint32_t dt = benchNow() - t0;   // unsigned: correct across one counter wrap
+    samples[i % BENCH_MAX_SAMPLES] = dt;
+    total += dt;
+  }
+
+  BenchResult r{name, iters, 0, 0, 0, 0, 0};
+  const uint32_t n = iters < BENCH_MAX_SAMPLES ? iters : BENCH_MAX_SAMPLES;
+  if (!n) return r;
+  std::sort(samples, samples + n);
+  r.min = samples[0];
+  r.median = samples[n / 2];
+  r.p90 = samples[(n * 9) / 10 < n ? (n * 9) / 10 : n - 1];
+  r.max = samples[n - 1];
+  r.mean = (uint32_t)(total / iters);
+  return r;
+}
+
+template <typename Fn>
+static BenchResult benchRun(const char* name, uint32_t iters, Fn&& fn) {
+  return benchRun(name, iters, [] {}, fn);
+}
+
+// One report line (no newline); returns the snprintf length
+static inline int benchFormat(const BenchResult& r, char* out, size_t cap) {
+  return snprintf(out, cap,
+                  "{\"bench\":\"%s\",\"iters\":%u,\"min\":%u,\"median\":%u,\"p90\":%u,\"max\":%u,\"mean\":%u,"
+                  "\"unit\":\"" BENCH_UNIT "\"}",
+                  r.name, (unsigned)r.iters, (unsigned)r.min, (unsigned)r.median, (unsigned)r.p90,
+                  (unsigned)r.max, (unsigned)r.mean);
+}
+
+#endif // BENCH_H
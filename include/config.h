@@ -18,34 +18,57 @@
 #define LED_MATRIX_H 32
 #endif
 
+// Framebuffer bits per LED (include/framebuffer.h): 8 = 256 levels, 4 = 16 levels (fades step),
+// 1 = on/off (fades become a switch at half intensity). Fewer bits = 2-8x less RAM per frame slot.
+#ifndef FB_BPP
+#define FB_BPP 8
+#endif
+
 // Default "LED" rendered size (in TFT pixels) and spacing between LEDs (pitch simulation)
 // Adjust in Web UI later (stored in config).
 #define DEFAULT_LED_DIAMETER 5     // pixels (max, fills the pitch completely)
 #define DEFAULT_LED_GAP      0     // pixels (no gap for maximum fill)
+#define DEFAULT_LED_SHAPE    0     // 0=square, 1=round, 2=soft round
+#define DEFAULT_FONT_STYLE   0     // 0=7-segment, 1=bold pixel, 2=thin, 3=dot matrix, 4=small seconds
+#define DEFAULT_MORPH_STYLE  0     // 0=particle, 1=spawn, 2=crossfade, 3=slide, 4=scramble
+#define DEFAULT_VIEWPORT     0     // TFT view: 0=whole matrix, 1=clock, 2=HH:MM, 3=date row
+
+// Largest LED pitch (TFT pixels) the dot stamp blitter handles; larger pitches use fillRect
+#define DOT_STAMP_MAX 16
 
 // Reserve space below the matrix for status/info
 #define STATUS_BAR_H 50            // pixels (bottom status bar)
+#define STATUS_ROTATE_MS 5000      // extra status field (pressure / IP / uptime) rotation
+#define STATUS_SCROLL_MS 50        // 1 px marquee step for status text wider than its slot
+#define STATUS_SCROLL_PAUSE_MS 2000  // hold at the start of each marquee pass
 
 // Default LED color (RGB565). Start with red.
 #define DEFAULT_LED_COLOR_565 0xF800
 
+// Number of color bands in the palette LUT (each band = 256 x RGB565 = 512 bytes)
+#define PALETTE_BANDS 8
+
 // ===== TIME / NTP =====
 #define DEFAULT_TZ "Sydney, Australia"    // Timezone name from timezones.h
 #define DEFAULT_NTP "pool.ntp.org"
 #define DEFAULT_24H true
 
 // ===== SENSOR CONFIGURATION =====
-// Choose your sensor type by uncommenting ONE of the following:
-// #define USE_BME280        // BME280: Temperature, Humidity, Pressure sensor
-// #define USE_SHT3X         // SHT3X: Temperature and Humidity sensor (no pressure)
-#define USE_HTU21D           // HTU21D: Temperature and Humidity sensor (no pressure) - DEFAULT
+// The sensor is auto-detected at boot by probing the bus (see SENSOR_DRIVERS in main.cpp):
+//   BME280 (temp/humidity/pressure) at 0x76/0x77, SHT3X at 0x44/0x45, HTU21D at 0x40
 
 // I2C pins for sensor (using extended GPIO connector CN1)
 #define SENSOR_SDA_PIN    27    // I2C Data
 #define SENSOR_SCL_PIN    22    // I2C Clock
 
-// Sensor update interval
-#define SENSOR_UPDATE_INTERVAL 60000  // Update sensor every 60 seconds
+// Sensor sampling (runs on its own task; see updateSensorData())
+#define SENSOR_UPDATE_INTERVAL 10000  // Sample every 10 seconds (median-of-3 + EMA before display)
+#define SENSOR_EMA_SHIFT 2            // EMA weight 1/4 per sample
+#define SENSOR_HISTORY_PERIOD_MS 300000  // one history point every 5 minutes
+#define SENSOR_HISTORY_LEN 288        // 24 h of points (6 bytes each, /api/history)
+#define SENSOR_TASK_CORE 0
+#define SENSOR_TASK_PRIO 1
+#define SENSOR_TASK_STACK 3072
 
 // Temperature unit
 #define DEFAULT_TEMP_C true
@@ -56,6 +79,89 @@
 #define LED_G_PIN     16    // Green LED
 #define LED_B_PIN     17    // Blue LED
 
+// ===== BRIGHTNESS / AUTO-DIM =====
+// Brightness is a perceived level (0..255) mapped through the CIE table (include/gamma.h).
+// Auto mode follows the CYD light sensor; schedule mode dims between night start/end hours.
+#define LDR_PIN 34                  // CYD LDR (ADC1, input only)
+#define LDR_SAMPLE_MS 100           // one ADC read per tick from loop(), averaged over LDR_AVG_SAMPLES
+#define LDR_AVG_SAMPLES 16
+#define LDR_DARK_RAW 400            // averaged reading in a dark room (more light = lower reading);
+#define LDR_BRIGHT_RAW 0            //   compare with "ambientRaw" in /api/state to calibrate
+#define DIM_STEP 4                  // max level change per LDR tick, so auto-dim fades
+#define DIM_LUT_STEP 8              // palette LUT brightness quantization (each step is a full redraw)
+#define BACKLIGHT_MIN_DUTY 6        // lowest even backlight PWM; darker levels dim the palette LUT instead
+#define DEFAULT_NIGHT_BRIGHTNESS 40 // also the floor of auto mode in a dark room
+#define DEFAULT_NIGHT_START 22      // hour (local time)
+#define DEFAULT_NIGHT_END 7
+
+// ===== POWER =====
+// Power save runs the CPU at POWER_SAVE_CPU_MHZ and lets loop() and the network tasks block between
+// passes, so idle time is spent in WAITI; WiFi stays associated in modem sleep. Night blank turns the
+// panel and backlight off inside the night window; a touch or POST /api/wake shows the clock for
+// POWER_WAKE_MS. Automatic light sleep needs an IDF build with CONFIG_PM_ENABLE and
+// CONFIG_FREERTOS_USE_TICKLESS_IDLE (not the stock Arduino core) and is only used while blank.
+#define DEFAULT_POWER_SAVE false
+#define DEFAULT_NIGHT_BLANK false
+#define POWER_SAVE_CPU_MHZ 80       // 80 or 160 (WiFi needs at least 80)
+#define POWER_SAVE_LOOP_MS 20       // loop() pass interval in power save
+#define POWER_BLANK_LOOP_MS 50      // ... while the display is blank (also the touch poll rate)
+#define POWER_SAVE_POLL_MS 20       // HTTP / mirror task poll interval in power save
+#define POWER_WAKE_MS 30000         // clock shown this long after a wake inside the blank window
+#define POWER_SAMPLE_MS 1000        // CPU load / current estimate window
+#ifdef HUB75_ENABLE
+#define TOUCH_IRQ_PIN -1            // the HUB75 pins drive the touch controller's SPI lines
+#else
+#define TOUCH_IRQ_PIN 36            // XPT2046 PENIRQ (active LOW, works without SPI setup); -1 = none
+#endif
+
+// Current model behind the /api/perf estimate (mA from the 5 V input; check against a USB meter)
+#define POWER_MA_BOARD 10.0f        // LDO, USB-UART bridge, LDR divider
+#define POWER_MA_CPU_BASE 16.0f     // CPU in WAITI: BASE + IDLE_PER_MHZ x MHz
+#define POWER_MA_CPU_IDLE_PER_MHZ 0.06f
+#define POWER_MA_CPU_BUSY_PER_MHZ 0.16f   // extra with both cores busy, scaled by the mean load
+#define POWER_MA_LIGHT_SLEEP 1.0f   // CPU while automatic light sleep is enabled
+#define POWER_MA_WIFI 12.0f         // associated, modem sleep (beacon wakeups, average)
+#define POWER_MA_TFT 6.0f           // panel logic while not in sleep
+#define POWER_MA_BACKLIGHT 70.0f    // backlight at full PWM duty (scales linearly)
+
+// ===== HUB75 PANEL OUTPUT =====
+// Build with -DHUB75_ENABLE to drive a physical HUB75 panel (chain) from the same framebuffer as the
+// TFT. LED_MATRIX_W/H must match the chain; rows are scanned 1/(LED_MATRIX_H/2).
+// The defaults avoid the CYD's TFT pins, so they take over the SD card, touch, speaker and RGB LED
+// pins (the RGB status LED is disabled) and the sensor's I2C pins on CN1 (R1 = SCL 22, G1 = SDA 27):
+// the CYD has no other free outputs, so while any HUB75 pin is SENSOR_SDA_PIN / SENSOR_SCL_PIN the
+// I2C sensor is not probed (HUB75_SENSOR_PIN_CONFLICT). Boards with free GPIOs should remap them
+// and get the sensor back. -1 = not wired.
+#define HUB75_PIN_R1   22
+#define HUB75_PIN_G1   27
+#define HUB75_PIN_B1   5
+#define HUB75_PIN_R2   18
+#define HUB75_PIN_G2   19
+#define HUB75_PIN_B2   23
+#define HUB75_PIN_A    4
+#define HUB75_PIN_B    16
+#define HUB75_PIN_C    17
+#define HUB75_PIN_D    25
+#define HUB75_PIN_E    -1    // 64-row panels only
+#define HUB75_PIN_LAT  26
+#define HUB75_PIN_OE   32
+#define HUB75_PIN_CLK  33
+#define HUB75_CLOCK_HZ 10000000   // pixel clock: 40 MHz / n, n >= 2
+#define HUB75_COLOR_BITS 6        // bit planes per row (BCM depth); refresh ~305 Hz on 64x32
+#define HUB75_SHORT_PLANES 1      // lowest planes shown with a shortened OE window instead of extra lines
+
+#define HUB75_ON_I2C(p) ((p) == SENSOR_SDA_PIN || (p) == SENSOR_SCL_PIN)
+#if defined(HUB75_ENABLE) &&                                                                       \
+    (HUB75_ON_I2C(HUB75_PIN_R1) || HUB75_ON_I2C(HUB75_PIN_G1) || HUB75_ON_I2C(HUB75_PIN_B1) ||    \
+     HUB75_ON_I2C(HUB75_PIN_R2) || HUB75_ON_I2C(HUB75_PIN_G2) || HUB75_ON_I2C(HUB75_PIN_B2) ||    \
+     HUB75_ON_I2C(HUB75_PIN_A) || HUB75_ON_I2C(HUB75_PIN_B) || HUB75_ON_I2C(HUB75_PIN_C) ||       \
+     HUB75_ON_I2C(HUB75_PIN_D) || HUB75_ON_I2C(HUB75_PIN_E) || HUB75_ON_I2C(HUB75_PIN_LAT) ||     \
+     HUB75_ON_I2C(HUB75_PIN_OE) || HUB75_ON_I2C(HUB75_PIN_CLK))
+#define HUB75_SENSOR_PIN_CONFLICT 1   // Wire.begin() would take data lines away from the I2S output
+#else
+#define HUB75_SENSOR_PIN_CONFLICT 0
+#endif
+
 // ===== BOOT BUTTON =====
 // Boot button for WiFi reset (active LOW)
 #define BOOT_BTN_PIN   0    // Boot button (built-in on CYD)
@@ -63,10 +169,74 @@
 // ===== OTA =====
 #define OTA_HOSTNAME "CYD-RetroClock"
 #define OTA_PASSWORD "change-me"   // Change this before flashing for real use.
+#define OTA_WEB_USER "ota"             // HTTP Basic user for /api/ota (password: OTA_PASSWORD)
+#define OTA_PROGRESS_STEP 5            // status bar progress moves in 5 % bands
+#define OTA_PROGRESS_KB_STEP 64        // ... or every 64 KB when the upload size is unknown
+#define OTA_RESUME_TIMEOUT_MS 600000   // a broken-off web upload can be resumed for 10 minutes
 
 // ===== WEB =====
 #define HTTP_PORT 80
+#define WS_PORT 81                       // WebSocket mirror stream
+#define CONFIG_SAVE_DEBOUNCE_MS 2000     // quiet time before changed settings are written to NVS
+#define TZ_CACHE_DIR "/cache/tz"         // LittleFS dir for the pre-serialized /api/timezones JSON
+#define TZ_STREAM_CHUNK 256              // chunk size when streaming it without the cache
+#define STATIC_ASSET_MAX 8               // entries read from /web.manifest (scripts/build_web.py)
+#define STATE_JSON_ARENA 4096            // static ArduinoJson arena per state serializer (HTTP task, loopTask)
+#define STATE_JSON_MAX 2048              // serialized /api/state buffer
+#define STATIC_CHUNK 1460                // bytes per write when streaming web UI files (one TCP segment)
+
+// HTTP task (WebServer off loopTask, on the WiFi core)
+#define HTTP_TASK_CORE 0
+#define HTTP_TASK_PRIO 1
+#define HTTP_TASK_STACK 8192             // JSON documents + String bodies in handlers
+#define HTTP_TASK_POLL_MS 2              // idle poll interval for new requests
+
+// Mirror stream (WebSocket push; served from its own task on the WiFi core)
+#define MIRROR_DEFAULT_FPS 15
+#define MIRROR_MAX_FPS 30
+#define MIRROR_STATE_HEARTBEAT_MS 5000   // resend state at least this often even if unchanged
+#define MIRROR_HISTORY 4                 // recent frames kept for ?ack= deltas (2 KB each at 64x32)
+#define MIRROR_TASK_CORE 0
+#define MIRROR_TASK_PRIO 1
+#define MIRROR_TASK_STACK 4096
+
+// Telemetry push (off by default): one compact JSON message per interval over UDP or MQTT (QoS 0),
+// built and sent from its own task on the WiFi core, so a slow broker never stalls the clock
+#define DEFAULT_TELEMETRY_INTERVAL_S 60
+#define TELEMETRY_MIN_INTERVAL_S 5
+#define TELEMETRY_MAX_INTERVAL_S 3600
+#define TELEMETRY_UDP_PORT 8094          // used when the configured port is 0 (Telegraf socket_listener)
+#define TELEMETRY_MQTT_PORT 1883
+#define DEFAULT_TELEMETRY_TOPIC "retroclock"   // MQTT messages go to <topic>/<device id>
+#define TELEMETRY_BATCH_MAX 32           // filtered sensor samples kept between sends (newest win)
+#define TELEMETRY_ARENA 3072             // static ArduinoJson arena for one message
+#define TELEMETRY_MSG_MAX 1200           // preallocated payload buffer (one UDP datagram)
+#define TELEMETRY_CONNECT_TIMEOUT_MS 3000
+#define TELEMETRY_BACKOFF_MIN_MS 2000    // retry delay after a failed send, doubled up to the max
+#define TELEMETRY_BACKOFF_MAX_MS 300000
+#define TELEMETRY_TASK_CORE 0
+#define TELEMETRY_TASK_PRIO 1
+#define TELEMETRY_TASK_STACK 4096
 
 // ===== RENDER =====
-#define FRAME_MS 33   // ~12 FPS
-#define MORPH_STEPS 20  // number of frames for morphing transitions
+#define FRAME_MS 33         // ~30 FPS while a digit transition runs
+#define IDLE_FRAME_MS 1000  // otherwise one frame per second, or sooner on wakeRenderer()
+#define MORPH_MS 660    // digit transition length (elapsed time, independent of frame rate)
+
+// Render task (owns the TFT; loop() keeps network, clock and sensors)
+#define RENDER_TASK_CORE 1
+#define RENDER_TASK_PRIO 2        // above loopTask (1) so HTTP work cannot stall frames
+#define RENDER_TASK_STACK 6144
+#define DMA_STRIP_LINES 10        // lines per ping-pong DMA strip (2 x 320 x 10 x 2 B = 12.8 KB)
+
+// Boot: setup() gets the clock on screen, then a one-shot task brings up WiFi, OTA and the web server
+#define BOOT_TASK_CORE 0
+#define BOOT_TASK_PRIO 1
+#define BOOT_TASK_STACK 8192      // WiFiManager portal runs here (same as loopTask's stack)
+#define BOOT_PHASES_MAX 16        // boot milestones kept for /api/perf
+#define TIME_CACHE_SAVE_MS 3600000  // synced wall clock written to NVS this often (cold-boot seed)
+
+// Profiler (/api/perf)
+#define PERF_RING_SIZE 128        // samples per stage for min/avg/p99/max
+#define PERF_LOG_INTERVAL_MS 10000  // serial summary period at debug level 4 (Verbose)
+#define PERF_FPS_WINDOW_MS 2000    // achieved-FPS averaging window (/api/perf "fps")
@@ -0,0 +1,80 @@
+/*
+ * easing.h - Fixed-point easing curves for digit transitions
+ *
+ * Curves are sampled at build time into 65-entry Q8.8 tables (256 = 1.0) in flash and
+ * evaluated with linear interpolation, so the renderer never touches floats per frame.
+ * Progress goes in as Q16 (0..65536 = start..end of the transition).
+ * EASE_OUT_BACK overshoots past 256 before settling; callers clamp where that matters.
+ */
+
+#ifndef EASING_H
+#define EASING_H
+
+#include <stdint.h>
+
+enum EaseCurve : uint8_t {
+  EASE_LINEAR = 0,
+  EASE_OUT_QUAD,      // fast start, gentle landing
+  EASE_IN_OUT_CUBIC,  // slow start and end
+  EASE_OUT_BACK,      // overshoots slightly and snaps back
+  EASE_CURVE_COUNT
+};
+
+constexpr int EASE_LUT_BITS = 6;
+constexpr int EASE_LUT_SIZE = (1 << EASE_LUT_BITS) + 1;
+constexpr uint32_t EASE_ONE_Q16 = 65536;
+
+constexpr float easeCurve(uint8_t curve, float t) {
+  switch (curve) {
+    case EASE_OUT_QUAD:
+      return 1.0f - (1.0f - t) * (1.0f - t);
+    case EASE_IN_OUT_CUBIC: {
+      if (t < 0.5f) return 4.0f * t * t * t;
+      const float u = 2.0f - 2.0f * t;
+      return 1.0f - u * u * u * 0.5f;
+    }
+    case EASE_OUT_BACK: {
+      const float c1 = 1.70158f;
+      const float u = t - 1.0f;
+      return 1.0f + (c1 + 1.0f) * u * u * u + c1 * u * u;
+    }
+    default:
+      return t;
+  }
+}
+
+struct EaseLut {
+  int16_t v[EASE_CURVE_COUNT][EASE_LUT_SIZE];
+};
+
+constexpr EaseLut makeEaseLut() {
+  EaseLut lut{};
+  for (int c = 0; c < EASE_CURVE_COUNT; c++) {
+    for (int i = 0; i < EASE_LUT_SIZE; i++) {
+      const float y = easeCurve((uint8_t)c, (float)i / (float)(EASE_LUT_SIZE - 1)) * 256.0f;
+      lut.v[c][i] = (int16_t)(y < 0 ? y - 0.5f : y + 0.5f);
+    }
+  }
+  return lut;
+}
+
+inline constexpr EaseLut EASE_LUT = makeEaseLut();
+
+/**
+ * Evaluate an easing curve
+ * @param curve EaseCurve
+ * @param q16 Linear progress, 0..EASE_ONE_Q16 (clamped)
+ * @return Eased progress in Q8.8 (256 = 1.0)
+ */
+static inline int easeQ8(uint8_t curve, uint32_t q16) {
+  if (curve >= EASE_CURVE_COUNT) curve = EASE_LINEAR;
+  if (q16 >= EASE_ONE_Q16) return EASE_LUT.v[curve][EASE_LUT_SIZE - 1];
+  const uint32_t shift = 16 - EASE_LUT_BITS;
+  const uint32_t i = q16 >> shift;
+  const int frac = (int)(q16 & ((1u << shift) - 1));
+  const int a = EASE_LUT.v[curve][i];
+  const int b = EASE_LUT.v[curve][i + 1];
+  return a + (((b - a) * frac) >> shift);
+}
+
+#endif // EASING_H
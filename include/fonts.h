@@ -0,0 +1,319 @@
+/*
+ * fonts.h - Compile-time clock glyph tables
+ *
+ * Every glyph is generated by constexpr code at build time and lands in flash (.rodata):
+ * no boot-time bitmap building and no RAM per font. Sizes follow the panel (LED_MATRIX_W /
+ * LED_MATRIX_H), so larger matrices get larger glyphs without code changes.
+ *
+ * Glyph rows are 32-bit masks, MSB = leftmost column (so glyphs may be up to 32 px wide).
+ * Matrices at least 48 rows tall (e.g. 128x64) keep the bottom quarter for a date row, drawn
+ * with the 5x7 character table below; smaller ones use the full height for the clock.
+ * The renderer only sees GlyphRef / FontDesc views and never the template types.
+ *
+ * Adding a font: generate a DigitSet (and optionally a seconds set / colon) below, then add
+ * a FontStyle entry and a matching FONTS[] row. Names are shown in the web UI.
+ */
+
+#ifndef FONTS_H
+#define FONTS_H
+
+#include <stdint.h>
+#include "config.h"
+
+// Horizontal layout: HH:MM:SS = 6 digits + 2 colons + 5 one-pixel gaps across the panel
+constexpr int FONT_COLON_W = 2;
+constexpr int FONT_GAP = 1;
+constexpr int FONT_GLYPH_MAX_W = 32;
+constexpr int FONT_DIGIT_W_FIT = (LED_MATRIX_W - 2 * FONT_COLON_W - 5 * FONT_GAP) / 6;
+constexpr int FONT_DIGIT_W = FONT_DIGIT_W_FIT < FONT_GLYPH_MAX_W ? FONT_DIGIT_W_FIT : FONT_GLYPH_MAX_W;  // 9 on 64x32
+constexpr int FONT_DATE_MIN_ROWS = 8;                             // 5x7 text + one blank row
+constexpr int FONT_DATE_ROWS = LED_MATRIX_H >= 48 ? LED_MATRIX_H / 4 : 0;
+constexpr int FONT_DIGIT_H = LED_MATRIX_H - FONT_DATE_ROWS;        // 32 on 64x32, 48 on 128x64
+constexpr int FONT_SMALL_W = FONT_DIGIT_W * 2 / 3;   // seconds digits of the "small seconds" style
+constexpr int FONT_SMALL_H = FONT_DIGIT_H / 2;
+
+static_assert(FONT_DIGIT_W >= 5 && FONT_DIGIT_H >= 8, "matrix too small for the clock fonts");
+
+enum FontStyle : uint8_t {
+  FONT_STYLE_7SEG = 0,       // classic 7-segment (default)
+  FONT_STYLE_BOLD,           // 5x7 pixel font scaled up, strokes widened by one column
+  FONT_STYLE_THIN,           // 7-segment with half-width strokes
+  FONT_STYLE_DOTMATRIX,      // retro 5x7 dot matrix with visible dot spacing
+  FONT_STYLE_SMALL_SECONDS,  // 7-segment HH:MM, half-height seconds
+  FONT_STYLE_COUNT
+};
+
+// Ten digits, H rows each, stored back to back
+template <int W, int H>
+struct DigitSet {
+  static_assert(W > 0 && W <= FONT_GLYPH_MAX_W, "glyph rows are 32-bit");
+  uint32_t rows[10 * H];
+};
+
+template <int W, int H>
+struct SingleGlyph {
+  static_assert(W > 0 && W <= FONT_GLYPH_MAX_W, "glyph rows are 32-bit");
+  uint32_t rows[H];
+};
+
+// Non-owning view of one glyph in flash
+struct GlyphRef {
+  const uint32_t* rows;
+  uint8_t w;
+  uint8_t h;
+
+  bool px(int x, int y) const { return (rows[y] >> (31 - x)) & 0x1; }
+};
+
+// One selectable clock font: big digits, seconds digits and colon
+struct FontDesc {
+  const char* name;
+  const uint32_t* digitRows;   // 10 glyphs, h rows each
+  const uint32_t* secRows;     // 10 glyphs, secH rows each (== digitRows for most fonts)
+  const uint32_t* colonRows;
+  uint8_t w, h;
+  uint8_t secW, secH;
+  uint8_t colonW;
+
+  GlyphRef digit(int d) const { return GlyphRef{digitRows + d * h, w, h}; }
+  GlyphRef secDigit(int d) const { return GlyphRef{secRows + d * secH, secW, secH}; }
+  GlyphRef colon() const { return GlyphRef{colonRows, colonW, h}; }
+};
+
+// =========================
+// Generators (constexpr, evaluated by the compiler)
+// =========================
+
+// Segment masks, bit 0..6 = a..g:
+//     aaa
+//    f   b
+//     ggg
+//    e   c
+//     ddd
+constexpr uint8_t SEG7_MASKS[10] = {0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F};
+
+// Classic 5x7 digit shapes, bit 4 = leftmost column
+constexpr uint8_t FONT5X7_DIGITS[10][7] = {
+  {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E},  // 0
+  {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E},  // 1
+  {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F},  // 2
+  {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E},  // 3
+  {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02},  // 4
+  {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E},  // 5
+  {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E},  // 6
+  {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08},  // 7
+  {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E},  // 8
+  {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C},  // 9
+};
+
+// Upper-case letters for the date row (month names), same layout as FONT5X7_DIGITS
+constexpr uint8_t FONT5X7_LETTERS[26][7] = {
+  {0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11},  // A
+  {0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E},  // B
+  {0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E},  // C
+  {0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C},  // D
+  {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F},  // E
+  {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10},  // F
+  {0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F},  // G
+  {0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11},  // H
+  {0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E},  // I
+  {0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C},  // J
+  {0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11},  // K
+  {0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F},  // L
+  {0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11},  // M
+  {0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11},  // N
+  {0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E},  // O
+  {0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10},  // P
+  {0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D},  // Q
+  {0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11},  // R
+  {0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E},  // S
+  {0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04},  // T
+  {0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E},  // U
+  {0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04},  // V
+  {0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A},  // W
+  {0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11},  // X
+  {0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04},  // Y
+  {0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F},  // Z
+};
+
+// Date separators: - / . , :
+constexpr uint8_t FONT5X7_PUNCT[5][7] = {
+  {0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00},
+  {0x01, 0x01, 0x02, 0x04, 0x08, 0x10, 0x10},
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C},
+  {0x00, 0x00, 0x00, 0x00, 0x0C, 0x04, 0x08},
+  {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00},
+};
+
+// 5x7 rows for c (case-insensitive), or nullptr for characters without a glyph (drawn as blanks)
+constexpr const uint8_t* font5x7Char(char c) {
+  if (c >= '0' && c <= '9') return FONT5X7_DIGITS[c - '0'];
+  if (c >= 'a' && c <= 'z') c = (char)(c - 'a' + 'A');
+  if (c >= 'A' && c <= 'Z') return FONT5X7_LETTERS[c - 'A'];
+  switch (c) {
+    case '-': return FONT5X7_PUNCT[0];
+    case '/': return FONT5X7_PUNCT[1];
+    case '.': return FONT5X7_PUNCT[2];
+    case ',': return FONT5X7_PUNCT[3];
+    case ':': return FONT5X7_PUNCT[4];
+    default:  return nullptr;
+  }
+}
+
+// Set pixels in [x0,x1) x [y0,y1) of a w x h glyph, clipped to the glyph
+constexpr void glyphFill(uint32_t* rows, int w, int h, int x0, int y0, int x1, int y1) {
+  for (int y = (y0 < 0 ? 0 : y0); y < y1 && y < h; y++) {
+    for (int x = (x0 < 0 ? 0 : x0); x < x1 && x < w; x++) rows[y] |= (1u << (31 - x));
+  }
+}
+
+/**
+ * 7-segment glyph
+ * @param mask Segments to light (SEG7_MASKS)
+ * @param th Stroke thickness
+ * @param padY Blank rows above and below
+ */
+constexpr void draw7Seg(uint32_t* rows, int w, int h, uint8_t mask, int th, int padY) {
+  const int midY = h / 2;
+  if (mask & 0x01) glyphFill(rows, w, h, 0, padY, w, padY + th);                    // a
+  if (mask & 0x08) glyphFill(rows, w, h, 0, h - padY - th, w, h - padY);            // d
+  if (mask & 0x40) glyphFill(rows, w, h, 0, midY - th / 2, w, midY - th / 2 + th);  // g
+  if (mask & 0x20) glyphFill(rows, w, h, 0, padY, th, midY);                        // f
+  if (mask & 0x02) glyphFill(rows, w, h, w - th, padY, w, midY);                    // b
+  if (mask & 0x10) glyphFill(rows, w, h, 0, midY, th, h - padY);                    // e
+  if (mask & 0x04) glyphFill(rows, w, h, w - th, midY, w, h - padY);                // c
+}
+
+/**
+ * 5x7 source glyph stretched over the whole cell (nearest neighbour)
+ * @param bold Extra columns added to the right of every lit source pixel
+ */
+constexpr void drawScaled5x7(uint32_t* rows, int w, int h, const uint8_t* src, int bold) {
+  for (int r = 0; r < 7; r++) {
+    for (int c = 0; c < 5; c++) {
+      if (!((src[r] >> (4 - c)) & 0x1)) continue;
+      glyphFill(rows, w, h, c * w / 5, r * h / 7, (c + 1) * w / 5 + bold, (r + 1) * h / 7);
+    }
+  }
+}
+
+// 5x7 source glyph as separated dots on a regular pitch, centred in the cell
+constexpr void drawDotMatrix5x7(uint32_t* rows, int w, int h, const uint8_t* src) {
+  const int pitchX = (w + 1) / 5;
+  const int pitchY = (h + 1) / 7;
+  const int dotW = pitchX > 1 ? pitchX - 1 : 1;
+  const int dotH = pitchY > 1 ? pitchY - 1 : 1;
+  const int ox = (w - (4 * pitchX + dotW)) / 2;
+  const int oy = (h - (6 * pitchY + dotH)) / 2;
+  for (int r = 0; r < 7; r++) {
+    for (int c = 0; c < 5; c++) {
+      if (!((src[r] >> (4 - c)) & 0x1)) continue;
+      const int x = ox + c * pitchX;
+      const int y = oy + r * pitchY;
+      glyphFill(rows, w, h, x, y, x + dotW, y + dotH);
+    }
+  }
+}
+
+template <int W, int H>
+constexpr DigitSet<W, H> make7SegSet(int th, int padY) {
+  DigitSet<W, H> s{};
+  for (int d = 0; d < 10; d++) draw7Seg(s.rows + d * H, W, H, SEG7_MASKS[d], th, padY);
+  return s;
+}
+
+template <int W, int H>
+constexpr DigitSet<W, H> makeScaledSet(int bold) {
+  DigitSet<W, H> s{};
+  for (int d = 0; d < 10; d++) drawScaled5x7(s.rows + d * H, W, H, FONT5X7_DIGITS[d], bold);
+  return s;
+}
+
+template <int W, int H>
+constexpr DigitSet<W, H> makeDotMatrixSet() {
+  DigitSet<W, H> s{};
+  for (int d = 0; d < 10; d++) drawDotMatrix5x7(s.rows + d * H, W, H, FONT5X7_DIGITS[d]);
+  return s;
+}
+
+// Two dots at the same heights as the 7-segment a/g and g/d gaps (rows 10-12 and 19-21 at 32 px)
+template <int W, int H>
+constexpr SingleGlyph<W, H> makeColon() {
+  SingleGlyph<W, H> g{};
+  glyphFill(g.rows, W, H, 0, 10 * H / 32, W, 13 * H / 32);
+  glyphFill(g.rows, W, H, 0, 19 * H / 32, W, 22 * H / 32);
+  return g;
+}
+
+// =========================
+// Glyph tables (flash)
+// =========================
+constexpr int FONT_SEG_TH = FONT_DIGIT_H / 8 > 2 ? FONT_DIGIT_H / 8 : 2;          // 4 at 32 px
+constexpr int FONT_SEG_TH_THIN = FONT_SEG_TH / 2 > 1 ? FONT_SEG_TH / 2 : 1;
+constexpr int FONT_SEG_PAD = FONT_DIGIT_H / 32 > 1 ? FONT_DIGIT_H / 32 : 1;
+
+inline constexpr auto FONT_7SEG = make7SegSet<FONT_DIGIT_W, FONT_DIGIT_H>(FONT_SEG_TH, FONT_SEG_PAD);
+inline constexpr auto FONT_7SEG_THIN = make7SegSet<FONT_DIGIT_W, FONT_DIGIT_H>(FONT_SEG_TH_THIN, FONT_SEG_PAD);
+inline constexpr auto FONT_7SEG_SMALL = make7SegSet<FONT_SMALL_W, FONT_SMALL_H>(FONT_SEG_TH_THIN, FONT_SEG_PAD);
+inline constexpr auto FONT_BOLD = makeScaledSet<FONT_DIGIT_W, FONT_DIGIT_H>(1);
+inline constexpr auto FONT_DOTS = makeDotMatrixSet<FONT_DIGIT_W, FONT_DIGIT_H>();
+inline constexpr auto FONT_COLON = makeColon<FONT_COLON_W, FONT_DIGIT_H>();
+
+// Indexed by FontStyle
+inline constexpr FontDesc FONTS[FONT_STYLE_COUNT] = {
+  {"7-segment", FONT_7SEG.rows, FONT_7SEG.rows, FONT_COLON.rows,
+   FONT_DIGIT_W, FONT_DIGIT_H, FONT_DIGIT_W, FONT_DIGIT_H, FONT_COLON_W},
+  {"Bold pixel", FONT_BOLD.rows, FONT_BOLD.rows, FONT_COLON.rows,
+   FONT_DIGIT_W, FONT_DIGIT_H, FONT_DIGIT_W, FONT_DIGIT_H, FONT_COLON_W},
+  {"Thin", FONT_7SEG_THIN.rows, FONT_7SEG_THIN.rows, FONT_COLON.rows,
+   FONT_DIGIT_W, FONT_DIGIT_H, FONT_DIGIT_W, FONT_DIGIT_H, FONT_COLON_W},
+  {"Dot matrix", FONT_DOTS.rows, FONT_DOTS.rows, FONT_COLON.rows,
+   FONT_DIGIT_W, FONT_DIGIT_H, FONT_DIGIT_W, FONT_DIGIT_H, FONT_COLON_W},
+  {"Small seconds", FONT_7SEG.rows, FONT_7SEG_SMALL.rows, FONT_COLON.rows,
+   FONT_DIGIT_W, FONT_DIGIT_H, FONT_SMALL_W, FONT_SMALL_H, FONT_COLON_W},
+};
+
+// Largest glyph pixel count (sizes the renderer's per-glyph scratch buffers)
+constexpr int FONT_MAX_GLYPH_PIXELS = FONT_DIGIT_W * FONT_DIGIT_H;
+
+// Lit pixels over the ten digits of a glyph set
+constexpr int glyphSetPixels(const uint32_t* rows, int h) {
+  int n = 0;
+  for (int i = 0; i < 10 * h; i++) {
+    for (uint32_t r = rows[i]; r; r &= r - 1) n++;
+  }
+  return n;
+}
+
+// Most lit pixels in any single digit of any font (bounds the particle morph indices)
+constexpr int fontMaxLitPixels() {
+  int best = 0;
+  for (const FontDesc& f : FONTS) {
+    for (int d = 0; d < 10; d++) {
+      int n = 0, ns = 0;
+      for (int i = 0; i < f.h; i++) for (uint32_t r = f.digitRows[d * f.h + i]; r; r &= r - 1) n++;
+      for (int i = 0; i < f.secH; i++) for (uint32_t r = f.secRows[d * f.secH + i]; r; r &= r - 1) ns++;
+      if (n > best) best = n;
+      if (ns > best) best = ns;
+    }
+  }
+  return best;
+}
+
+// Largest glyph set over all fonts; secs=true only counts fonts with separate seconds glyphs
+constexpr int fontMaxSetPixels(bool secs) {
+  int best = 0;
+  for (const FontDesc& f : FONTS) {
+    if (secs && f.secRows == f.digitRows) continue;
+    const int n = secs ? glyphSetPixels(f.secRows, f.secH) : glyphSetPixels(f.digitRows, f.h);
+    if (n > best) best = n;
+  }
+  return best;
+}
+
+// Sizes the particle morph tables (see "Particle Morph Tables" in main.cpp)
+constexpr int FONT_MAX_SET_PIXELS = fontMaxSetPixels(false);      // 1924 on 64x32
+constexpr int FONT_MAX_SEC_SET_PIXELS = fontMaxSetPixels(true);   // 520 on 64x32
+constexpr int FONT_MAX_LIT_PIXELS = fontMaxLitPixels();           // 252 on 64x32
+
+#endif // FONTS_H
@@ -0,0 +1,211 @@
+/*
+ * framebuffer.h - Logical LED framebuffer rows, 1, 4 or 8 bits per LED (FB_BPP, build time)
+ *
+ *   8  one byte per LED, as plain uint8_t[LED_MATRIX_W] (the rest of the firmware can read it directly)
+ *   4  16 levels, eight LEDs per 32-bit word, first LED in the top nibble
+ *   1  on/off, 32 LEDs per word, first LED in bit 31 (the same order as glyph rows in fonts.h)
+ *
+ * Intensities stay 0..255 at the interface: writes quantize, reads expand back (4 bpp: level * 17,
+ * 1 bpp: 0 or 255, lit from FB_1BPP_THRESHOLD). fbPutBits() writes a whole glyph row with a few
+ * masked word stores, so composing digits costs per row instead of per pixel.
+ * The packed formats assume a little-endian CPU only for the 8 bpp word stores (ESP32, x86).
+ */
+
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include <stdint.h>
+#include <string.h>
+#include "config.h"
+
+static_assert(FB_BPP == 1 || FB_BPP == 4 || FB_BPP == 8, "FB_BPP must be 1, 4 or 8");
+
+constexpr uint8_t FB_1BPP_THRESHOLD = 128;
+
+#if FB_BPP == 8
+typedef uint8_t FbRow[LED_MATRIX_W];
+#else
+constexpr int FB_LEDS_PER_WORD = 32 / FB_BPP;
+constexpr int FB_ROW_WORDS = (LED_MATRIX_W + FB_LEDS_PER_WORD - 1) / FB_LEDS_PER_WORD;
+typedef uint32_t FbRow[FB_ROW_WORDS];
+#endif
+
+// Stored value for intensity v, replicated into every LED slot of a 32-bit word
+static inline uint32_t fbPattern(uint8_t v) {
+#if FB_BPP == 8
+  return v * 0x01010101u;
+#elif FB_BPP == 4
+  return ((v + 8) / 17) * 0x11111111u;
+#else
+  return v >= FB_1BPP_THRESHOLD ? 0xFFFFFFFFu : 0;
+#endif
+}
+
+// Intensity 0..255 of LED x
+static inline uint8_t fbGetPx(const FbRow& row, int x) {
+#if FB_BPP == 8
+  return row[x];
+#elif FB_BPP == 4
+  return (uint8_t)(((row[x >> 3] >> (28 - 4 * (x & 7))) & 0xF) * 17);
+#else
+  return (row[x >> 5] >> (31 - (x & 31))) & 1 ? 255 : 0;
+#endif
+}
+
+static inline void fbPutPx(FbRow& row, int x, uint8_t v) {
+#if FB_BPP == 8
+  row[x] = v;
+#elif FB_BPP == 4
+  const int sh = 28 - 4 * (x & 7);
+  row[x >> 3] = (row[x >> 3] & ~(0xFu << sh)) | (fbPattern(v) & (0xFu << sh));
+#else
+  const uint32_t bit = 0x80000000u >> (x & 31);
+  if (v >= FB_1BPP_THRESHOLD) row[x >> 5] |= bit;
+  else row[x >> 5] &= ~bit;
+#endif
+}
+
+static inline void fbFillRow(FbRow& row, uint8_t v) {
+#if FB_BPP == 8
+  memset(row, v, sizeof(FbRow));
+#else
+  const uint32_t p = fbPattern(v);
+  for (int i = 0; i < FB_ROW_WORDS; i++) row[i] = p;
+#endif
+}
+
+#if FB_BPP == 4
+// 8 glyph bits (MSB = first LED) -> 8 nibble masks (first LED in the top nibble)
+struct FbSpread4 {
+  uint32_t v[256];
+  constexpr FbSpread4() : v() {
+    for (int b = 0; b < 256; b++) {
+      for (int i = 0; i < 8; i++) {
+        if (b & (0x80 >> i)) v[b] |= 0xF0000000u >> (4 * i);
+      }
+    }
+  }
+};
+inline constexpr FbSpread4 FB_SPREAD4{};
+#endif
+
+/**
+ * Write intensity v to every LED whose bit is set in bits (bit 31 = LED x0, then rightwards),
+ * clipped to the row; LEDs with clear bits keep their value
+ */
+static inline void fbPutBits(FbRow& row, uint32_t bits, int x0, uint8_t v) {
+  if (x0 < 0) {
+    if (x0 <= -32) return;
+    bits <<= -x0;
+    x0 = 0;
+  }
+  const int room = LED_MATRIX_W - x0;
+  if (room <= 0) return;
+  if (room < 32) bits &= ~(0xFFFFFFFFu >> room);
+  if (!bits) return;
+  const uint32_t pat = fbPattern(v);
+
+#if FB_BPP == 8
+  // Four LEDs per step: nibble of glyph bits -> byte mask (first LED = lowest address)
+  for (int k = 0; bits; k += 4, bits <<= 4) {
+    const uint32_t nib = bits >> 28;
+    if (!nib) continue;
+    uint8_t* p = row + x0 + k;
+    if (x0 + k + 4 <= LED_MATRIX_W) {
+      const uint32_t m = ((nib & 8) ? 0x000000FFu : 0) | ((nib & 4) ? 0x0000FF00u : 0) |
+                         ((nib & 2) ? 0x00FF0000u : 0) | ((nib & 1) ? 0xFF000000u : 0);
+      uint32_t w;
+      memcpy(&w, p, 4);
+      w = (w & ~m) | (pat & m);
+      memcpy(p, &w, 4);
+    } else {
+      for (int i = 0; i < 4; i++) {
+        if (nib & (8 >> i)) p[i] = v;
+      }
+    }
+  }
+#elif FB_BPP == 4
+  // A byte of glyph bits covers one word's worth of LEDs, split over two words when unaligned
+  for (int k = 0; bits; k += 8, bits <<= 8) {
+    const uint32_t m = FB_SPREAD4.v[bits >> 24];
+    if (!m) continue;
+    const int x = x0 + k;
+    const int wi = x >> 3;
+    const int sh = 4 * (x & 7);
+    const uint32_t m0 = m >> sh;
+    row[wi] = (row[wi] & ~m0) | (pat & m0);
+    if (sh && wi + 1 < FB_ROW_WORDS) {
+      const uint32_t m1 = m << (32 - sh);
+      row[wi + 1] = (row[wi + 1] & ~m1) | (pat & m1);
+    }
+  }
+#else
+  const int wi = x0 >> 5;
+  const int sh = x0 & 31;
+  const uint32_t m0 = bits >> sh;
+  row[wi] = (row[wi] & ~m0) | (pat & m0);
+  if (sh && wi + 1 < FB_ROW_WORDS) {
+    const uint32_t m1 = bits << (32 - sh);
+    row[wi + 1] = (row[wi + 1] & ~m1) | (pat & m1);
+  }
+#endif
+}
+
+// True if LEDs [x0, x1) may differ (packed formats compare whole words, so neighbours can report too)
+static inline bool fbSpanDiffers(const FbRow& a, const FbRow& b, int x0, int x1) {
+#if FB_BPP == 8
+  return memcmp(a + x0, b + x0, x1 - x0) != 0;
+#else
+  for (int i = x0 / FB_LEDS_PER_WORD; i <= (x1 - 1) / FB_LEDS_PER_WORD; i++) {
+    if (a[i] != b[i]) return true;
+  }
+  return false;
+#endif
+}
+
+#if FB_BPP != 8
+// Bits of word i that hold LEDs [x0, x1)
+static inline uint32_t fbWordMask(int i, int x0, int x1) {
+  const int lo = i * FB_LEDS_PER_WORD;
+  const int a = x0 > lo ? x0 - lo : 0;                                      // first LED in the word
+  const int b = x1 < lo + FB_LEDS_PER_WORD ? x1 - lo : FB_LEDS_PER_WORD;   // one past the last
+  return (0xFFFFFFFFu >> (a * FB_BPP)) & ~(b * FB_BPP >= 32 ? 0 : 0xFFFFFFFFu >> (b * FB_BPP));
+}
+#endif
+
+// Copy LEDs [x0, x1) from src to dst, leaving the others in dst alone
+static inline void fbCopySpan(FbRow& dst, const FbRow& src, int x0, int x1) {
+#if FB_BPP == 8
+  memcpy(dst + x0, src + x0, x1 - x0);
+#else
+  for (int i = x0 / FB_LEDS_PER_WORD; i <= (x1 - 1) / FB_LEDS_PER_WORD; i++) {
+    const uint32_t m = fbWordMask(i, x0, x1);
+    dst[i] = (dst[i] & ~m) | (src[i] & m);
+  }
+#endif
+}
+
+// Turn LEDs [x0, x1) off
+static inline void fbClearSpan(FbRow& row, int x0, int x1) {
+#if FB_BPP == 8
+  memset(row + x0, 0, x1 - x0);
+#else
+  for (int i = x0 / FB_LEDS_PER_WORD; i <= (x1 - 1) / FB_LEDS_PER_WORD; i++) row[i] &= ~fbWordMask(i, x0, x1);
+#endif
+}
+
+/**
+ * Row as one intensity byte per LED: the row itself at 8 bpp, otherwise expanded into scratch
+ * (LED_MATRIX_W bytes)
+ */
+static inline const uint8_t* fbRowBytes(const FbRow& row, uint8_t* scratch) {
+#if FB_BPP == 8
+  (void)scratch;
+  return row;
+#else
+  for (int x = 0; x < LED_MATRIX_W; x++) scratch[x] = fbGetPx(row, x);
+  return scratch;
+#endif
+}
+
+#endif // FRAMEBUFFER_H
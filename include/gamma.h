@@ -0,0 +1,34 @@
+/*
+ * gamma.h - Perceptual brightness table (compile time, flash)
+ *
+ * LEDs emit light linearly in their drive level, but the eye is roughly logarithmic, so a
+ * linear 0..255 ramp looks like it jumps from dark to bright. GAMMA_CIE maps a perceived
+ * lightness (0..255) to the linear drive level using the CIE 1976 L* curve.
+ */
+
+#ifndef GAMMA_H
+#define GAMMA_H
+
+#include <stdint.h>
+
+struct GammaTable {
+  uint8_t v[256];
+  constexpr uint8_t operator[](int i) const { return v[i]; }
+};
+
+// L* (0..100) -> relative luminance Y (0..1), inverse of the CIE 1976 lightness formula
+constexpr double cieLuminance(double L) {
+  if (L <= 8.0) return L / 903.3;
+  const double t = (L + 16.0) / 116.0;
+  return t * t * t;
+}
+
+constexpr GammaTable makeCieTable() {
+  GammaTable t{};
+  for (int i = 0; i < 256; i++) t.v[i] = (uint8_t)(cieLuminance(i * 100.0 / 255.0) * 255.0 + 0.5);
+  return t;
+}
+
+inline constexpr GammaTable GAMMA_CIE = makeCieTable();
+
+#endif // GAMMA_H
@@ -0,0 +1,210 @@
+/*
+ * hub75_dma.h - HUB75 panel refresh from the ESP32 I2S peripheral in parallel (LCD) mode
+ *
+ * The panel is refreshed entirely by DMA: a looped descriptor chain clocks prebuilt line buffers
+ * out of I2S1 as 16-bit parallel words, one word per pixel clock. Refresh costs no CPU and keeps
+ * its rate while WiFi, the web server or NVS are busy; the CPU only rewrites the colour bits of
+ * rows that changed (HUB75 backend in main.cpp).
+ *
+ * Binary code modulation: every row address has HUB75_COLOR_BITS bit planes. Plane b is shown
+ * for 2^(b - HUB75_SHORT_PLANES) line times, by linking its buffer into the chain that many
+ * times (no copies). The lowest HUB75_SHORT_PLANES planes get one line each with OE enabled for
+ * only part of it, so they cost no extra lines.
+ *
+ * Word layout (bit = I2S data line): R1 G1 B1 R2 G2 B2 LAT OE A B C D E
+ * While a line shifts in, the panel shows the data latched at the end of the previous line, so
+ * the address and OE window stored in a line belong to the line before it.
+ * Buffers are rewritten in place; a row caught mid-update shows mixed planes for one refresh.
+ */
+
+#ifndef HUB75_DMA_H
+#define HUB75_DMA_H
+
+#include <stdint.h>
+#include <string.h>
+#include <esp_heap_caps.h>
+#include <rom/lldesc.h>
+#include <rom/gpio.h>
+#include <soc/gpio_sig_map.h>
+#include <soc/i2s_struct.h>
+#include <driver/gpio.h>
+#include <driver/periph_ctrl.h>
+#include "config.h"
+
+constexpr int HUB75_ROWS = LED_MATRIX_H / 2;                 // row addresses (16 on 64x32)
+constexpr int HUB75_PLANES = HUB75_COLOR_BITS;
+constexpr int HUB75_SHORT = HUB75_SHORT_PLANES;
+
+static_assert(HUB75_ROWS <= 32, "HUB75 address lines A-E scan at most 64 rows");
+static_assert(LED_MATRIX_W % 2 == 0 && LED_MATRIX_W * 2 <= 4092, "one DMA descriptor per line");
+static_assert(HUB75_PLANES >= 1 && HUB75_PLANES <= 8 && HUB75_SHORT < HUB75_PLANES, "bad BCM depth");
+
+enum Hub75Bits : uint16_t {
+  HUB75_RGB_MASK  = 0x3F,     // R1 G1 B1 R2 G2 B2 (bits 0-5)
+  HUB75_LAT       = 1 << 6,
+  HUB75_OE        = 1 << 7,   // high = blanked
+  HUB75_ADDR_SHIFT = 8,
+};
+
+class Hub75Dma {
+ public:
+  // Line times plane b stays on screen
+  static constexpr int repeats(int b) { return b < HUB75_SHORT ? 1 : 1 << (b - HUB75_SHORT); }
+
+  static constexpr int linesPerRow() {
+    int n = 0;
+    for (int b = 0; b < HUB75_PLANES; b++) n += repeats(b);
+    return n;
+  }
+
+  bool ready() const { return desc_ != nullptr; }
+
+  // Pixel clock divided by the words clocked out per full refresh
+  uint32_t refreshHz() const {
+    return clockHz_ / ((uint32_t)HUB75_ROWS * linesPerRow() * LED_MATRIX_W);
+  }
+
+  /**
+   * Word of pixel x in the line buffer of (row, plane). The 16-bit FIFO mode sends the two
+   * halves of each 32-bit word high half first, hence x ^ 1.
+   */
+  uint16_t& word(int row, int plane, int x) {
+    return buf_[((size_t)row * HUB75_PLANES + plane) * LED_MATRIX_W + (x ^ 1)];
+  }
+
+  /**
+   * Allocate the line buffers and descriptors (DMA-capable RAM), route the pins and start the
+   * endless refresh. All colour bits start cleared (panel dark).
+   * @return false if memory ran out
+   */
+  bool begin() {
+    buf_ = (uint16_t*)heap_caps_calloc((size_t)HUB75_ROWS * HUB75_PLANES * LED_MATRIX_W, sizeof(uint16_t),
+                                       MALLOC_CAP_DMA);
+    const int descN = HUB75_ROWS * linesPerRow();
+    lldesc_t* desc = (lldesc_t*)heap_caps_calloc(descN, sizeof(lldesc_t), MALLOC_CAP_DMA);
+    if (!buf_ || !desc) {
+      heap_caps_free(buf_);
+      heap_caps_free(desc);
+      buf_ = nullptr;
+      return false;
+    }
+
+    for (int row = 0; row < HUB75_ROWS; row++) {
+      for (int plane = 0; plane < HUB75_PLANES; plane++) buildControl(row, plane);
+    }
+
+    // Row by row, plane by plane, each plane linked repeats(b) times; the last links back to the first
+    const size_t lineBytes = LED_MATRIX_W * sizeof(uint16_t);
+    int n = 0;
+    for (int row = 0; row < HUB75_ROWS; row++) {
+      for (int plane = 0; plane < HUB75_PLANES; plane++) {
+        for (int r = 0; r < repeats(plane); r++, n++) {
+          lldesc_t& d = desc[n];
+          d.size = lineBytes;
+          d.length = lineBytes;
+          d.owner = 1;
+          d.buf = (uint8_t*)(buf_ + ((size_t)row * HUB75_PLANES + plane) * LED_MATRIX_W);
+          d.qe.stqe_next = &desc[(n + 1) % descN];
+        }
+      }
+    }
+
+    routePins();
+    startI2s(desc);
+    desc_ = desc;
+    return true;
+  }
+
+ private:
+  // Address and OE window of a line: both describe the line shown while this one shifts in
+  void buildControl(int row, int plane) {
+    const int shownRow = plane == 0 ? (row + HUB75_ROWS - 1) % HUB75_ROWS : row;
+    const int shownPlane = plane == 0 ? HUB75_PLANES - 1 : plane - 1;
+    // Blank the first word (address settles) and the last (latch); short planes light a fraction
+    const int span = LED_MATRIX_W - 2;
+    const int lit = shownPlane < HUB75_SHORT ? span >> (HUB75_SHORT - shownPlane) : span;
+    for (int x = 0; x < LED_MATRIX_W; x++) {
+      uint16_t w = (uint16_t)(shownRow << HUB75_ADDR_SHIFT);
+      if (x < 1 || x >= 1 + lit) w |= HUB75_OE;
+      if (x == LED_MATRIX_W - 1) w |= HUB75_LAT;
+      word(row, plane, x) = w;
+    }
+  }
+
+  void routePins() {
+    static const int8_t pins[] = {
+      HUB75_PIN_R1, HUB75_PIN_G1, HUB75_PIN_B1, HUB75_PIN_R2, HUB75_PIN_G2, HUB75_PIN_B2,
+      HUB75_PIN_LAT, HUB75_PIN_OE, HUB75_PIN_A, HUB75_PIN_B, HUB75_PIN_C, HUB75_PIN_D, HUB75_PIN_E,
+    };
+    // 16-bit LCD mode drives I2S1 data lines 8..23
+    for (int i = 0; i < (int)sizeof(pins); i++) {
+      if (pins[i] < 0) continue;
+      gpio_pad_select_gpio(pins[i]);
+      gpio_set_direction((gpio_num_t)pins[i], GPIO_MODE_OUTPUT);
+      gpio_matrix_out(pins[i], I2S1O_DATA_OUT8_IDX + i, false, false);
+    }
+    // Inverted WS clock: data changes on the falling edge and is sampled by the panel on the rising one
+    gpio_pad_select_gpio(HUB75_PIN_CLK);
+    gpio_set_direction((gpio_num_t)HUB75_PIN_CLK, GPIO_MODE_OUTPUT);
+    gpio_matrix_out(HUB75_PIN_CLK, I2S1O_WS_OUT_IDX, true, false);
+  }
+
+  void startI2s(lldesc_t* first) {
+    periph_module_enable(PERIPH_I2S1_MODULE);
+    i2s_dev_t* dev = &I2S1;
+
+    dev->conf.tx_reset = 1;
+    dev->conf.tx_reset = 0;
+    dev->conf.tx_fifo_reset = 1;
+    dev->conf.tx_fifo_reset = 0;
+    dev->lc_conf.out_rst = 1;
+    dev->lc_conf.out_rst = 0;
+    dev->lc_conf.ahbm_rst = 1;
+    dev->lc_conf.ahbm_rst = 0;
+
+    dev->conf2.val = 0;
+    dev->conf2.lcd_en = 1;
+
+    // 160 MHz PLL / clkm_div_num / (tx_bck_div_num = 2) / 2 = clock of one 16-bit word
+    int div = 40000000 / HUB75_CLOCK_HZ;
+    if (div < 2) div = 2;
+    if (div > 255) div = 255;
+    clockHz_ = 40000000 / div;
+    dev->clkm_conf.val = 0;
+    dev->clkm_conf.clka_en = 0;
+    dev->clkm_conf.clkm_div_a = 1;
+    dev->clkm_conf.clkm_div_b = 0;
+    dev->clkm_conf.clkm_div_num = div;
+    dev->sample_rate_conf.val = 0;
+    dev->sample_rate_conf.tx_bits_mod = 16;
+    dev->sample_rate_conf.tx_bck_div_num = 2;
+
+    dev->fifo_conf.val = 0;
+    dev->fifo_conf.tx_fifo_mod_force_en = 1;
+    dev->fifo_conf.tx_fifo_mod = 1;      // 16-bit single channel
+    dev->fifo_conf.tx_data_num = 32;
+    dev->fifo_conf.dscr_en = 1;
+    dev->conf1.val = 0;
+    dev->conf1.tx_stop_en = 0;
+    dev->conf1.tx_pcm_bypass = 1;
+    dev->conf_chan.val = 0;
+    dev->conf_chan.tx_chan_mod = 1;
+    dev->conf.tx_right_first = 1;
+    dev->timing.val = 0;
+
+    dev->int_ena.val = 0;                // no interrupts: the chain loops forever
+    dev->int_clr.val = 0xFFFFFFFF;
+    dev->lc_conf.val = 0;
+    dev->lc_conf.out_data_burst_en = 1;
+    dev->lc_conf.outdscr_burst_en = 1;
+    dev->out_link.addr = (uint32_t)(uintptr_t)first;
+    dev->out_link.start = 1;
+    dev->conf.tx_start = 1;
+  }
+
+  uint16_t* buf_ = nullptr;
+  lldesc_t* desc_ = nullptr;
+  uint32_t clockHz_ = 0;
+};
+
+#endif // HUB75_DMA_H
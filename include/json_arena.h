@@ -0,0 +1,74 @@
+/*
+ * json_arena.h - Fixed-arena allocator for ArduinoJson 7 documents
+ *
+ * A JsonDocument built on an ArenaAllocator takes its slot pools and strings from a caller-owned
+ * static buffer instead of the heap, so periodic serializers (state JSON) never fragment it.
+ * Allocation is a bump pointer; only the most recent block can be freed or resized in place.
+ * Call reset() before building each document; the previous document must be gone by then.
+ * When the arena is full allocate() returns nullptr and the document reports overflowed().
+ */
+
+#ifndef JSON_ARENA_H
+#define JSON_ARENA_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <ArduinoJson.h>
+
+class ArenaAllocator : public ArduinoJson::Allocator {
+ public:
+  ArenaAllocator(uint8_t* buf, size_t size) : buf_(buf), size_(size) {}
+
+  void reset() {
+    used_ = 0;
+    last_ = 0;
+  }
+
+  size_t used() const { return used_; }
+  size_t peak() const { return peak_; }
+  size_t capacity() const { return size_; }
+
+  void* allocate(size_t n) override {
+    const size_t need = HDR + align(n);
+    if (used_ + need > size_) return nullptr;
+    uint8_t* block = buf_ + used_;
+    *(uint32_t*)block = (uint32_t)n;
+    last_ = used_;
+    used_ += need;
+    if (used_ > peak_) peak_ = used_;
+    return block + HDR;
+  }
+
+  void deallocate(void* p) override {
+    if (p && isLast(p)) used_ = last_;
+  }
+
+  void* reallocate(void* p, size_t n) override {
+    if (!p) return allocate(n);
+    if (isLast(p)) {
+      if (last_ + HDR + align(n) > size_) return nullptr;
+      *(uint32_t*)(buf_ + last_) = (uint32_t)n;
+      used_ = last_ + HDR + align(n);
+      if (used_ > peak_) peak_ = used_;
+      return p;
+    }
+    const size_t old = *(const uint32_t*)((uint8_t*)p - HDR);
+    void* q = allocate(n);
+    if (q) memcpy(q, p, old < n ? old : n);
+    return q;
+  }
+
+ private:
+  static const size_t HDR = 8;  // block size, padded so payloads stay 8-byte aligned
+  static size_t align(size_t n) { return (n + 7) & ~(size_t)7; }
+  bool isLast(void* p) const { return used_ > last_ && (uint8_t*)p == buf_ + last_ + HDR; }
+
+  uint8_t* buf_;
+  size_t size_;
+  size_t used_ = 0;
+  size_t last_ = 0;   // offset of the most recent block header
+  size_t peak_ = 0;
+};
+
+#endif // JSON_ARENA_H
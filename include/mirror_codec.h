@@ -0,0 +1,172 @@
+/*
+ * mirror_codec.h - Versioned binary encoding for the display mirror
+ *
+ * Used by GET /api/mirror?fmt=v1 and the WebSocket mirror stream; decoded by
+ * decodeMirrorFrame() in web/app.js. Keep both sides in sync.
+ *
+ * Message layout (little-endian):
+ *   [0]   'M' (0x4D) magic
+ *   [1]   version (MIRROR_CODEC_VERSION)
+ *   [2]   encoding (MirrorEncoding)
+ *   [3]   lit value for MIRROR_ENC_BITS, 0 otherwise
+ *   [4-5] seq of the frame this message describes
+ *   [6-7] base seq the payload applies to (XOR / SAME), == seq otherwise
+ *   [8]   width  (LEDs)
+ *   [9]   height (LEDs)
+ *   [10..] payload
+ *
+ * Encodings:
+ *   RAW      width*height intensity bytes
+ *   BITS     1 bit per LED, MSB first; set bits are the lit value, clear bits are 0
+ *            (only when the frame uses a single non-zero intensity, e.g. no morph running)
+ *   RLE      PackBits-style runs over the intensity bytes
+ *   XOR_RLE  RLE over (frame XOR base frame); the client must hold base seq
+ *   SAME     no payload; frame is identical to base seq
+ *
+ * RLE control byte c:
+ *   0x00..0x7F  c+1 literal bytes follow
+ *   0x80..0xFF  next byte repeats (c - 0x80 + 3) times (3..130)
+ */
+
+#ifndef MIRROR_CODEC_H
+#define MIRROR_CODEC_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define MIRROR_CODEC_MAGIC   0x4D
+#define MIRROR_CODEC_VERSION 1
+#define MIRROR_CODEC_HDR     10
+
+enum MirrorEncoding : uint8_t {
+  MIRROR_ENC_RAW = 0,
+  MIRROR_ENC_BITS = 1,
+  MIRROR_ENC_RLE = 2,
+  MIRROR_ENC_XOR_RLE = 3,
+  MIRROR_ENC_SAME = 4,
+};
+
+/**
+ * PackBits-style run-length encode src (optionally XORed with base)
+ * @param src Frame bytes
+ * @param base XOR base frame, or nullptr for plain RLE
+ * @param n Number of bytes
+ * @param out Destination, or nullptr to only measure
+ * @param cap Give up once the output would exceed this many bytes
+ * @return Encoded length, or 0 if it would exceed cap
+ */
+static inline size_t mirrorRleEncode(const uint8_t* src, const uint8_t* base, size_t n, uint8_t* out, size_t cap) {
+  auto at = [&](size_t i) -> uint8_t { return base ? (uint8_t)(src[i] ^ base[i]) : src[i]; };
+  size_t o = 0;
+  size_t i = 0;
+  while (i < n) {
+    size_t run = 1;
+    while (i + run < n && run < 130 && at(i + run) == at(i)) run++;
+    if (run >= 3) {
+      if (o + 2 > cap) return 0;
+      if (out) { out[o] = (uint8_t)(0x80 + (run - 3)); out[o + 1] = at(i); }
+      o += 2;
+      i += run;
+      continue;
+    }
+    // Literal block until the next 3-byte run (or 128 bytes)
+    const size_t start = i;
+    size_t len = 0;
+    while (i < n && len < 128) {
+      if (i + 2 < n && at(i) == at(i + 1) && at(i + 1) == at(i + 2)) break;
+      i++;
+      len++;
+    }
+    if (o + 1 + len > cap) return 0;
+    if (out) {
+      out[o] = (uint8_t)(len - 1);
+      for (size_t k = 0; k < len; k++) out[o + 1 + k] = at(start + k);
+    }
+    o += 1 + len;
+  }
+  return o;
+}
+
+/**
+ * Lit value if every LED is either 0 or one shared intensity (BITS-eligible)
+ * @return The shared intensity, 0 for an all-dark frame, or -1 if not eligible
+ */
+static inline int mirrorSingleLevel(const uint8_t* frame, size_t n) {
+  uint8_t lit = 0;
+  for (size_t i = 0; i < n; i++) {
+    const uint8_t v = frame[i];
+    if (!v) continue;
+    if (!lit) lit = v;
+    else if (v != lit) return -1;
+  }
+  return lit;
+}
+
+/**
+ * Encode one frame, picking the smallest encoding available
+ * @param frame Current frame (w*h bytes)
+ * @param base Frame the receiver holds (base seq), or nullptr for a keyframe
+ * @param seq Sequence number of frame
+ * @param baseSeq Sequence number of base (ignored without base)
+ * @param w Width in LEDs (<= 255)
+ * @param h Height in LEDs (<= 255)
+ * @param out Destination, at least MIRROR_CODEC_HDR + w*h bytes
+ * @return Message length
+ */
+static inline size_t mirrorEncode(const uint8_t* frame, const uint8_t* base, uint16_t seq, uint16_t baseSeq,
+                                  uint8_t w, uint8_t h, uint8_t* out) {
+  const size_t n = (size_t)w * h;
+  uint8_t* payload = out + MIRROR_CODEC_HDR;
+  uint8_t enc = MIRROR_ENC_RAW;
+  uint8_t lit = 0;
+  size_t best = n;
+
+  if (base && memcmp(frame, base, n) == 0) {
+    enc = MIRROR_ENC_SAME;
+    best = 0;
+  } else {
+    const size_t bitsLen = (n + 7) / 8;
+    const int level = mirrorSingleLevel(frame, n);
+    const size_t rleLen = mirrorRleEncode(frame, nullptr, n, nullptr, best - 1);
+    const size_t xorLen = base ? mirrorRleEncode(frame, base, n, nullptr, best - 1) : 0;
+
+    if (level >= 0 && bitsLen < best) { enc = MIRROR_ENC_BITS; best = bitsLen; lit = (uint8_t)level; }
+    if (rleLen && rleLen < best) { enc = MIRROR_ENC_RLE; best = rleLen; }
+    if (xorLen && xorLen < best) { enc = MIRROR_ENC_XOR_RLE; best = xorLen; }
+
+    switch (enc) {
+      case MIRROR_ENC_BITS:
+        memset(payload, 0, bitsLen);
+        for (size_t i = 0; i < n; i++) {
+          if (frame[i]) payload[i >> 3] |= (uint8_t)(0x80 >> (i & 7));
+        }
+        break;
+      case MIRROR_ENC_RLE:
+        mirrorRleEncode(frame, nullptr, n, payload, best);
+        break;
+      case MIRROR_ENC_XOR_RLE:
+        mirrorRleEncode(frame, base, n, payload, best);
+        break;
+      default:
+        memcpy(payload, frame, n);
+        break;
+    }
+  }
+
+  const bool relative = enc == MIRROR_ENC_XOR_RLE || enc == MIRROR_ENC_SAME;
+  if (!relative) baseSeq = seq;
+  out[0] = MIRROR_CODEC_MAGIC;
+  out[1] = MIRROR_CODEC_VERSION;
+  out[2] = enc;
+  out[3] = lit;
+  out[4] = (uint8_t)(seq & 0xFF);
+  out[5] = (uint8_t)(seq >> 8);
+  out[6] = (uint8_t)(baseSeq & 0xFF);
+  out[7] = (uint8_t)(baseSeq >> 8);
+  out[8] = w;
+  out[9] = h;
+  return MIRROR_CODEC_HDR + best;
+}
+
+#endif // MIRROR_CODEC_H
@@ -0,0 +1,119 @@
+/*
+ * morph.h - Particle morph tables (point lists and digit-pair matching)
+ *
+ * Greedy nearest-neighbour matching for every from->to digit pair of a glyph set is computed once
+ * instead of on every morph frame; a morph frame is then only a fixed-point lerp per particle
+ * (drawParticleMorph() in main.cpp). No Arduino dependencies, so bench/native can time it on a host.
+ * The caller owns the point / order pools (see initMorphTables() in main.cpp).
+ */
+
+#ifndef MORPH_H
+#define MORPH_H
+
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+#include "fonts.h"
+
+struct Pt { int8_t x, y; };
+
+// Indices count lit pixels of one digit, not its bounding box, so 64x32 fonts fit in a byte
+typedef std::conditional<(FONT_MAX_LIT_PIXELS <= 256), uint8_t, uint16_t>::type MorphIdx;
+
+struct MorphSet {
+  const uint32_t* rows;   // glyph set the points were built from (nullptr = unbound)
+  uint8_t h;
+  Pt* pts;                // lit pixels of all ten digits, back to back (row-major per digit)
+  MorphIdx* order;        // per pair: to-point index for each matched from-point, then unmatched to-points
+  int capPts;             // pool capacity in points
+  uint16_t ptOff[10];
+  uint16_t ptN[10];
+  uint16_t total;         // sum of ptN
+  uint16_t ready[10];     // bit b of ready[a]: pair a->b matched
+  uint32_t pairsBuilt;    // pairs matched since boot (all sets rebind after a font change)
+};
+
+// Lit pixels of a glyph in row-major order; returns the count (may exceed maxOut)
+static inline int buildPixelsFromGlyph(GlyphRef g, Pt* out, int maxOut) {
+  int n = 0;
+  for (int y = 0; y < g.h; y++) {
+    for (int x = 0; x < g.w; x++) {
+      if (!g.px(x, y)) continue;
+      if (n < maxOut) out[n] = Pt{(int8_t)x, (int8_t)y};
+      n++;
+    }
+  }
+  return n;
+}
+
+static inline int dist2(const Pt& a, const Pt& b) {
+  int dx = (int)a.x - (int)b.x;
+  int dy = (int)a.y - (int)b.y;
+  return dx*dx + dy*dy;
+}
+
+/**
+ * Point the set at a glyph set; rebuilds the point lists and forgets all pair matches if it changed
+ * @return false if the tables are not allocated or too small for this glyph set
+ */
+static inline bool morphBind(MorphSet& set, GlyphRef digit0) {
+  if (!set.pts) return false;
+  if (set.rows == digit0.rows) return true;
+
+  set.rows = nullptr;
+  int n = 0;
+  for (int d = 0; d < 10; d++) {
+    const GlyphRef g{digit0.rows + d * digit0.h, digit0.w, digit0.h};
+    set.ptOff[d] = (uint16_t)n;
+    const int cnt = buildPixelsFromGlyph(g, set.pts + n, set.capPts - n);
+    if (n + cnt > set.capPts) return false;
+    set.ptN[d] = (uint16_t)cnt;
+    n += cnt;
+  }
+  set.total = (uint16_t)n;
+  set.h = digit0.h;
+  memset(set.ready, 0, sizeof(set.ready));
+  set.rows = digit0.rows;
+  return true;
+}
+
+/**
+ * Particle order for from->to (computed on first use)
+ * Entry i < min(nFrom, nTo) is the to-point from-point i travels to; the remaining entries are
+ * to-points without a partner (faded in). From-points i >= nTo have no partner (faded out).
+ */
+static inline const MorphIdx* morphPair(MorphSet& set, int from, int to) {
+  MorphIdx* order = set.order + (size_t)from * set.total + set.ptOff[to];
+  if (set.ready[from] & (1u << to)) return order;
+
+  static bool toUsed[FONT_MAX_LIT_PIXELS];
+  const Pt* fromPts = set.pts + set.ptOff[from];
+  const Pt* toPts = set.pts + set.ptOff[to];
+  const int fromN = set.ptN[from];
+  const int toN = set.ptN[to];
+
+  // Greedy nearest-neighbour matching (good enough for small glyphs)
+  for (int j = 0; j < toN; j++) toUsed[j] = false;
+  const int pairs = fromN < toN ? fromN : toN;
+  for (int i = 0; i < pairs; i++) {
+    int bestJ = -1;
+    int bestD = 1e9;
+    for (int j = 0; j < toN; j++) {
+      if (toUsed[j]) continue;
+      int d = dist2(fromPts[i], toPts[j]);
+      if (d < bestD) { bestD = d; bestJ = j; }
+    }
+    order[i] = (MorphIdx)bestJ;
+    toUsed[bestJ] = true;
+  }
+  int k = pairs;
+  for (int j = 0; j < toN; j++) {
+    if (!toUsed[j]) order[k++] = (MorphIdx)j;
+  }
+
+  set.ready[from] |= (uint16_t)(1u << to);
+  set.pairsBuilt++;
+  return order;
+}
+
+#endif // MORPH_H
@@ -0,0 +1,87 @@
+/*
+ * mqtt_packet.h - Minimal MQTT 3.1.1 encoders for the telemetry publisher
+ *
+ * Only what a QoS 0 publisher needs: CONNECT (clean session, no will, no credentials), the PUBLISH
+ * fixed header + topic, and the CONNACK check. Packets are written into caller-owned buffers, so
+ * nothing allocates; the payload is sent straight after the header from its own buffer.
+ * No Arduino dependencies.
+ */
+
+#ifndef MQTT_PACKET_H
+#define MQTT_PACKET_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+// Largest PUBLISH header for a topic of topicLen bytes (fixed header + remaining length + topic)
+#define MQTT_PUBLISH_HDR_MAX(topicLen) (1 + 4 + 2 + (topicLen))
+
+static const uint8_t MQTT_DISCONNECT[2] = {0xE0, 0x00};
+
+// Remaining Length field (1-4 bytes, 7 bits each); returns the bytes written
+static inline size_t mqttPutVarLen(uint8_t* out, uint32_t n) {
+  size_t i = 0;
+  do {
+    uint8_t b = n & 0x7F;
+    n >>= 7;
+    if (n) b |= 0x80;
+    out[i++] = b;
+  } while (n && i < 4);
+  return i;
+}
+
+// Length-prefixed UTF-8 string
+static inline size_t mqttPutStr(uint8_t* out, const char* s, size_t len) {
+  out[0] = (uint8_t)(len >> 8);
+  out[1] = (uint8_t)len;
+  memcpy(out + 2, s, len);
+  return 2 + len;
+}
+
+/**
+ * CONNECT packet
+ * @param keepAliveS Broker drops the session after 1.5x this without a packet from us (0 = never)
+ * @return Packet length, or 0 if cap is too small
+ */
+static inline size_t mqttConnect(uint8_t* out, size_t cap, const char* clientId, uint16_t keepAliveS) {
+  const size_t idLen = strlen(clientId);
+  const uint32_t rem = 10 + 2 + (uint32_t)idLen;   // variable header + client id
+  if (idLen > 0xFFFF || 1 + 4 + rem > cap) return 0;
+  size_t n = 0;
+  out[n++] = 0x10;
+  n += mqttPutVarLen(out + n, rem);
+  n += mqttPutStr(out + n, "MQTT", 4);
+  out[n++] = 4;      // protocol level 3.1.1
+  out[n++] = 0x02;   // clean session
+  out[n++] = (uint8_t)(keepAliveS >> 8);
+  out[n++] = (uint8_t)keepAliveS;
+  n += mqttPutStr(out + n, clientId, idLen);
+  return n;
+}
+
+/**
+ * PUBLISH fixed header and topic for a QoS 0 message (the payload follows on the wire)
+ * @return Header length, or 0 if cap is too small (see MQTT_PUBLISH_HDR_MAX) or the packet too big
+ */
+static inline size_t mqttPublishHeader(uint8_t* out, size_t cap, const char* topic, size_t payloadLen) {
+  const size_t topicLen = strlen(topic);
+  const size_t rem = 2 + topicLen + payloadLen;
+  if (topicLen > 0xFFFF || rem > 0x0FFFFFFF || MQTT_PUBLISH_HDR_MAX(topicLen) > cap) return 0;
+  size_t n = 0;
+  out[n++] = 0x30;   // PUBLISH, QoS 0, no retain
+  n += mqttPutVarLen(out + n, (uint32_t)rem);
+  n += mqttPutStr(out + n, topic, topicLen);
+  return n;
+}
+
+/**
+ * CONNACK return code
+ * @return 0 accepted, 1-5 refused by the broker, -1 not a CONNACK
+ */
+static inline int mqttConnackCode(const uint8_t* in, size_t n) {
+  if (n < 4 || in[0] != 0x20 || in[1] != 0x02) return -1;
+  return in[3];
+}
+
+#endif // MQTT_PACKET_H
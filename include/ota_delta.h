@@ -0,0 +1,278 @@
+/*
+ * ota_delta.h - Streaming decoders for compressed and delta firmware uploads (POST /api/ota)
+ *
+ * An upload is a plain app image (first byte 0xE9) or an RCD1 delta against the running image, either
+ * of them optionally gzipped (scripts/ota_delta.py makes both). The decoders take input in arbitrary
+ * pieces and keep all state between calls, so an upload that breaks off resumes at the next byte.
+ * Inflating the gzip body is left to the caller (ROM tinfl on the ESP32); GzipHeader only skips the
+ * member header in front of it.
+ *
+ * Delta format (little-endian):
+ *   "RCD1"  u32 image size  u8[32] app_elf_sha256 of the base (esp_app_desc_t of the running image)
+ *   then ops until the image is complete:
+ *     0x01 COPY  varint offset, varint length    bytes from the base image
+ *     0x02 DATA  varint length, then the bytes
+ * Varints are LEB128 (7 bits per byte, low first, at most 5 bytes).
+ * No Arduino dependencies.
+ */
+
+#ifndef OTA_DELTA_H
+#define OTA_DELTA_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+static const uint8_t OTA_IMAGE_MAGIC = 0xE9;   // first byte of an ESP32 app image
+static const size_t OTA_IMAGE_HDR = 24;        // esp_image_header_t
+static const uint8_t OTA_IMAGE_MAX_SEGMENTS = 16;
+static const uint8_t OTA_DELTA_MAGIC[4] = {'R', 'C', 'D', '1'};
+static const size_t OTA_DELTA_HDR = 4 + 4 + 32;
+static const size_t OTA_DELTA_COPY_CHUNK = 256;   // base bytes read per step (stack buffer)
+
+// Gzip member header (RFC 1952): magic, deflate method, then the optional fields the flags announce
+struct GzipHeader {
+  enum State : uint8_t { FIXED, XLEN, EXTRA, NAME, COMMENT, HCRC, DONE, BAD };
+  State state = FIXED;
+  uint8_t flags = 0;
+  uint16_t need = 10;   // bytes still to skip in the current state
+  uint8_t fixed[10];
+
+  /**
+   * Consume header bytes
+   * @return Bytes consumed; the deflate data starts right after them once state == DONE
+   */
+  size_t feed(const uint8_t* in, size_t n) {
+    size_t i = 0;
+    while (i < n && state != DONE && state != BAD) {
+      const uint8_t b = in[i++];
+      switch (state) {
+        case FIXED:
+          fixed[10 - need] = b;
+          if (--need) break;
+          if (fixed[0] != 0x1F || fixed[1] != 0x8B || fixed[2] != 8) {
+            state = BAD;
+            break;
+          }
+          flags = fixed[3];
+          next(XLEN);
+          break;
+        case XLEN:
+          fixed[2 - need] = b;
+          if (--need) break;
+          need = (uint16_t)(fixed[0] | (fixed[1] << 8));
+          state = EXTRA;
+          if (!need) next(NAME);
+          break;
+        case EXTRA:
+          if (!--need) next(NAME);
+          break;
+        case NAME:
+          if (!b) next(COMMENT);
+          break;
+        case COMMENT:
+          if (!b) next(HCRC);
+          break;
+        case HCRC:
+          if (!--need) state = DONE;
+          break;
+        default:
+          break;
+      }
+    }
+    return i;
+  }
+
+ private:
+  // Enter state s, or the first later one whose flag is set (FEXTRA 4, FNAME 8, FCOMMENT 16, FHCRC 2)
+  void next(State s) {
+    if (s == XLEN && !(flags & 4)) s = NAME;
+    if (s == NAME && !(flags & 8)) s = COMMENT;
+    if (s == COMMENT && !(flags & 16)) s = HCRC;
+    if (s == HCRC && !(flags & 2)) s = DONE;
+    state = s;
+    need = s == XLEN || s == HCRC ? 2 : 0;
+  }
+};
+
+/**
+ * Length of an app image from its own headers, for uploads that do not say how long they are.
+ * Layout: the image header (segment count at byte 1, hash_appended at byte 23), then per segment
+ * an 8-byte header (load address, data length) and the data, then a checksum byte padded to 16
+ * and, if hash_appended, a SHA-256.
+ */
+struct OtaImageLength {
+  uint32_t pos = 0;      // image bytes seen
+  uint32_t length = 0;   // whole image, 0 until the last segment header was seen
+  bool bad = false;      // headers are not those of an app image
+
+  bool done() const { return length && pos >= length; }
+
+  void feed(const uint8_t* in, size_t n) {
+    while (n && !length && !bad) {
+      size_t k = 1;
+      if (pos < OTA_IMAGE_HDR) {
+        hdr[pos] = *in;
+        if (pos + 1 == OTA_IMAGE_HDR) {
+          next = OTA_IMAGE_HDR;
+          bad = hdr[0] != OTA_IMAGE_MAGIC || !hdr[1] || hdr[1] > OTA_IMAGE_MAX_SEGMENTS;
+        }
+      } else if (pos < next) {
+        k = n < next - pos ? n : next - pos;   // segment data
+      } else {
+        seg[pos - next] = *in;
+        if (pos - next == 7) {
+          const uint32_t len = seg[4] | (seg[5] << 8) | (seg[6] << 16) | ((uint32_t)seg[7] << 24);
+          bad = len > (1u << 24);
+          next += 8 + len;
+          if (++segs == hdr[1]) length = ((next + 1 + 15) & ~15u) + (hdr[23] == 1 ? 32 : 0);
+        }
+      }
+      pos += (uint32_t)k;
+      in += k;
+      n -= k;
+    }
+    pos += (uint32_t)n;
+  }
+
+ private:
+  uint8_t hdr[OTA_IMAGE_HDR];
+  uint8_t seg[8];          // segment header being read
+  uint8_t segs = 0;        // segment headers read
+  uint32_t next = 0;       // offset of the next segment header
+};
+
+/**
+ * RCD1 delta decoder. Output goes through write(), base bytes come from readBase(); both return
+ * false on failure, which stops decoding.
+ */
+struct OtaDelta {
+  typedef bool (*WriteFn)(void* ctx, const uint8_t* p, size_t n);
+  typedef bool (*ReadBaseFn)(void* ctx, uint32_t offset, uint8_t* p, size_t n);
+
+  WriteFn write = nullptr;
+  ReadBaseFn readBase = nullptr;
+  void* ctx = nullptr;
+  const uint8_t* baseSha = nullptr;   // 32 bytes the header must match
+  uint32_t baseSize = 0;              // readable base bytes
+  const char* error = nullptr;        // set when feed() fails
+
+  uint32_t imageSize = 0;
+  uint32_t produced = 0;
+
+  bool done() const { return state == OPS && hdrLen == OTA_DELTA_HDR && produced == imageSize; }
+
+  // Decode the next piece of the delta; returns false (and sets error) if it is invalid
+  bool feed(const uint8_t* in, size_t n) {
+    size_t i = 0;
+    while (i < n) {
+      if (error) return false;
+      switch (state) {
+        case HEADER: {
+          const size_t k = n - i < OTA_DELTA_HDR - hdrLen ? n - i : OTA_DELTA_HDR - hdrLen;
+          memcpy(hdr + hdrLen, in + i, k);
+          hdrLen += k;
+          i += k;
+          if (hdrLen == OTA_DELTA_HDR && !parseHeader()) return false;
+          break;
+        }
+        case OPS:
+          if (produced == imageSize) return fail("data after the end of the image");
+          op = in[i++];
+          if (op != OP_COPY && op != OP_DATA) return fail("bad delta op");
+          startVarint(op == OP_COPY ? COPY_OFFSET : DATA_LEN);
+          break;
+        case COPY_OFFSET:
+        case COPY_LEN:
+        case DATA_LEN:
+          if (!varintByte(in[i++])) return false;
+          break;
+        case DATA: {
+          const size_t k = n - i < dataLeft ? n - i : dataLeft;
+          if (!emit(in + i, k)) return false;
+          i += k;
+          dataLeft -= (uint32_t)k;
+          if (!dataLeft) state = OPS;
+          break;
+        }
+      }
+    }
+    return !error;
+  }
+
+ private:
+  enum State : uint8_t { HEADER, OPS, COPY_OFFSET, COPY_LEN, DATA_LEN, DATA };
+  enum Op : uint8_t { OP_COPY = 0x01, OP_DATA = 0x02 };
+
+  State state = HEADER;
+  uint8_t hdr[OTA_DELTA_HDR];
+  size_t hdrLen = 0;
+  uint8_t op = 0;
+  uint32_t varint = 0;
+  uint8_t varintShift = 0;
+  uint32_t copyOffset = 0;
+  uint32_t dataLeft = 0;
+
+  bool fail(const char* msg) {
+    error = msg;
+    return false;
+  }
+
+  bool parseHeader() {
+    if (memcmp(hdr, OTA_DELTA_MAGIC, 4) != 0) return fail("not an RCD1 delta");
+    imageSize = (uint32_t)hdr[4] | ((uint32_t)hdr[5] << 8) | ((uint32_t)hdr[6] << 16) | ((uint32_t)hdr[7] << 24);
+    if (baseSha && memcmp(hdr + 8, baseSha, 32) != 0) return fail("delta base is not the running firmware");
+    state = OPS;
+    return true;
+  }
+
+  void startVarint(State s) {
+    state = s;
+    varint = 0;
+    varintShift = 0;
+  }
+
+  bool varintByte(uint8_t b) {
+    if (varintShift > 28) return fail("bad varint");
+    varint |= (uint32_t)(b & 0x7F) << varintShift;
+    varintShift += 7;
+    if (b & 0x80) return true;
+
+    switch (state) {
+      case COPY_OFFSET:
+        copyOffset = varint;
+        startVarint(COPY_LEN);
+        return true;
+      case COPY_LEN:
+        state = OPS;
+        return copy(copyOffset, varint);
+      default:   // DATA_LEN
+        if (!varint) return fail("empty data op");
+        dataLeft = varint;
+        state = DATA;
+        return true;
+    }
+  }
+
+  bool emit(const uint8_t* p, size_t n) {
+    if (n > imageSize - produced) return fail("delta overruns the image size");
+    if (!write(ctx, p, n)) return fail("image write failed");
+    produced += (uint32_t)n;
+    return true;
+  }
+
+  bool copy(uint32_t offset, uint32_t len) {
+    if (offset > baseSize || len > baseSize - offset) return fail("copy outside the base image");
+    uint8_t buf[OTA_DELTA_COPY_CHUNK];
+    while (len) {
+      const size_t k = len < sizeof(buf) ? len : sizeof(buf);
+      if (!readBase(ctx, offset, buf, k)) return fail("base read failed");
+      if (!emit(buf, k)) return false;
+      offset += (uint32_t)k;
+      len -= (uint32_t)k;
+    }
+    return true;
+  }
+};
+
+#endif // OTA_DELTA_H
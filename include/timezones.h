@@ -6,7 +6,7 @@
  * 
  * To add a new timezone:
  * 1. Find the POSIX TZ string for your location
- * 2. Add entry to timezones[] array: {"City, Country", "TZ_STRING"}
+ * 2. Add entry to timezones[] array: {"City, Country", "TZ_STRING", TZR_<REGION>}
  * 3. Increment will be automatic via sizeof calculation
  * 
  * POSIX TZ String Format:
@@ -23,128 +23,165 @@
 #ifndef TIMEZONES_H
 #define TIMEZONES_H
 
+#include <stdint.h>
+
 // ======================== TIMEZONE CONFIGURATION ========================
+// Region each timezone is listed under in the web UI (order = display order)
+enum TimezoneRegion : uint8_t {
+  TZR_OCEANIA,
+  TZR_NORTH_AMERICA,
+  TZR_SOUTH_AMERICA,
+  TZR_WESTERN_EUROPE,
+  TZR_NORTHERN_EUROPE,
+  TZR_EASTERN_EUROPE,
+  TZR_MIDDLE_EAST,
+  TZR_SOUTH_ASIA,
+  TZR_SOUTHEAST_ASIA,
+  TZR_EAST_ASIA,
+  TZR_CENTRAL_ASIA,
+  TZR_CAUCASUS,
+  TZR_AFRICA,
+  TZR_COUNT
+};
+
+const char* const timezoneRegionNames[TZR_COUNT] = {
+  "Australia & Oceania",
+  "North America",
+  "South America",
+  "Western Europe",
+  "Northern Europe",
+  "Central & Eastern Europe",
+  "Middle East",
+  "South Asia",
+  "Southeast Asia",
+  "East Asia",
+  "Central Asia",
+  "Caucasus",
+  "Africa",
+};
+
 struct TimezoneInfo {
   const char* name;
   const char* tzString;
+  TimezoneRegion region;
 };
 
 // Expanded timezone array with 88 global timezones (organized by region)
 // Default timezone is index 0 (Sydney, Australia)
 const TimezoneInfo timezones[] = {
   // ==================== AUSTRALIA & OCEANIA (0-11) ====================
-  {"Sydney, Australia", "AEST-10AEDT,M10.1.0,M4.1.0/3"},  // INDEX 0 - DEFAULT
-  {"Adelaide, Australia", "ACST-9:30ACDT,M10.1.0,M4.1.0/3"},
-  {"Brisbane, Australia", "AEST-10"},
-  {"Darwin, Australia", "ACST-9:30"},
-  {"Hobart, Australia", "AEST-10AEDT,M10.1.0,M4.1.0/3"},
-  {"Melbourne, Australia", "AEST-10AEDT,M10.1.0,M4.1.0/3"},
-  {"Perth, Australia", "AWST-8"},
-  {"Auckland, New Zealand", "NZST-12NZDT,M9.5.0,M4.1.0/3"},
-  {"Wellington, New Zealand", "NZST-12NZDT,M9.5.0,M4.1.0/3"},
-  {"Fiji", "FJT-12FJST,M11.1.0,M1.3.0/3"},
-  {"Noumea, New Caledonia", "NCT-11"},
-  {"Port Moresby, Papua New Guinea", "PGT-10"},
+  {"Sydney, Australia", "AEST-10AEDT,M10.1.0,M4.1.0/3", TZR_OCEANIA},  // INDEX 0 - DEFAULT
+  {"Adelaide, Australia", "ACST-9:30ACDT,M10.1.0,M4.1.0/3", TZR_OCEANIA},
+  {"Brisbane, Australia", "AEST-10", TZR_OCEANIA},
+  {"Darwin, Australia", "ACST-9:30", TZR_OCEANIA},
+  {"Hobart, Australia", "AEST-10AEDT,M10.1.0,M4.1.0/3", TZR_OCEANIA},
+  {"Melbourne, Australia", "AEST-10AEDT,M10.1.0,M4.1.0/3", TZR_OCEANIA},
+  {"Perth, Australia", "AWST-8", TZR_OCEANIA},
+  {"Auckland, New Zealand", "NZST-12NZDT,M9.5.0,M4.1.0/3", TZR_OCEANIA},
+  {"Wellington, New Zealand", "NZST-12NZDT,M9.5.0,M4.1.0/3", TZR_OCEANIA},
+  {"Fiji", "FJT-12FJST,M11.1.0,M1.3.0/3", TZR_OCEANIA},
+  {"Noumea, New Caledonia", "NCT-11", TZR_OCEANIA},
+  {"Port Moresby, Papua New Guinea", "PGT-10", TZR_OCEANIA},
 
   // ==================== NORTH AMERICA (12-22) ====================
-  {"Anchorage, USA", "AKST9AKDT,M3.2.0,M11.1.0"},
-  {"Chicago, USA", "CST6CDT,M3.2.0,M11.1.0"},
-  {"Denver, USA", "MST7MDT,M3.2.0,M11.1.0"},
-  {"Honolulu, USA", "HST10"},
-  {"Los Angeles, USA", "PST8PDT,M3.2.0,M11.1.0"},
-  {"New York, USA", "EST5EDT,M3.2.0,M11.1.0"},
-  {"Phoenix, USA", "MST7"},
-  {"Montreal, Canada", "EST5EDT,M3.2.0,M11.1.0"},
-  {"Toronto, Canada", "EST5EDT,M3.2.0,M11.1.0"},
-  {"Vancouver, Canada", "PST8PDT,M3.2.0,M11.1.0"},
-  {"Mexico City, Mexico", "CST6CDT,M4.1.0,M10.5.0"},
+  {"Anchorage, USA", "AKST9AKDT,M3.2.0,M11.1.0", TZR_NORTH_AMERICA},
+  {"Chicago, USA", "CST6CDT,M3.2.0,M11.1.0", TZR_NORTH_AMERICA},
+  {"Denver, USA", "MST7MDT,M3.2.0,M11.1.0", TZR_NORTH_AMERICA},
+  {"Honolulu, USA", "HST10", TZR_NORTH_AMERICA},
+  {"Los Angeles, USA", "PST8PDT,M3.2.0,M11.1.0", TZR_NORTH_AMERICA},
+  {"New York, USA", "EST5EDT,M3.2.0,M11.1.0", TZR_NORTH_AMERICA},
+  {"Phoenix, USA", "MST7", TZR_NORTH_AMERICA},
+  {"Montreal, Canada", "EST5EDT,M3.2.0,M11.1.0", TZR_NORTH_AMERICA},
+  {"Toronto, Canada", "EST5EDT,M3.2.0,M11.1.0", TZR_NORTH_AMERICA},
+  {"Vancouver, Canada", "PST8PDT,M3.2.0,M11.1.0", TZR_NORTH_AMERICA},
+  {"Mexico City, Mexico", "CST6CDT,M4.1.0,M10.5.0", TZR_NORTH_AMERICA},
 
   // ==================== SOUTH AMERICA (23-28) ====================
-  {"Bogota, Colombia", "COT5"},
-  {"Buenos Aires, Argentina", "ART3"},
-  {"Caracas, Venezuela", "VET4:30"},
-  {"Lima, Peru", "PET5"},
-  {"Santiago, Chile", "CLT4CLST,M8.2.6/24,M5.2.6/24"},
-  {"Sao Paulo, Brazil", "BRT3BRST,M10.3.0/0,M2.3.0/0"},
-
-  // ==================== WESTERN EUROPE (29-39) ====================
-  {"Amsterdam, Netherlands", "CET-1CEST,M3.5.0,M10.5.0/3"},
-  {"Berlin, Germany", "CET-1CEST,M3.5.0,M10.5.0/3"},
-  {"Brussels, Belgium", "CET-1CEST,M3.5.0,M10.5.0/3"},
-  {"Dublin, Ireland", "IST-1GMT0,M10.5.0,M3.5.0/1"},
-  {"Lisbon, Portugal", "WET0WEST,M3.5.0/1,M10.5.0"},
-  {"London, UK", "GMT0BST,M3.5.0/1,M10.5.0"},
-  {"Madrid, Spain", "CET-1CEST,M3.5.0,M10.5.0/3"},
-  {"Paris, France", "CET-1CEST,M3.5.0,M10.5.0/3"},
-  {"Reykjavik, Iceland", "GMT0"},
-  {"Rome, Italy", "CET-1CEST,M3.5.0,M10.5.0/3"},
-  {"Vienna, Austria", "CET-1CEST,M3.5.0,M10.5.0/3"},
-  {"Zurich, Switzerland", "CET-1CEST,M3.5.0,M10.5.0/3"},
-
-  // ==================== NORTHERN EUROPE (40-43) ====================
-  {"Copenhagen, Denmark", "CET-1CEST,M3.5.0,M10.5.0/3"},
-  {"Helsinki, Finland", "EET-2EEST,M3.5.0/3,M10.5.0/4"},
-  {"Oslo, Norway", "CET-1CEST,M3.5.0,M10.5.0/3"},
-  {"Stockholm, Sweden", "CET-1CEST,M3.5.0,M10.5.0/3"},
-
-  // ==================== CENTRAL & EASTERN EUROPE (44-51) ====================
-  {"Athens, Greece", "EET-2EEST,M3.5.0/3,M10.5.0/4"},
-  {"Bucharest, Romania", "EET-2EEST,M3.5.0/3,M10.5.0/4"},
-  {"Budapest, Hungary", "CET-1CEST,M3.5.0,M10.5.0/3"},
-  {"Kiev, Ukraine", "EET-2EEST,M3.5.0/3,M10.5.0/4"},
-  {"Minsk, Belarus", "MSK-3"},
-  {"Moscow, Russia", "MSK-3"},
-  {"Prague, Czech Republic", "CET-1CEST,M3.5.0,M10.5.0/3"},
-  {"Warsaw, Poland", "CET-1CEST,M3.5.0,M10.5.0/3"},
-
-  // ==================== MIDDLE EAST (52-56) ====================
-  {"Dubai, UAE", "GST-4"},
-  {"Istanbul, Turkey", "TRT-3"},
-  {"Riyadh, Saudi Arabia", "AST-3"},
-  {"Tehran, Iran", "IRST-3:30IRDT,J79/24,J263/24"},
-  {"Tel Aviv, Israel", "IST-2IDT,M3.4.4/26,M10.5.0"},
-
-  // ==================== SOUTH ASIA (57-63) ====================
-  {"Colombo, Sri Lanka", "IST-5:30"},
-  {"Dhaka, Bangladesh", "BST-6"},
-  {"Kabul, Afghanistan", "AFT-4:30"},
-  {"Karachi, Pakistan", "PKT-5"},
-  {"Kathmandu, Nepal", "NPT-5:45"},
-  {"Mumbai, India", "IST-5:30"},
-  {"Thimphu, Bhutan", "BTT-6"},
-
-  // ==================== SOUTHEAST ASIA (64-70) ====================
-  {"Bangkok, Thailand", "ICT-7"},
-  {"Ho Chi Minh, Vietnam", "ICT-7"},
-  {"Jakarta, Indonesia", "WIB-7"},
-  {"Kuala Lumpur, Malaysia", "MYT-8"},
-  {"Manila, Philippines", "PHT-8"},
-  {"Singapore", "SGT-8"},
-  {"Yangon, Myanmar", "MMT-6:30"},
-
-  // ==================== EAST ASIA (71-76) ====================
-  {"Hong Kong", "HKT-8"},
-  {"Seoul, South Korea", "KST-9"},
-  {"Shanghai, China", "CST-8"},
-  {"Taipei, Taiwan", "CST-8"},
-  {"Tokyo, Japan", "JST-9"},
-  {"Ulaanbaatar, Mongolia", "ULAT-8"},
-
-  // ==================== CENTRAL ASIA (77-79) ====================
-  {"Almaty, Kazakhstan", "ALMT-6"},
-  {"Bishkek, Kyrgyzstan", "KGT-6"},
-  {"Tashkent, Uzbekistan", "UZT-5"},
-
-  // ==================== CAUCASUS (80-82) ====================
-  {"Baku, Azerbaijan", "AZT-4"},
-  {"Tbilisi, Georgia", "GET-4"},
-  {"Yerevan, Armenia", "AMT-4"},
-
-  // ==================== AFRICA (83-86) ====================
-  {"Cairo, Egypt", "EET-2"},
-  {"Johannesburg, South Africa", "SAST-2"},
-  {"Lagos, Nigeria", "WAT-1"},
-  {"Nairobi, Kenya", "EAT-3"}
+  {"Bogota, Colombia", "COT5", TZR_SOUTH_AMERICA},
+  {"Buenos Aires, Argentina", "ART3", TZR_SOUTH_AMERICA},
+  {"Caracas, Venezuela", "VET4:30", TZR_SOUTH_AMERICA},
+  {"Lima, Peru", "PET5", TZR_SOUTH_AMERICA},
+  {"Santiago, Chile", "CLT4CLST,M8.2.6/24,M5.2.6/24", TZR_SOUTH_AMERICA},
+  {"Sao Paulo, Brazil", "BRT3BRST,M10.3.0/0,M2.3.0/0", TZR_SOUTH_AMERICA},
+
+  // ==================== WESTERN EUROPE (29-40) ====================
+  {"Amsterdam, Netherlands", "CET-1CEST,M3.5.0,M10.5.0/3", TZR_WESTERN_EUROPE},
+  {"Berlin, Germany", "CET-1CEST,M3.5.0,M10.5.0/3", TZR_WESTERN_EUROPE},
+  {"Brussels, Belgium", "CET-1CEST,M3.5.0,M10.5.0/3", TZR_WESTERN_EUROPE},
+  {"Dublin, Ireland", "IST-1GMT0,M10.5.0,M3.5.0/1", TZR_WESTERN_EUROPE},
+  {"Lisbon, Portugal", "WET0WEST,M3.5.0/1,M10.5.0", TZR_WESTERN_EUROPE},
+  {"London, UK", "GMT0BST,M3.5.0/1,M10.5.0", TZR_WESTERN_EUROPE},
+  {"Madrid, Spain", "CET-1CEST,M3.5.0,M10.5.0/3", TZR_WESTERN_EUROPE},
+  {"Paris, France", "CET-1CEST,M3.5.0,M10.5.0/3", TZR_WESTERN_EUROPE},
+  {"Reykjavik, Iceland", "GMT0", TZR_WESTERN_EUROPE},
+  {"Rome, Italy", "CET-1CEST,M3.5.0,M10.5.0/3", TZR_WESTERN_EUROPE},
+  {"Vienna, Austria", "CET-1CEST,M3.5.0,M10.5.0/3", TZR_WESTERN_EUROPE},
+  {"Zurich, Switzerland", "CET-1CEST,M3.5.0,M10.5.0/3", TZR_WESTERN_EUROPE},
+
+  // ==================== NORTHERN EUROPE (41-44) ====================
+  {"Copenhagen, Denmark", "CET-1CEST,M3.5.0,M10.5.0/3", TZR_NORTHERN_EUROPE},
+  {"Helsinki, Finland", "EET-2EEST,M3.5.0/3,M10.5.0/4", TZR_NORTHERN_EUROPE},
+  {"Oslo, Norway", "CET-1CEST,M3.5.0,M10.5.0/3", TZR_NORTHERN_EUROPE},
+  {"Stockholm, Sweden", "CET-1CEST,M3.5.0,M10.5.0/3", TZR_NORTHERN_EUROPE},
+
+  // ==================== CENTRAL & EASTERN EUROPE (45-52) ====================
+  {"Athens, Greece", "EET-2EEST,M3.5.0/3,M10.5.0/4", TZR_EASTERN_EUROPE},
+  {"Bucharest, Romania", "EET-2EEST,M3.5.0/3,M10.5.0/4", TZR_EASTERN_EUROPE},
+  {"Budapest, Hungary", "CET-1CEST,M3.5.0,M10.5.0/3", TZR_EASTERN_EUROPE},
+  {"Kiev, Ukraine", "EET-2EEST,M3.5.0/3,M10.5.0/4", TZR_EASTERN_EUROPE},
+  {"Minsk, Belarus", "MSK-3", TZR_EASTERN_EUROPE},
+  {"Moscow, Russia", "MSK-3", TZR_EASTERN_EUROPE},
+  {"Prague, Czech Republic", "CET-1CEST,M3.5.0,M10.5.0/3", TZR_EASTERN_EUROPE},
+  {"Warsaw, Poland", "CET-1CEST,M3.5.0,M10.5.0/3", TZR_EASTERN_EUROPE},
+
+  // ==================== MIDDLE EAST (53-57) ====================
+  {"Dubai, UAE", "GST-4", TZR_MIDDLE_EAST},
+  {"Istanbul, Turkey", "TRT-3", TZR_MIDDLE_EAST},
+  {"Riyadh, Saudi Arabia", "AST-3", TZR_MIDDLE_EAST},
+  {"Tehran, Iran", "IRST-3:30IRDT,J79/24,J263/24", TZR_MIDDLE_EAST},
+  {"Tel Aviv, Israel", "IST-2IDT,M3.4.4/26,M10.5.0", TZR_MIDDLE_EAST},
+
+  // ==================== SOUTH ASIA (58-64) ====================
+  {"Colombo, Sri Lanka", "IST-5:30", TZR_SOUTH_ASIA},
+  {"Dhaka, Bangladesh", "BST-6", TZR_SOUTH_ASIA},
+  {"Kabul, Afghanistan", "AFT-4:30", TZR_SOUTH_ASIA},
+  {"Karachi, Pakistan", "PKT-5", TZR_SOUTH_ASIA},
+  {"Kathmandu, Nepal", "NPT-5:45", TZR_SOUTH_ASIA},
+  {"Mumbai, India", "IST-5:30", TZR_SOUTH_ASIA},
+  {"Thimphu, Bhutan", "BTT-6", TZR_SOUTH_ASIA},
+
+  // ==================== SOUTHEAST ASIA (65-71) ====================
+  {"Bangkok, Thailand", "ICT-7", TZR_SOUTHEAST_ASIA},
+  {"Ho Chi Minh, Vietnam", "ICT-7", TZR_SOUTHEAST_ASIA},
+  {"Jakarta, Indonesia", "WIB-7", TZR_SOUTHEAST_ASIA},
+  {"Kuala Lumpur, Malaysia", "MYT-8", TZR_SOUTHEAST_ASIA},
+  {"Manila, Philippines", "PHT-8", TZR_SOUTHEAST_ASIA},
+  {"Singapore", "SGT-8", TZR_SOUTHEAST_ASIA},
+  {"Yangon, Myanmar", "MMT-6:30", TZR_SOUTHEAST_ASIA},
+
+  // ==================== EAST ASIA (72-77) ====================
+  {"Hong Kong", "HKT-8", TZR_EAST_ASIA},
+  {"Seoul, South Korea", "KST-9", TZR_EAST_ASIA},
+  {"Shanghai, China", "CST-8", TZR_EAST_ASIA},
+  {"Taipei, Taiwan", "CST-8", TZR_EAST_ASIA},
+  {"Tokyo, Japan", "JST-9", TZR_EAST_ASIA},
+  {"Ulaanbaatar, Mongolia", "ULAT-8", TZR_EAST_ASIA},
+
+  // ==================== CENTRAL ASIA (78-80) ====================
+  {"Almaty, Kazakhstan", "ALMT-6", TZR_CENTRAL_ASIA},
+  {"Bishkek, Kyrgyzstan", "KGT-6", TZR_CENTRAL_ASIA},
+  {"Tashkent, Uzbekistan", "UZT-5", TZR_CENTRAL_ASIA},
+
+  // ==================== CAUCASUS (81-83) ====================
+  {"Baku, Azerbaijan", "AZT-4", TZR_CAUCASUS},
+  {"Tbilisi, Georgia", "GET-4", TZR_CAUCASUS},
+  {"Yerevan, Armenia", "AMT-4", TZR_CAUCASUS},
+
+  // ==================== AFRICA (84-87) ====================
+  {"Cairo, Egypt", "EET-2", TZR_AFRICA},
+  {"Johannesburg, South Africa", "SAST-2", TZR_AFRICA},
+  {"Lagos, Nigeria", "WAT-1", TZR_AFRICA},
+  {"Nairobi, Kenya", "EAT-3", TZR_AFRICA}
 };
 
 // Calculate number of timezones automatically
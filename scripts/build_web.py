@@ -0,0 +1,84 @@
+"""
+build_web.py - Package the web UI for LittleFS
+
+Reads the sources in web/ and writes data/ (the LittleFS image):
+  - app.js / style.css  -> app.<hash>.js.gz / style.<hash>.css.gz (content-hashed, immutable)
+  - index.html          -> index.html.gz with references rewritten to the hashed names
+  - web.manifest        -> one line per asset: <url> <file> <etag> <content-type> <immutable 0|1>
+
+Runs as a PlatformIO pre-script (extra_scripts in platformio.ini), so buildfs/uploadfs always
+get fresh assets. Can also be run by hand: python3 scripts/build_web.py
+Output is deterministic (gzip mtime 0), so unchanged sources give byte-identical images.
+"""
+
+import gzip
+import hashlib
+import os
+
+try:
+    Import("env")  # noqa: F821 (provided by PlatformIO/SCons)
+    PROJECT_DIR = env.subst("$PROJECT_DIR")  # noqa: F821
+except NameError:
+    PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+SRC_DIR = os.path.join(PROJECT_DIR, "web")
+OUT_DIR = os.path.join(PROJECT_DIR, "data")
+MANIFEST = "web.manifest"
+
+# Hashed assets: source name -> (content type, reference in index.html)
+HASHED = [
+    ("app.js", "application/javascript", 'src="/app.js"'),
+    ("style.css", "text/css", 'href="/style.css"'),
+]
+
+
+def content_hash(data):
+    return hashlib.sha256(data).hexdigest()[:8]
+
+
+def write_gz(name, data):
+    with open(os.path.join(OUT_DIR, name), "wb") as f:
+        f.write(gzip.compress(data, compresslevel=9, mtime=0))
+
+
+def clean_outputs():
+    # Only remove what this script produces (the runtime timezone cache also lives in LittleFS)
+    for name in os.listdir(OUT_DIR):
+        if name.endswith(".gz") or name == MANIFEST:
+            os.remove(os.path.join(OUT_DIR, name))
+
+
+def build():
+    os.makedirs(OUT_DIR, exist_ok=True)
+    clean_outputs()
+
+    with open(os.path.join(SRC_DIR, "index.html"), "rb") as f:
+        index = f.read()
+
+    entries = []
+    for name, ctype, ref in HASHED:
+        with open(os.path.join(SRC_DIR, name), "rb") as f:
+            data = f.read()
+        h = content_hash(data)
+        stem, ext = os.path.splitext(name)
+        hashed = "%s.%s%s" % (stem, h, ext)
+        new_ref = ref.replace("/" + name, "/" + hashed)
+        if ref.encode() not in index:
+            raise SystemExit("build_web: %s not referenced as %s in index.html" % (name, ref))
+        index = index.replace(ref.encode(), new_ref.encode())
+        write_gz(hashed + ".gz", data)
+        entries.append(("/" + hashed, "/" + hashed + ".gz", h, ctype, 1))
+
+    # index.html changes whenever any asset does, since it carries their hashes
+    write_gz("index.html.gz", index)
+    entries.insert(0, ("/", "/index.html.gz", content_hash(index), "text/html", 0))
+
+    with open(os.path.join(OUT_DIR, MANIFEST), "w") as f:
+        for url, path, etag, ctype, immutable in entries:
+            f.write('%s %s "%s" %s %d\n' % (url, path, etag, ctype, immutable))
+
+    total = sum(os.path.getsize(os.path.join(OUT_DIR, e[1].lstrip("/"))) for e in entries)
+    print("build_web: %d assets, %d bytes gzipped -> %s" % (len(entries), total, OUT_DIR))
+
+
+build()
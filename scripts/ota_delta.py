@@ -0,0 +1,209 @@
+#!/usr/bin/env python3
+"""
+ota_delta.py - Build and push compressed / delta firmware images for POST /api/ota
+
+  python3 scripts/ota_delta.py pack NEW.bin -o fw.bin.gz
+      gzip the full image (usually ~60% of the size)
+
+  python3 scripts/ota_delta.py delta OLD.bin NEW.bin -o fw.rcd.gz
+      RCD1 delta from the image the clock runs now (OLD.bin must be that exact build), gzipped;
+      the clock checks OLD.bin's app_elf_sha256 against its own before applying it
+
+  python3 scripts/ota_delta.py push FILE HOST [--password PW]
+      upload FILE (any of the above, or a plain .bin); a broken-off upload is resumed from the
+      offset the clock reports instead of starting over
+
+Images are the firmware.bin PlatformIO writes to .pio/build/<env>/. The delta format is described in
+include/ota_delta.h. Output is deterministic (gzip mtime 0).
+"""
+
+import argparse
+import base64
+import gzip
+import json
+import sys
+import time
+import urllib.error
+import urllib.request
+import zlib
+
+MAGIC = b"RCD1"
+BLOCK = 32        # shortest match worth a COPY op
+STEP = 4          # old image is indexed every STEP bytes (a match of BLOCK + STEP always hits)
+APP_DESC = 32     # esp_app_desc_t offset: image header (24) + first segment header (8)
+APP_DESC_MAGIC = 0xABCD5432
+ELF_SHA_OFF = APP_DESC + 144
+OTA_USER = "ota"
+DEFAULT_PASSWORD = "change-me"   # OTA_PASSWORD in include/config.h
+RETRIES = 5
+
+
+def varint(n):
+    out = bytearray()
+    while True:
+        b = n & 0x7F
+        n >>= 7
+        out.append(b | (0x80 if n else 0))
+        if not n:
+            return bytes(out)
+
+
+def elf_sha(image):
+    if len(image) < ELF_SHA_OFF + 32 or image[0] != 0xE9:
+        sys.exit("not an ESP32 app image")
+    if int.from_bytes(image[APP_DESC:APP_DESC + 4], "little") != APP_DESC_MAGIC:
+        sys.exit("no esp_app_desc_t in the first segment")
+    return image[ELF_SHA_OFF:ELF_SHA_OFF + 32]
+
+
+def make_delta(old, new):
+    index = {}
+    for off in range(0, len(old) - BLOCK + 1, STEP):
+        index.setdefault(old[off:off + BLOCK], off)
+
+    ops = bytearray(MAGIC + len(new).to_bytes(4, "little") + elf_sha(old))
+    lit_start = 0
+    i = 0
+    while i + BLOCK <= len(new):
+        off = index.get(new[i:i + BLOCK])
+        if off is None:
+            i += 1
+            continue
+        # Grow the match backwards into the pending literal, then forwards
+        start = i
+        while start > lit_start and off > 0 and new[start - 1] == old[off - 1]:
+            start -= 1
+            off -= 1
+        end = i + BLOCK
+        oend = off + (end - start)
+        while end < len(new) and oend < len(old) and new[end] == old[oend]:
+            end += 1
+            oend += 1
+        if start > lit_start:
+            ops += b"\x02" + varint(start - lit_start) + new[lit_start:start]
+        ops += b"\x01" + varint(off) + varint(end - start)
+        lit_start = i = end
+    if lit_start < len(new):
+        ops += b"\x02" + varint(len(new) - lit_start) + new[lit_start:]
+    return bytes(ops)
+
+
+def apply_delta(old, delta):
+    """Reference decoder, used to check every delta before it is written"""
+    size = int.from_bytes(delta[4:8], "little")
+    out = bytearray()
+    i = 40
+
+    def read_varint():
+        nonlocal i
+        n = shift = 0
+        while True:
+            b = delta[i]
+            i += 1
+            n |= (b & 0x7F) << shift
+            shift += 7
+            if not b & 0x80:
+                return n
+
+    while len(out) < size:
+        op = delta[i]
+        i += 1
+        if op == 1:
+            off = read_varint()
+            n = read_varint()
+            out += old[off:off + n]
+        else:
+            n = read_varint()
+            out += delta[i:i + n]
+            i += n
+    return bytes(out)
+
+
+def pack(data):
+    return gzip.compress(data, compresslevel=9, mtime=0)
+
+
+def request(method, url, password, body=None, content_type=None):
+    req = urllib.request.Request(url, data=body, method=method)
+    token = base64.b64encode(f"{OTA_USER}:{password}".encode()).decode()
+    req.add_header("Authorization", "Basic " + token)
+    if content_type:
+        req.add_header("Content-Type", content_type)
+    try:
+        with urllib.request.urlopen(req, timeout=120) as r:
+            return r.status, json.loads(r.read() or b"{}")
+    except urllib.error.HTTPError as e:
+        return e.code, json.loads(e.read() or b"{}")
+
+
+def push(path, host, password):
+    data = open(path, "rb").read()
+    upload_id = zlib.crc32(data)
+    base = f"http://{host}/api/ota"
+    for attempt in range(RETRIES):
+        offset = 0
+        try:
+            _, st = request("GET", base, password)
+            if st.get("id") == upload_id:
+                offset = st.get("received", 0)
+            if offset:
+                print(f"resuming at {offset}/{len(data)} bytes")
+            boundary = "----retroclock%08x" % upload_id
+            body = (f"--{boundary}\r\nContent-Disposition: form-data; name=\"image\"; filename=\"fw\"\r\n"
+                    f"Content-Type: application/octet-stream\r\n\r\n").encode()
+            body += data[offset:] + f"\r\n--{boundary}--\r\n".encode()
+            url = f"{base}?id={upload_id}&offset={offset}&size={len(data)}"
+            code, res = request("POST", url, password, body, f"multipart/form-data; boundary={boundary}")
+        except (OSError, ValueError) as e:
+            print(f"attempt {attempt + 1}: {e}")
+            time.sleep(2)
+            continue
+        if code == 200:
+            print(f"done, {res.get('written', 0)} image bytes written; rebooting")
+            return
+        if code == 202:
+            if res.get("received", 0) >= len(data):
+                sys.exit("the clock decoded all of FILE but the image is incomplete")
+            print(f"partial upload kept at {res.get('received')} bytes")
+            continue
+        sys.exit(f"upload rejected ({code}): {res.get('error', res)}")
+    sys.exit("giving up after %d attempts" % RETRIES)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = ap.add_subparsers(dest="cmd", required=True)
+    p = sub.add_parser("pack")
+    p.add_argument("new")
+    p.add_argument("-o", "--out", required=True)
+    d = sub.add_parser("delta")
+    d.add_argument("old")
+    d.add_argument("new")
+    d.add_argument("-o", "--out", required=True)
+    u = sub.add_parser("push")
+    u.add_argument("file")
+    u.add_argument("host")
+    u.add_argument("--password", default=DEFAULT_PASSWORD)
+    args = ap.parse_args()
+
+    if args.cmd == "push":
+        push(args.file, args.host, args.password)
+        return
+
+    new = open(args.new, "rb").read()
+    elf_sha(new)
+    if args.cmd == "pack":
+        out = pack(new)
+    else:
+        old = open(args.old, "rb").read()
+        delta = make_delta(old, new)
+        if apply_delta(old, delta) != new:
+            sys.exit("internal error: delta does not reproduce the new image")
+        out = pack(delta)
+        print(f"delta {len(delta)} bytes before gzip")
+    open(args.out, "wb").write(out)
+    print(f"{args.out}: {len(out)} bytes ({len(out) * 100 // len(new)}% of {len(new)})")
+
+
+if __name__ == "__main__":
+    main()
@@ -22,8 +22,9 @@
  * - Date format selection (5 formats: ISO, European, US, German, Verbose)
  * - NTP server dropdown with 9 preset servers (global + regional pools)
  * - Runtime-adjustable debug level (Off, Error, Warning, Info, Verbose)
- * - OTA firmware updates for easy maintenance
+ * - OTA firmware updates (ArduinoOTA, or resumable gzip/delta uploads to /api/ota) with the clock running
  * - LittleFS-based web file serving
+ * - Power save (lower CPU clock, idle cores) and a night blank schedule with wake on touch / web
  *
  * HARDWARE:
  * - ESP32-2432S028 (CYD) - 2.8" ILI9341 320×240 TFT display
@@ -69,7 +70,9 @@
 #include <Arduino.h>
 
 #include <WiFi.h>
+#include <WiFiUdp.h>
 #include <WebServer.h>
+#include <WebSocketsServer.h>
 #include <WiFiManager.h>
 
 #include <ArduinoJson.h>
@@ -80,22 +83,48 @@
 
 #include <ArduinoOTA.h>
 #include <time.h>
+#include <esp_sntp.h>
 #include <Wire.h>
+#include <atomic>
+#include <algorithm>
+#include <new>
+#include <type_traits>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <esp_ota_ops.h>
+#include <esp_partition.h>
+#include <rom/miniz.h>
+#include <esp_freertos_hooks.h>
+#include <hal/cpu_hal.h>
+#if CONFIG_PM_ENABLE
+#include <driver/gpio.h>
+#include <esp_pm.h>
+#include <esp_sleep.h>
+#endif
 
 #include "config.h"
 #include "timezones.h"
-
-// Sensor libraries (only one will be used based on config.h)
-#ifdef USE_BME280
-  #include <Adafruit_BME280.h>
+#include "mirror_codec.h"
+#include "mqtt_packet.h"
+#include "ota_delta.h"
+#include "fonts.h"
+#include "framebuffer.h"
+#include "easing.h"
+#include "morph.h"
+#ifdef BENCH_FIRMWARE
+#include "bench.h"
 #endif
-#ifdef USE_SHT3X
-  #include <Adafruit_SHT31.h>
-#endif
-#ifdef USE_HTU21D
-  #include <Adafruit_HTU21DF.h>
+#include "json_arena.h"
+#include "gamma.h"
+#ifdef HUB75_ENABLE
+#include "hub75_dma.h"
 #endif
 
+// Sensor libraries (all drivers are built in; detectSensor() picks one at runtime)
+#include <Adafruit_BME280.h>
+#include <Adafruit_SHT31.h>
+#include <Adafruit_HTU21DF.h>
+
 // =========================
 // Debug System
 // =========================
@@ -150,6 +179,189 @@ static uint8_t debugLevel = DEBUG_LEVEL;
 #define DBG_OK(s)     DBG_INFO("✓ %s\n", s)
 #define DBG_ERR(s)    DBG_ERROR("%s\n", s)
 
+// =========================
+// Profiler
+// =========================
+/**
+ * Lightweight stage profiler: esp_timer_get_time() deltas go into fixed-size ring buffers,
+ * summarised as min/avg/p99/max over the last PERF_RING_SIZE samples.
+ *
+ * USAGE:
+ *   { PerfScope ps(PERF_HTTP); server.handleClient(); }
+ *
+ * Results are served at /api/perf and logged every PERF_LOG_INTERVAL_MS at DBG_LEVEL_VERBOSE.
+ */
+enum PerfStage : uint8_t {
+  PERF_DRAW_FRAME = 0,   // drawFrame(): compose logical framebuffer
+  PERF_RENDER,           // renderFBToTFT(): matrix blit + push (excludes status bar)
+  PERF_STATUS_BAR,       // drawStatusBar()
+  PERF_HTTP,             // server.handleClient()
+  PERF_SENSOR,           // updateSensorData()
+  PERF_OTA,              // ArduinoOTA.handle()
+  PERF_FRAME,            // whole render-task frame (draw + render + status bar)
+  PERF_HUB75,            // hub75Present(): bit-plane update of changed rows (HUB75_ENABLE builds)
+  PERF_TELEMETRY,        // telemetrySend(): build + send one telemetry message (telemetry task)
+  PERF_STAGE_COUNT
+};
+
+static const char* const PERF_STAGE_NAMES[PERF_STAGE_COUNT] = {
+  "drawFrame", "renderFBToTFT", "drawStatusBar", "handleClient", "updateSensorData", "otaHandle", "frame",
+  "hub75Present", "telemetrySend"
+};
+
+struct PerfRing {
+  uint32_t samples[PERF_RING_SIZE];   // microseconds
+  uint16_t head;                      // next write position
+  uint16_t count;                     // valid samples (<= PERF_RING_SIZE)
+  uint32_t total;                     // lifetime sample count
+};
+
+struct PerfSummary {
+  uint32_t count;
+  uint32_t minUs;
+  uint32_t avgUs;
+  uint32_t p99Us;
+  uint32_t maxUs;
+};
+
+static PerfRing perfRings[PERF_STAGE_COUNT];
+static uint32_t perfMissedFrames = 0;        // frames that started later than their FRAME_MS slot
+static int64_t perfLastFrameStart = 0;
+static uint32_t perfActiveFrames = 0;        // frames paced at FRAME_MS (transition running)
+static uint32_t perfIdleFrames = 0;          // idle-rate or wake-up frames
+static int64_t perfFpsWindowStart = 0;
+static uint32_t perfFpsWindowFrames = 0;
+static uint32_t perfFpsX10 = 0;              // achieved frame rate over the last PERF_FPS_WINDOW_MS, x10
+static portMUX_TYPE perfMux = portMUX_INITIALIZER_UNLOCKED;   // stages are recorded from several tasks
+
+static void perfRecord(PerfStage stage, uint32_t us) {
+  portENTER_CRITICAL(&perfMux);
+  PerfRing& r = perfRings[stage];
+  r.samples[r.head] = us;
+  r.head = (r.head + 1) % PERF_RING_SIZE;
+  if (r.count < PERF_RING_SIZE) r.count++;
+  r.total++;
+  portEXIT_CRITICAL(&perfMux);
+}
+
+/**
+ * Note the start of a frame, count missed frame slots and track the achieved frame rate.
+ * A paced frame starting more than half a period late means at least one FRAME_MS slot was skipped;
+ * idle frames are scheduled by events, so their spacing says nothing about missed slots.
+ * @param paced true if the frame was scheduled on the FRAME_MS grid
+ */
+static void perfFrameStart(int64_t now, bool paced) {
+  portENTER_CRITICAL(&perfMux);
+  if (paced && perfLastFrameStart) {
+    const uint32_t interval = (uint32_t)(now - perfLastFrameStart);
+    const uint32_t period = FRAME_MS * 1000UL;
+    if (interval > period + period / 2) perfMissedFrames += (interval + period / 2) / period - 1;
+  }
+  if (paced) perfActiveFrames++;
+  else perfIdleFrames++;
+
+  perfFpsWindowFrames++;
+  const int64_t window = now - perfFpsWindowStart;
+  if (window >= (int64_t)PERF_FPS_WINDOW_MS * 1000) {
+    if (perfFpsWindowStart) perfFpsX10 = (uint32_t)((uint64_t)perfFpsWindowFrames * 10000000ULL / window);
+    perfFpsWindowStart = now;
+    perfFpsWindowFrames = 0;
+  }
+  portEXIT_CRITICAL(&perfMux);
+  perfLastFrameStart = now;
+}
+
+// Records the lifetime of the scope against a stage
+struct PerfScope {
+  PerfStage stage;
+  int64_t t0;
+  explicit PerfScope(PerfStage s) : stage(s), t0(esp_timer_get_time()) {}
+  ~PerfScope() { perfRecord(stage, (uint32_t)(esp_timer_get_time() - t0)); }
+};
+
+/**
+ * Summarise one stage's ring buffer
+ * @param stage Stage to summarise
+ * @return PerfSummary with count = valid samples (all zero when empty)
+ */
+static PerfSummary perfSummarize(PerfStage stage) {
+  uint32_t sorted[PERF_RING_SIZE];   // on the caller's stack: loopTask, HTTP and telemetry tasks all summarise
+  PerfSummary out = {0, 0, 0, 0, 0};
+
+  portENTER_CRITICAL(&perfMux);
+  const PerfRing& r = perfRings[stage];
+  const uint16_t n = r.count;
+  memcpy(sorted, r.samples, n * sizeof(uint32_t));
+  portEXIT_CRITICAL(&perfMux);
+
+  if (n == 0) return out;
+  std::sort(sorted, sorted + n);
+  uint64_t sum = 0;
+  for (uint16_t i = 0; i < n; i++) sum += sorted[i];
+  out.count = n;
+  out.minUs = sorted[0];
+  out.maxUs = sorted[n - 1];
+  out.avgUs = (uint32_t)(sum / n);
+  out.p99Us = sorted[(n * 99) / 100];
+  return out;
+}
+
+static void perfReset() {
+  portENTER_CRITICAL(&perfMux);
+  memset(perfRings, 0, sizeof(perfRings));
+  perfMissedFrames = 0;
+  perfActiveFrames = 0;
+  perfIdleFrames = 0;
+  portEXIT_CRITICAL(&perfMux);
+}
+
+// Periodic one-line-per-stage dump at verbose level (same numbers as /api/perf)
+static void perfLogVerbose() {
+  static uint32_t lastLog = 0;
+  if (debugLevel < DBG_LEVEL_VERBOSE) return;
+  const uint32_t now = millis();
+  if (now - lastLog < PERF_LOG_INTERVAL_MS) return;
+  lastLog = now;
+
+  DBG_VERBOSE("Perf (%s, us min/avg/p99/max, missed=%u, fps=%u.%u):\n", FIRMWARE_VERSION,
+              (unsigned)perfMissedFrames, (unsigned)(perfFpsX10 / 10), (unsigned)(perfFpsX10 % 10));
+  for (uint8_t i = 0; i < PERF_STAGE_COUNT; i++) {
+    const PerfSummary p = perfSummarize((PerfStage)i);
+    if (!p.count) continue;
+    DBG_VERBOSE("  %-16s %6u %6u %6u %6u\n", PERF_STAGE_NAMES[i],
+                (unsigned)p.minUs, (unsigned)p.avgUs, (unsigned)p.p99Us, (unsigned)p.maxUs);
+  }
+}
+
+// =========================
+// Boot timing
+// =========================
+// Milestones in millis() since reset, logged as they happen and kept for /api/perf ("boot"), so a
+// slower boot shows up per phase. Phases come from several tasks (setup, boot, sensor, render).
+struct BootPhase {
+  const char* name;   // static string
+  uint32_t ms;
+};
+static BootPhase bootPhases[BOOT_PHASES_MAX];
+static uint8_t bootPhaseCount = 0;
+static portMUX_TYPE bootMux = portMUX_INITIALIZER_UNLOCKED;
+
+static void bootMark(const char* name) {
+  const uint32_t now = millis();
+  portENTER_CRITICAL(&bootMux);
+  if (bootPhaseCount < BOOT_PHASES_MAX) bootPhases[bootPhaseCount++] = {name, now};
+  portEXIT_CRITICAL(&bootMux);
+  DBG_INFO("[BOOT] %s at %lu ms\n", name, (unsigned long)now);
+}
+
+static uint8_t copyBootPhases(BootPhase* out) {
+  portENTER_CRITICAL(&bootMux);
+  const uint8_t n = bootPhaseCount;
+  memcpy(out, bootPhases, n * sizeof(BootPhase));
+  portEXIT_CRITICAL(&bootMux);
+  return n;
+}
+
 // =========================
 // Global Objects & Application State
 // =========================
@@ -157,18 +369,60 @@ TFT_eSPI tft = TFT_eSPI();
 TFT_eSprite spr = TFT_eSprite(&tft);
 
 WebServer server(HTTP_PORT);
+WebSocketsServer wsMirror(WS_PORT);   // push stream for the web mirror (see Mirror stream section)
 Preferences prefs;
 
-// Sensor objects (only one will be initialized based on configuration)
-#ifdef USE_BME280
-  Adafruit_BME280 bme280;
-#endif
-#ifdef USE_SHT3X
-  Adafruit_SHT31 sht3x = Adafruit_SHT31();
-#endif
-#ifdef USE_HTU21D
-  Adafruit_HTU21DF htu21d = Adafruit_HTU21DF();
-#endif
+// Color palette modes (how LED colors vary across the matrix)
+enum PaletteMode : uint8_t {
+  PALETTE_SOLID = 0,      // every LED uses ledColor
+  PALETTE_GRADIENT_V,     // ledColor (top) -> ledColor2 (bottom), per row band
+  PALETTE_GRADIENT_DIGIT, // ledColor (left digit) -> ledColor2 (right digit), per cell
+  PALETTE_RAINBOW_ROWS,   // hue sweep per row band
+  PALETTE_MODE_COUNT
+};
+
+// LED dot shapes rendered by the dot stamp blitter
+enum LedShape : uint8_t {
+  LED_SHAPE_SQUARE = 0,
+  LED_SHAPE_ROUND,        // hard-edged circle of diameter ledDiameter
+  LED_SHAPE_SOFT,         // circle with an anti-aliased rim
+  LED_SHAPE_COUNT
+};
+
+// Part of the matrix shown on the TFT; the pitch is fitted to that part (see computeViewport())
+enum ViewportMode : uint8_t {
+  VIEWPORT_FULL = 0,      // whole matrix
+  VIEWPORT_CLOCK,         // HH:MM:SS widget
+  VIEWPORT_HHMM,          // hours and minutes only
+  VIEWPORT_DATE,          // date row (whole matrix when the layout has none)
+  VIEWPORT_COUNT
+};
+
+// Where the effective brightness comes from (see dimTarget())
+enum DimMode : uint8_t {
+  DIM_MANUAL = 0,         // cfg.brightness
+  DIM_AUTO,               // between nightBrightness (dark) and brightness (bright room), from the LDR
+  DIM_SCHEDULE,           // nightBrightness between nightStart and nightEnd, else brightness
+  DIM_MODE_COUNT
+};
+
+// Telemetry transport (see telemetryTask())
+enum TelemetryMode : uint8_t {
+  TELEMETRY_OFF = 0,
+  TELEMETRY_UDP,          // one datagram per message
+  TELEMETRY_MQTT,         // QoS 0 PUBLISH on a kept-open connection
+  TELEMETRY_MODE_COUNT
+};
+
+// Digit transition animations
+enum MorphStyle : uint8_t {
+  MORPH_STYLE_PARTICLE = 0,  // lit pixels travel to their nearest partner in the new digit
+  MORPH_STYLE_SPAWN,         // new digit's pixels fly out from the glyph centre
+  MORPH_STYLE_FADE,          // crossfade between old and new digit
+  MORPH_STYLE_SLIDE,         // old digit scrolls up, new one rises from below
+  MORPH_STYLE_SCRAMBLE,      // flickers through random digits before settling
+  MORPH_STYLE_COUNT
+};
 
 struct AppConfig {
   char tz[48]   = DEFAULT_TZ;
@@ -178,32 +432,94 @@ struct AppConfig {
 
   uint8_t ledDiameter = DEFAULT_LED_DIAMETER;
   uint8_t ledGap      = DEFAULT_LED_GAP;
+  uint8_t ledShape    = DEFAULT_LED_SHAPE;  // see LedShape
+  uint8_t fontStyle   = DEFAULT_FONT_STYLE; // see FontStyle (include/fonts.h)
+  uint8_t morphStyle  = DEFAULT_MORPH_STYLE; // see MorphStyle
+  uint8_t viewport    = DEFAULT_VIEWPORT;  // see ViewportMode
 
   // LED color in 24-bit for web + convert to 565 for TFT
   uint32_t ledColor = 0xFF0000; // red
-  uint8_t brightness = 255;     // 0..255
+  uint32_t ledColor2 = 0x0000FF; // gradient end color (palette modes 1 and 2)
+  uint8_t paletteMode = PALETTE_SOLID;  // see PaletteMode
+  uint8_t brightness = 255;     // perceived level 0..255 (day level in auto/schedule modes)
+  uint8_t dimMode = DIM_MANUAL; // see DimMode
+  uint8_t nightBrightness = DEFAULT_NIGHT_BRIGHTNESS;
+  uint8_t nightStart = DEFAULT_NIGHT_START;  // hour, local time
+  uint8_t nightEnd = DEFAULT_NIGHT_END;
+  uint8_t mirrorFps = MIRROR_DEFAULT_FPS;  // WebSocket mirror push rate (1..MIRROR_MAX_FPS)
+
+  // Telemetry push
+  uint8_t telemetryMode = TELEMETRY_OFF;   // see TelemetryMode
+  char telemetryHost[64] = "";             // collector / broker hostname or IP
+  uint16_t telemetryPort = 0;              // 0 = TELEMETRY_UDP_PORT / TELEMETRY_MQTT_PORT
+  uint16_t telemetryInterval = DEFAULT_TELEMETRY_INTERVAL_S;   // seconds between messages
+  char telemetryTopic[48] = DEFAULT_TELEMETRY_TOPIC;           // MQTT topic prefix
 
   bool flipDisplay = false;    // false=rotation 1 (IO ports top, USB left), true=rotation 3 (180° flip)
 
+  // Power
+  bool powerSave = DEFAULT_POWER_SAVE;     // lower CPU clock, blocking loop / network polls
+  bool nightBlank = DEFAULT_NIGHT_BLANK;   // display off between nightStart and nightEnd
+
   // Sensor settings
   bool useFahrenheit = false;   // false=Celsius, true=Fahrenheit
 };
 
 AppConfig cfg;
 
+// cfg is written by the HTTP task (handlePostConfig) and read as a whole by loopTask (NVS writes, state
+// JSON). Those take cfgMutex; the render task only reads single fields, where a stale value is harmless.
+static SemaphoreHandle_t cfgMutex = nullptr;
+struct CfgLock {
+  CfgLock() { if (cfgMutex) xSemaphoreTakeRecursive(cfgMutex, portMAX_DELAY); }
+  ~CfgLock() { if (cfgMutex) xSemaphoreGiveRecursive(cfgMutex); }
+};
+static std::atomic<bool> ntpRestartPending{false};  // tz/ntp changed; loopTask re-runs startNtp()
+static std::atomic<bool> ntpStarted{false};         // SNTP configured (first GOT_IP requests it)
+static std::atomic<bool> telemetryReconfig{false};  // telemetry target changed; its task reconnects
+
 // Sensor state variables
-bool sensorAvailable = false;
+std::atomic<bool> sensorAvailable{false};   // set by the sensor task once the probe finishes
 int temperature = 0;
 int humidity = 0;
 int pressure = 0;
 const char* sensorType = "NONE";  // Will be set based on detected sensor
 unsigned long lastSensorUpdate = 0;
 
-// Logical RGB LED Matrix (HUB75) framebuffer: 0..255 intensity
-static uint8_t fb[LED_MATRIX_H][LED_MATRIX_W];
+// WiFi SSID/IP as text, refreshed only on WiFi events (onWifiEvent()) so periodic readers build no Strings
+static char netSsid[33] = "DISCONNECTED";
+static char netIp[16] = "0.0.0.0";
+static bool netUp = false;
+static portMUX_TYPE netMux = portMUX_INITIALIZER_UNLOCKED;
+
+/**
+ * Copy the cached network strings (safe from any task)
+ * @return true while the station is connected
+ */
+static bool netInfo(char* ssid, size_t ssidLen, char* ip, size_t ipLen) {
+  portENTER_CRITICAL(&netMux);
+  if (ssid) strlcpy(ssid, netSsid, ssidLen);
+  if (ip) strlcpy(ip, netIp, ipLen);
+  const bool up = netUp;
+  portEXIT_CRITICAL(&netMux);
+  return up;
+}
 
-// Cached date string for status bar
-static char currDate[11] = "----/--/--";
+// Logical RGB LED Matrix (HUB75) framebuffer: 0..255 intensity.
+// Triple-buffered between the render task (single producer) and the web side (single consumer):
+// fb always points at the producer's private slot; publishFrame() hands it over lock-free.
+static FbRow fbSlots[3][LED_MATRIX_H];
+static FbRow* fb = fbSlots[0];
+static uint8_t fbWriteIdx = 0;                      // producer-owned slot
+static uint8_t fbReadIdx = 1;                       // consumer-owned slot
+static std::atomic<uint8_t> fbSharedIdx{2};         // hand-over slot (+ FB_SLOT_FRESH when unread)
+static const uint8_t FB_SLOT_FRESH = 0x80;
+static const uint8_t FB_SLOT_MASK = 0x03;
+static const size_t FB_BYTES = sizeof(fbSlots[0]);
+
+// Clock/date state written by updateClockLogic() (loop) and read by the render task under clockMux
+static portMUX_TYPE clockMux = portMUX_INITIALIZER_UNLOCKED;
+static char currDate[16] = "----/--/--";   // formatted date (status bar and date row); "Mon DD, YYYY" needs 13
 static uint8_t appliedDot = 0;
 static uint8_t appliedGap = 0;
 static uint8_t appliedPitch = 0;
@@ -212,33 +528,139 @@ static uint8_t appliedPitch = 0;
 static int fbPitch = 2;      // logical LED -> TFT pixels (computed from TFT size + config)
 static bool useSprite = false;
 
+// Dirty-rectangle tracking: copy of fb as last pushed to the TFT.
+// Cleared validity forces the next frame to be a full redraw.
+static FbRow fbShown[LED_MATRIX_H];
+static bool fbShownValid = false;
+
+// Work posted to the render task from other tasks (it owns the TFT, sprite and palette)
+enum RenderRequest : uint32_t {
+  RENDER_REQ_FULL     = 1 << 0,   // repaint the whole matrix
+  RENDER_REQ_PALETTE  = 1 << 1,   // rebuild palette LUTs
+  RENDER_REQ_PITCH    = 1 << 2,   // recompute pitch / rebuild sprite
+  RENDER_REQ_ROTATION = 1 << 3,   // apply cfg.flipDisplay and clear the screen
+};
+static std::atomic<uint32_t> renderRequests{RENDER_REQ_FULL | RENDER_REQ_PALETTE};
+static TaskHandle_t renderTaskHandle = nullptr;
+static std::atomic<bool> renderWakePending{false};   // loop() fallback: render on the next pass
+
+// Render the next frame now instead of at the idle rate (digit change, config change, posted request)
+static void wakeRenderer() {
+  renderWakePending.store(true, std::memory_order_release);
+  if (renderTaskHandle) xTaskNotifyGive(renderTaskHandle);
+}
+
+static void postRenderRequest(uint32_t bits) {
+  renderRequests.fetch_or(bits, std::memory_order_release);
+  wakeRenderer();
+}
+
+// Column boundaries of the dirty-tracking cells (one per digit/colon, set by the clock layout).
+// Cell i covers columns [dirtyCellX[i], dirtyCellX[i+1]).
+#define MAX_DIRTY_CELLS 16
+static uint16_t dirtyCellX[MAX_DIRTY_CELLS + 1];
+static uint8_t dirtyCellCount = 0;
+// Cells drawFrame() changed since the renderer last diffed them (bit i = cell i); render task only
+static uint32_t sceneDirtyCells = 0xFFFFFFFFu;
+static_assert(MAX_DIRTY_CELLS <= 32, "sceneDirtyCells holds one bit per cell");
+static uint32_t sceneRebuilds = 0;     // lifetime full scene recompositions (/api/perf)
+static uint32_t sceneItemDraws = 0;    // lifetime digit / date redraws (/api/perf)
+
+// Palette LUT: intensity (0..255) -> RGB565 per color band.
+// rowBand/colBand select the band for each LED; only one of them is non-zero for a given mode.
+static uint16_t paletteLut[PALETTE_BANDS][256];
+static uint32_t paletteBase[PALETTE_BANDS];   // full-intensity 24-bit color of each band
+static uint8_t rowBand[LED_MATRIX_H];
+static uint8_t colBand[LED_MATRIX_W];
+static bool paletteValid = false;     // render task only; others call invalidatePalette()
+static uint32_t paletteGen = 0;       // bumped on every rebuild so backends can tell the palette changed
+static std::atomic<uint8_t> paletteLevel{255};   // brightness folded into paletteLut (below the backlight floor)
+static std::atomic<uint8_t> displayLevel{255};   // effective perceived brightness (after auto-dim / schedule)
+static std::atomic<int16_t> ambientRaw{-1};       // averaged LDR reading, -1 = none yet
+static std::atomic<int16_t> ambientLevel{-1};     // 0 = dark .. 255 = bright
+static std::atomic<bool> dimApplyNow{true};       // settings changed: jump to the target instead of fading
+static std::atomic<bool> displayBlank{false};     // night blank in effect (loop() decides, see powerTick())
+static std::atomic<bool> panelAsleep{false};      // TFT asleep or not redrawn since (render task), backlight must stay off
+static std::atomic<uint8_t> backlightDuty{0};     // last PWM duty written (current estimate)
+
+static void powerWake();  // Power section
+
+// Poll interval for the network tasks: longer in power save so the WiFi core can idle between passes
+static uint32_t powerPollMs(uint32_t ms) {
+  return cfg.powerSave ? max<uint32_t>(ms, POWER_SAVE_POLL_MS) : ms;
+}
+
 // =========================
 // RGB LED Status Functions
 // =========================
 
+// Flashes end on an esp_timer, so the boot path never waits for the LED
+static esp_timer_handle_t ledFlashTimer = nullptr;
+static std::atomic<uint8_t> ledSteady{0};   // colour from setRGBLed(): bit 0 red, 1 green, 2 blue
+
+static uint8_t rgbBits(bool red, bool green, bool blue) {
+  return (red ? 1 : 0) | (green ? 2 : 0) | (blue ? 4 : 0);
+}
+
+// Drive the pins (CYD RGB LEDs are active LOW)
+static void writeRGBLed(uint8_t rgb) {
+#ifdef HUB75_ENABLE
+  // The default HUB75 pins reuse the RGB LED lines (config.h)
+  (void)rgb;
+#else
+  digitalWrite(LED_R_PIN, (rgb & 1) ? LOW : HIGH);
+  digitalWrite(LED_G_PIN, (rgb & 2) ? LOW : HIGH);
+  digitalWrite(LED_B_PIN, (rgb & 4) ? LOW : HIGH);
+#endif
+}
+
 /**
- * Set RGB LED state (CYD RGB LEDs are active LOW)
+ * Set the steady RGB LED state (ends a flash in progress)
  * @param red Red LED state (true = ON)
  * @param green Green LED state (true = ON)
  * @param blue Blue LED state (true = ON)
  */
 static void setRGBLed(bool red, bool green, bool blue) {
-  digitalWrite(LED_R_PIN, red ? LOW : HIGH);
-  digitalWrite(LED_G_PIN, green ? LOW : HIGH);
-  digitalWrite(LED_B_PIN, blue ? LOW : HIGH);
+  const uint8_t rgb = rgbBits(red, green, blue);
+  ledSteady.store(rgb);
+  if (ledFlashTimer) esp_timer_stop(ledFlashTimer);
+  writeRGBLed(rgb);
 }
 
+static void onLedFlashEnd(void*) { writeRGBLed(ledSteady.load()); }
+
 /**
- * Flash RGB LED with specified color
+ * Flash RGB LED with specified color, then return to the steady state; returns immediately
  * @param r Red state (0 or 1)
  * @param g Green state (0 or 1)
  * @param b Blue state (0 or 1)
  * @param delayMs Flash duration in milliseconds
  */
 static void flashRGBLed(int r, int g, int b, int delayMs = 200) {
-  setRGBLed(r, g, b);
-  delay(delayMs);
-  setRGBLed(false, false, false);
+  writeRGBLed(rgbBits(r, g, b));
+  if (!ledFlashTimer) {
+    delay(delayMs);
+    onLedFlashEnd(nullptr);
+    return;
+  }
+  esp_timer_stop(ledFlashTimer);   // a new flash restarts the timer
+  esp_timer_start_once(ledFlashTimer, (uint64_t)delayMs * 1000);
+}
+
+static void initRGBLed() {
+#ifndef HUB75_ENABLE
+  pinMode(LED_R_PIN, OUTPUT);
+  pinMode(LED_G_PIN, OUTPUT);
+  pinMode(LED_B_PIN, OUTPUT);
+#endif
+  esp_timer_create_args_t args = {};
+  args.callback = onLedFlashEnd;
+  args.name = "ledFlash";
+  if (esp_timer_create(&args, &ledFlashTimer) != ESP_OK) {
+    ledFlashTimer = nullptr;
+    DBG_WARN("LED flash timer create failed, flashes will block\n");
+  }
+  setRGBLed(false, false, false);  // All off initially
 }
 
 // =========================
@@ -261,7 +683,37 @@ static uint16_t rgb888_to_565(uint32_t rgb) {
  * Clear the entire framebuffer to a specific intensity value
  * @param v Intensity value (0-255), default 0 (off)
  */
-static void fbClear(uint8_t v = 0) { memset(fb, v, sizeof(fb)); }
+static void fbClear(uint8_t v = 0) {
+  for (int y = 0; y < LED_MATRIX_H; y++) fbFillRow(fb[y], v);
+}
+
+/**
+ * Publish the finished frame in fb to the consumer and take a free slot to draw the next one.
+ * Producer side of the lock-free triple buffer (render task only).
+ */
+static void publishFrame() {
+  uint8_t prev = fbSharedIdx.exchange(fbWriteIdx | FB_SLOT_FRESH, std::memory_order_acq_rel);
+  fbWriteIdx = prev & FB_SLOT_MASK;
+  fb = fbSlots[fbWriteIdx];
+}
+
+/**
+ * Latest published frame for the consumer (web handlers, all on one task), one intensity byte per
+ * LED whatever FB_BPP is. The returned buffer stays valid and unchanged until the next call.
+ */
+static const uint8_t* latestFrame() {
+  if (fbSharedIdx.load(std::memory_order_acquire) & FB_SLOT_FRESH) {
+    uint8_t prev = fbSharedIdx.exchange(fbReadIdx, std::memory_order_acq_rel);
+    fbReadIdx = prev & FB_SLOT_MASK;
+  }
+#if FB_BPP == 8
+  return &fbSlots[fbReadIdx][0][0];
+#else
+  static uint8_t bytes[LED_MATRIX_H][LED_MATRIX_W];
+  for (int y = 0; y < LED_MATRIX_H; y++) fbRowBytes(fbSlots[fbReadIdx][y], bytes[y]);
+  return &bytes[0][0];
+#endif
+}
 
 /**
  * Set a single pixel in the framebuffer with bounds checking
@@ -271,217 +723,180 @@ static void fbClear(uint8_t v = 0) { memset(fb, v, sizeof(fb)); }
  */
 static inline void fbSet(int x, int y, uint8_t v) {
   if (x < 0 || y < 0 || x >= LED_MATRIX_W || y >= LED_MATRIX_H) return;
-  fb[y][x] = v;
+  fbPutPx(fb[y], x, v);
+}
+
+/**
+ * Write intensity v at the set bits of one glyph row (bit 31 = x0), clipped like fbSet()
+ * Word-wide in every FB_BPP format, so a digit costs its rows instead of its pixels.
+ */
+static inline void fbSetBits(int x0, int y, uint32_t bits, uint8_t v) {
+  if (y < 0 || y >= LED_MATRIX_H) return;
+  fbPutBits(fb[y], bits, x0, v);
 }
 
 // =========================
-// 7-Segment Digit Bitmaps & Layout Constants
+// Clock Fonts & Layout Constants
 // =========================
-static const int DIGIT_W = 9;       // Width of each digit in pixels (9px fits HH:MM:SS with gaps in 64px)
-static const int DIGIT_H = LED_MATRIX_H;  // Height matches full matrix height (32px)
-static const int COLON_W = 2;       // Width of colon separator
-static const int DIGIT_GAP = 1;     // 1px gap between digits for improved readability
-
-struct Bitmap {
-  uint16_t rows[DIGIT_H];  // each row is 16 bits, MSB left
-};
-
-static Bitmap DIGITS[10];  // Array of digit bitmaps (0-9)
-static Bitmap COLON;       // Colon separator bitmap
-
-/**
- * Generate a 7-segment style digit bitmap
- * Segments are labeled a-g in standard 7-segment notation:
- *     aaa
- *    f   b
- *     ggg
- *    e   c
- *     ddd
- * @param d Digit value (0-9)
- * @return Bitmap structure containing the rendered digit
- */
-static Bitmap makeDigit7Seg(uint8_t d) {
-  bool seg[7] = {0};
-  switch (d) {
-    case 0: seg[0]=seg[1]=seg[2]=seg[3]=seg[4]=seg[5]=1; break;
-    case 1: seg[1]=seg[2]=1; break;
-    case 2: seg[0]=seg[1]=seg[6]=seg[4]=seg[3]=1; break;
-    case 3: seg[0]=seg[1]=seg[6]=seg[2]=seg[3]=1; break;
-    case 4: seg[5]=seg[6]=seg[1]=seg[2]=1; break;
-    case 5: seg[0]=seg[5]=seg[6]=seg[2]=seg[3]=1; break;
-    case 6: seg[0]=seg[5]=seg[6]=seg[4]=seg[2]=seg[3]=1; break;
-    case 7: seg[0]=seg[1]=seg[2]=1; break;
-    case 8: seg[0]=seg[1]=seg[2]=seg[3]=seg[4]=seg[5]=seg[6]=1; break;
-    case 9: seg[0]=seg[1]=seg[2]=seg[3]=seg[5]=seg[6]=1; break;
-    default: break;
-  }
-
-  Bitmap bm{};
-  for (int y=0; y<DIGIT_H; y++) bm.rows[y]=0;
+// Glyph tables are generated at compile time into flash (include/fonts.h); cfg.fontStyle picks one.
+static const int DIGIT_GAP = FONT_GAP;  // 1px gap between digits for improved readability
 
-  auto setPx = [&](int x, int y){
-    if (x<0||y<0||x>=DIGIT_W||y>=DIGIT_H) return;
-    bm.rows[y] |= (1u << (15-x));
-  };
+// Font currently selected in the config (falls back to 7-segment on out-of-range values)
+static const FontDesc& activeFont() {
+  return FONTS[cfg.fontStyle < FONT_STYLE_COUNT ? cfg.fontStyle : 0];
+}
 
-  const int padX = 0;
-  const int padY = 1;
-  const int th = 4;
-  const int w = DIGIT_W;
-  const int h = DIGIT_H;
-  const int midY = h/2;
+// =========================
+// Layout
+// =========================
+// Widgets are placed from the matrix geometry and the font, so chained panels (128x32, 128x64) need
+// no layout code of their own: the clock is centred horizontally, and matrices with at least
+// FONT_DATE_MIN_ROWS left below the font get a date row there.
+
+// LED-space rectangle [x, x+w) x [y, y+h)
+struct LayoutBox { int16_t x, y, w, h; };
+
+struct ClockLayout {
+  LayoutBox clock;   // HH:MM:SS
+  LayoutBox hhmm;    // hours and minutes part of clock
+  LayoutBox date;    // date row, h == 0 when the matrix has no room for it
+  int cellX[8];      // left edge of each element: H H : M M : S S
+  int y0;            // top of the HH:MM digits and colons
+  int secY0;         // top of the seconds digits (they share the HH:MM baseline)
+};
 
-  if (seg[0]) for(int y=padY; y<padY+th; y++) for(int x=padX; x<w-padX; x++) setPx(x,y);            // a
-  if (seg[3]) for(int y=h-padY-th; y<h-padY; y++) for(int x=padX; x<w-padX; x++) setPx(x,y);          // d
-  if (seg[6]) for(int y=midY - th/2; y<midY - th/2 + th; y++) for(int x=padX; x<w-padX; x++) setPx(x,y); // g
+static ClockLayout computeLayout(const FontDesc& font) {
+  ClockLayout L{};
+  const int digitW = font.w;
+  const int secW = font.secW;
+  const int colonW = font.colonW;
+  const int gap = DIGIT_GAP;
 
-  if (seg[5]) for(int x=padX; x<padX+th; x++) for(int y=padY; y<midY; y++) setPx(x,y);               // f
-  if (seg[1]) for(int x=w-padX-th; x<w-padX; x++) for(int y=padY; y<midY; y++) setPx(x,y);           // b
-  if (seg[4]) for(int x=padX; x<padX+th; x++) for(int y=midY; y<h-padY; y++) setPx(x,y);             // e
-  if (seg[2]) for(int x=w-padX-th; x<w-padX; x++) for(int y=midY; y<h-padY; y++) setPx(x,y);         // c
+  // 6 digits + 2 colons, with a gap after each digit except the last of each pair
+  const int totalW = (4 * digitW) + (2 * secW) + (2 * colonW) + (5 * gap);
+  int x0 = (LED_MATRIX_W - totalW) / 2;
+  if (x0 < 0) x0 = 0;
 
-  return bm;
+  const int spare = LED_MATRIX_H - font.h;
+  const bool hasDate = spare >= FONT_DATE_MIN_ROWS;
+  L.y0 = hasDate ? 0 : spare / 2;
+  L.secY0 = L.y0 + font.h - font.secH;
+
+  L.cellX[0] = x0;
+  L.cellX[1] = x0 + digitW + gap;
+  L.cellX[2] = x0 + 2*digitW + gap;
+  L.cellX[3] = x0 + 2*digitW + gap + colonW + gap;
+  L.cellX[4] = x0 + 3*digitW + 2*gap + colonW + gap;
+  L.cellX[5] = x0 + 4*digitW + 2*gap + colonW + gap;
+  L.cellX[6] = x0 + 4*digitW + 2*gap + 2*colonW + 2*gap;
+  L.cellX[7] = x0 + 4*digitW + secW + 3*gap + 2*colonW + 2*gap;
+
+  const int clockW = min(totalW, LED_MATRIX_W - x0);
+  L.clock = LayoutBox{(int16_t)x0, (int16_t)L.y0, (int16_t)clockW, (int16_t)font.h};
+  L.hhmm = LayoutBox{(int16_t)x0, (int16_t)L.y0, (int16_t)(L.cellX[4] + digitW - x0), (int16_t)font.h};
+  if (hasDate) L.date = LayoutBox{0, (int16_t)font.h, LED_MATRIX_W, (int16_t)spare};
+  return L;
 }
 
 /**
- * Initialize all digit and colon bitmaps
- * Called once during setup to pre-render all characters
+ * Part of the matrix the TFT shows for cfg.viewport (the whole matrix by default).
+ * Zooming to a widget lets a large logical matrix use a readable pitch instead of 1-2 px dots.
  */
-static void initBitmaps() {
-  DBG_STEP("Building digit bitmaps...");
-  for (int i=0;i<10;i++) DIGITS[i] = makeDigit7Seg(i);
-
-  for (int y=0;y<DIGIT_H;y++) COLON.rows[y]=0;
-  auto setPx = [&](int x, int y){
-    if (x<0||y<0||x>=COLON_W||y>=DIGIT_H) return;
-    COLON.rows[y] |= (1u << (15-x));
-  };
-  for(int yy=10; yy<13; yy++) for(int xx=0; xx<COLON_W; xx++) setPx(xx,yy);
-  for(int yy=19; yy<22; yy++) for(int xx=0; xx<COLON_W; xx++) setPx(xx,yy);
-
-  DBG_OK("Digit bitmaps ready.");
-}
-
-// Morph between two bitmaps into fb, step=0..MORPH_STEPS
-static void drawMorph(const Bitmap& a, const Bitmap& b, int step, int x0, int y0, int w) {
-  for (int y=0; y<DIGIT_H; y++) {
-    for (int x=0; x<w; x++) {
-      bool aon = (a.rows[y] >> (15-x)) & 0x1;
-      bool bon = (b.rows[y] >> (15-x)) & 0x1;
-
-      uint8_t val = 0;
-      if (aon && bon) val = 255;
-      else if (aon && !bon) val = (uint8_t)(255 * (MORPH_STEPS - step) / MORPH_STEPS);
-      else if (!aon && bon) val = (uint8_t)(255 * step / MORPH_STEPS);
-
-      if (val == 0) continue;
-
-      int yScaled = (y * LED_MATRIX_H) / DIGIT_H;
-      fbSet(x0 + x, y0 + yScaled, val);
-    }
+static LayoutBox computeViewport(const ClockLayout& L) {
+  LayoutBox v{0, 0, LED_MATRIX_W, LED_MATRIX_H};
+  switch (cfg.viewport) {
+    case VIEWPORT_CLOCK: v = L.clock; break;
+    case VIEWPORT_HHMM:  v = L.hhmm; break;
+    case VIEWPORT_DATE:  if (L.date.h > 0) v = L.date; break;
+    default: break;
   }
+  return v;
 }
 
-struct Pt { int8_t x, y; };
+// =========================
+// Particle Morph Tables
+// =========================
+// Point lists and pair matching live in include/morph.h. Pairs of the active font are matched at boot,
+// or on first use after a font change. Only the render task touches these after setup().
+static MorphSet morphBig{};   // HH:MM digits (and seconds when the font has no separate seconds glyphs)
+static MorphSet morphSec{};   // seconds digits of fonts with their own seconds glyphs
 
-static int buildPixelsFromBitmap(const Bitmap& bm, int w, Pt* out, int maxOut) {
-  int n = 0;
-  for (int y = 0; y < DIGIT_H; y++) {
-    uint16_t row = bm.rows[y];
-    for (int x = 0; x < w; x++) {
-      bool on = (row >> (15 - x)) & 0x1;
-      if (!on) continue;
-      if (n < maxOut) out[n] = Pt{(int8_t)x, (int8_t)y};
-      n++;
-    }
+/**
+ * Allocate the morph tables once, sized for the largest font (never freed, so no fragmentation).
+ * Call after the sprite is created; on failure particle morphs fall back to the spawn morph.
+ */
+static void initMorphTables() {
+  const size_t bigBytes = (size_t)FONT_MAX_SET_PIXELS * (sizeof(Pt) + 10 * sizeof(MorphIdx));
+  const size_t secBytes = (size_t)FONT_MAX_SEC_SET_PIXELS * (sizeof(Pt) + 10 * sizeof(MorphIdx));
+  uint8_t* pool = (uint8_t*)heap_caps_malloc(bigBytes + secBytes, MALLOC_CAP_8BIT);
+  if (!pool) {
+    DBG_WARN("Morph tables: %u bytes unavailable, using spawn morph\n", (unsigned)(bigBytes + secBytes));
+    return;
   }
-  return n;
-}
-
-static inline int dist2(const Pt& a, const Pt& b) {
-  int dx = (int)a.x - (int)b.x;
-  int dy = (int)a.y - (int)b.y;
-  return dx*dx + dy*dy;
+  auto carve = [&](MorphSet& set, int cap) {
+    set.pts = (Pt*)pool;
+    pool += cap * sizeof(Pt);
+    set.order = (MorphIdx*)pool;
+    pool += (size_t)cap * 10 * sizeof(MorphIdx);
+    set.capPts = cap;
+  };
+  carve(morphBig, FONT_MAX_SET_PIXELS);
+  carve(morphSec, FONT_MAX_SEC_SET_PIXELS);
+  DBG_VERBOSE("Morph tables: %u bytes\n", (unsigned)(bigBytes + secBytes));
 }
 
-// Particle morph between two bitmaps into fb, step=0..MORPH_STEPS
-static void drawParticleMorph(const Bitmap& fromBm,
-                              const Bitmap& toBm,
-                              int step, int x0, int y0,
-                              int w)
-{
-  // Worst case: almost full 16x24 = 384 pixels.
-  // Our 7-seg glyphs are much smaller, but allocate safely.
-  static Pt fromPts[420];
-  static Pt toPts[420];
-  static int matchTo[420];
-  static bool toUsed[420];
-
-  int fromN = buildPixelsFromBitmap(fromBm, w, fromPts, 420);
-  int toN   = buildPixelsFromBitmap(toBm,   w, toPts,   420);
-
-  // Clamp counts to our buffers
-  if (fromN > 420) fromN = 420;
-  if (toN > 420) toN = 420;
-
-  // Greedy nearest-neighbour matching (good enough for small glyphs)
-  for (int j=0; j<toN; j++) toUsed[j] = false;
-
-  int pairs = min(fromN, toN);
-  for (int i=0; i<pairs; i++) {
-    int bestJ = -1;
-    int bestD = 1e9;
-    for (int j=0; j<toN; j++) {
-      if (toUsed[j]) continue;
-      int d = dist2(fromPts[i], toPts[j]);
-      if (d < bestD) { bestD = d; bestJ = j; }
+/**
+ * Match all 100 digit pairs of the active font up front (boot), so no transition pays for it later
+ * (avoids a spike at midnight when all six digits change)
+ */
+static void precomputeMorphTables() {
+  const FontDesc& font = activeFont();
+  const uint32_t t0 = millis();
+  MorphSet* sets[2] = {&morphBig, font.secRows != font.digitRows ? &morphSec : nullptr};
+  const GlyphRef firsts[2] = {font.digit(0), font.secDigit(0)};
+  for (int s = 0; s < 2; s++) {
+    if (!sets[s] || !morphBind(*sets[s], firsts[s])) continue;
+    for (int a = 0; a < 10; a++) {
+      for (int b = 0; b < 10; b++) morphPair(*sets[s], a, b);
     }
-    if (bestJ < 0) bestJ = 0;
-    matchTo[i] = bestJ;
-    toUsed[bestJ] = true;
   }
+  DBG_INFO("Morph tables: %u pairs in %lu ms\n", (unsigned)(morphBig.pairsBuilt + morphSec.pairsBuilt), (unsigned long)(millis() - t0));
+}
 
-  // Interp factor 0..1
-  float t = (float)step / (float)MORPH_STEPS;
-
-  // 1) Move matched particles
-  for (int i=0; i<pairs; i++) {
-    Pt a = fromPts[i];
-    Pt b = toPts[matchTo[i]];
-
-    float xf = a.x + (b.x - a.x) * t;
-    float yf = a.y + (b.y - a.y) * t;
-
-    int x = (int)lroundf(xf);
-    int y = (int)lroundf(yf);
-
-    int yScaled = (y * LED_MATRIX_H) / DIGIT_H;
-
-    // Full intensity (motion provides the morph effect)
-    fbSet(x0 + x, y0 + yScaled, 255);
+/**
+ * Particle morph between two digits of a bound set into fb
+ * Matched particles travel in straight lines; surplus ones fade in or out.
+ * @param pos8 Travelled fraction, Q8.8 (256 = arrived; may overshoot)
+ * @param alphaIn Intensity of fading-in pixels (fading-out ones get 255 - alphaIn)
+ */
+static void drawParticleMorph(MorphSet& set, int from, int to, int pos8, uint8_t alphaIn, int x0, int y0) {
+  const MorphIdx* order = morphPair(set, from, to);
+  const Pt* fromPts = set.pts + set.ptOff[from];
+  const Pt* toPts = set.pts + set.ptOff[to];
+  const int fromN = set.ptN[from];
+  const int toN = set.ptN[to];
+  const int pairs = min(fromN, toN);
+
+  // 1) Move matched particles (full intensity: motion provides the morph effect)
+  for (int i = 0; i < pairs; i++) {
+    const Pt a = fromPts[i];
+    const Pt b = toPts[order[i]];
+    const int x = a.x + (((b.x - a.x) * pos8 + 128) >> 8);
+    const int y = a.y + (((b.y - a.y) * pos8 + 128) >> 8);
+    fbSet(x0 + x, y0 + y, 255);
   }
 
   // 2) Pixels that exist only in TO: fade in
-  if (toN > fromN) {
-    int extra = toN - fromN;
-    float alpha = t; // 0->1
-    for (int j=0; j<toN && extra>0; j++) {
-      if (toUsed[j]) continue;
-      Pt p = toPts[j];
-      int yScaled = (p.y * LED_MATRIX_H) / DIGIT_H;
-      fbSet(x0 + p.x, y0 + yScaled, (uint8_t)(255 * alpha));
-      extra--;
-    }
+  for (int k = pairs; k < toN; k++) {
+    const Pt p = toPts[order[k]];
+    fbSet(x0 + p.x, y0 + p.y, alphaIn);
   }
 
   // 3) Pixels that exist only in FROM: fade out
-  if (fromN > toN) {
-    float alpha = 1.0f - t; // 1->0
-    for (int i=toN; i<fromN; i++) {
-      Pt p = fromPts[i];
-      int yScaled = (p.y * LED_MATRIX_H) / DIGIT_H;
-      fbSet(x0 + p.x, y0 + yScaled, (uint8_t)(255 * alpha));
-    }
+  const uint8_t alphaOut = (uint8_t)(255 - alphaIn);
+  for (int i = pairs; i < fromN; i++) {
+    const Pt p = fromPts[i];
+    fbSet(x0 + p.x, y0 + p.y, alphaOut);
   }
 }
 
@@ -501,20 +916,134 @@ static void setBacklight(uint8_t b) {
 #else
   (void)b;
 #endif
+  backlightDuty.store(b, std::memory_order_relaxed);
+}
+
+// =========================
+// Palette (intensity -> RGB565 lookup tables)
+// =========================
+
+/**
+ * Linear blend between two 24-bit colors
+ * @param t Position 0..255 (0 = a, 255 = b)
+ */
+static uint32_t lerpColor(uint32_t a, uint32_t b, uint8_t t) {
+  uint32_t out = 0;
+  for (int shift = 0; shift <= 16; shift += 8) {
+    int ca = (a >> shift) & 0xFF;
+    int cb = (b >> shift) & 0xFF;
+    out |= (uint32_t)(ca + ((cb - ca) * t) / 255) << shift;
+  }
+  return out;
+}
+
+/**
+ * Convert a hue (0..1535, six 256-step sectors) at full saturation to 24-bit RGB
+ * @param value Peak channel value (0-255)
+ */
+static uint32_t hueToColor(uint16_t hue, uint8_t value) {
+  uint8_t sector = (hue >> 8) % 6;
+  uint8_t frac = hue & 0xFF;
+  uint8_t up = (uint8_t)((value * frac) / 255);
+  uint8_t down = (uint8_t)(value - up);
+  uint8_t r = 0, g = 0, b = 0;
+  switch (sector) {
+    case 0: r = value; g = up; break;
+    case 1: r = down; g = value; break;
+    case 2: g = value; b = up; break;
+    case 3: g = down; b = value; break;
+    case 4: r = up; b = value; break;
+    default: r = value; b = down; break;
+  }
+  return ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+}
+
+/**
+ * Fill one palette band with base color scaled by every intensity level and paletteLevel.
+ * Scaling is linear: the TFT applies its own gamma to the pixel values, so intensities already
+ * look perceptual and dimming below the backlight floor costs nothing extra per pixel.
+ */
+static void buildPaletteBand(uint8_t band, uint32_t base) {
+  const uint8_t baseR = (base >> 16) & 0xFF;
+  const uint8_t baseG = (base >> 8)  & 0xFF;
+  const uint8_t baseB = (base >> 0)  & 0xFF;
+  const uint32_t level = paletteLevel.load(std::memory_order_relaxed);
+
+  paletteBase[band] = base;
+  for (int v = 0; v < 256; v++) {
+    const uint16_t drive = (uint16_t)((v * level + 127) / 255);
+    uint8_t r = (uint8_t)((baseR * drive) / 255);
+    uint8_t g = (uint8_t)((baseG * drive) / 255);
+    uint8_t b = (uint8_t)((baseB * drive) / 255);
+    paletteLut[band][v] = rgb888_to_565(((uint32_t)r << 16) | ((uint32_t)g << 8) | b);
+  }
+}
+
+/**
+ * Rebuild band maps and lookup tables from cfg.paletteMode / ledColor / ledColor2.
+ * Runs only when colors, mode or the cell layout change (paletteValid == false).
+ */
+static void rebuildPalette() {
+  memset(rowBand, 0, sizeof(rowBand));
+  memset(colBand, 0, sizeof(colBand));
+
+  uint8_t bands = 1;
+  switch (cfg.paletteMode) {
+    case PALETTE_GRADIENT_V:
+    case PALETTE_RAINBOW_ROWS:
+      bands = PALETTE_BANDS;
+      for (int y = 0; y < LED_MATRIX_H; y++) rowBand[y] = (uint8_t)((y * bands) / LED_MATRIX_H);
+      break;
+
+    case PALETTE_GRADIENT_DIGIT:
+      bands = dirtyCellCount > 0 ? min<int>(dirtyCellCount, PALETTE_BANDS) : 1;
+      for (int i = 0; i < dirtyCellCount; i++) {
+        uint8_t band = (uint8_t)min(i, bands - 1);
+        for (int x = dirtyCellX[i]; x < dirtyCellX[i + 1]; x++) colBand[x] = band;
+      }
+      break;
+
+    default:
+      break;
+  }
+
+  for (uint8_t band = 0; band < bands; band++) {
+    uint8_t t = bands > 1 ? (uint8_t)((band * 255) / (bands - 1)) : 0;
+    uint32_t base;
+    if (cfg.paletteMode == PALETTE_RAINBOW_ROWS) {
+      base = hueToColor((uint16_t)((band * 1280) / bands), 255);
+    } else if (cfg.paletteMode == PALETTE_SOLID) {
+      base = cfg.ledColor;
+    } else {
+      base = lerpColor(cfg.ledColor, cfg.ledColor2, t);
+    }
+    buildPaletteBand(band, base);
+  }
+  for (uint8_t band = bands; band < PALETTE_BANDS; band++) buildPaletteBand(band, paletteBase[bands - 1]);
+
+  paletteValid = true;
+  paletteGen++;
+  DBG_VERBOSE("Palette rebuilt: mode=%u bands=%u\n", cfg.paletteMode, bands);
 }
 
+// Mark the palette stale (color/mode/layout change); rebuilt before the next render
+static void invalidatePalette() { postRenderRequest(RENDER_REQ_PALETTE); }
+
 // =========================
 // Flicker-free renderer using SMALL sprite (with intensity)
 // =========================
+// Matrix region shown on the TFT (render task only; set by updateRenderPitch())
+static LayoutBox renderView{0, 0, LED_MATRIX_W, LED_MATRIX_H};
+
 static int computeRenderPitch() {
   int matrixAreaH = tft.height() - STATUS_BAR_H;
   if (matrixAreaH < 1) matrixAreaH = tft.height();
 
-  // With CYD 320x240 landscape:
+  // With CYD 320x240 landscape and the whole 64x32 matrix in view:
   // pitch = min(320/64, matrixAreaH/32) = min(5, matrixAreaH/32)
   // Maximum pitch is 5 (limited by width), giving 320×160 display
-  // Use min to ensure it fits in both dimensions
-  int maxPitch = min(tft.width() / LED_MATRIX_W, matrixAreaH / LED_MATRIX_H);
+  // Use min to ensure it fits in both dimensions; a 128x64 matrix gets 2, or more when zoomed
+  int maxPitch = min(tft.width() / renderView.w, matrixAreaH / renderView.h);
   if (maxPitch < 1) maxPitch = 1;
   return maxPitch;
 }
@@ -526,8 +1055,8 @@ static void rebuildSprite(int pitch) {
   }
 
   spr.setColorDepth(16);
-  int sprW = LED_MATRIX_W * pitch;
-  int sprH = LED_MATRIX_H * pitch;
+  int sprW = renderView.w * pitch;
+  int sprH = renderView.h * pitch;
   if (sprW <= 0 || sprH <= 0) return;
 
   if (spr.createSprite(sprW, sprH)) {
@@ -536,149 +1065,811 @@ static void rebuildSprite(int pitch) {
   } else {
     useSprite = false;
   }
+  fbShownValid = false;
 }
 
 static void updateRenderPitch(bool force = false) {
+  const LayoutBox view = computeViewport(computeLayout(activeFont()));
+  const bool viewChanged = view.x != renderView.x || view.y != renderView.y ||
+                           view.w != renderView.w || view.h != renderView.h;
+  if (viewChanged) {
+    renderView = view;
+    tft.fillRect(0, 0, tft.width(), tft.height() - STATUS_BAR_H, TFT_BLACK);  // margins of the old view
+  }
   int pitch = computeRenderPitch();
-  if (!force && pitch == fbPitch && useSprite) return;
+  if (!force && !viewChanged && pitch == fbPitch && useSprite) return;
   fbPitch = pitch;
   rebuildSprite(fbPitch);
 }
 
-static void drawStatusBar() {
-#if STATUS_BAR_H > 0
-  static uint32_t lastDrawMs = 0;
-  static char lastLine1[64] = "";
-  static char lastLine2[64] = "";
-
-  int barY = tft.height() - STATUS_BAR_H;
-  if (barY < 0) barY = tft.height();
+// =========================
+// Status Bar Layer
+// =========================
+// The bar below the matrix is a set of text slots, each with its own 1-bit sprite (a few hundred bytes).
+// Producers (sensor, clock/date, config) mark slots dirty; the render task repaints only slots whose
+// text actually changed. Text wider than its slot scrolls inside that slot, and the extra slot rotates
+// through pressure / IP / uptime, so neither ever repaints the full width.
+enum StatusSlotId : uint8_t {
+  STATUS_SLOT_SENSOR = 0,   // line 1: temperature + humidity
+  STATUS_SLOT_EXTRA,        // line 1, right: rotating pressure / IP / uptime
+  STATUS_SLOT_DATE,         // line 2: date
+  STATUS_SLOT_TZ,           // line 2: timezone (scrolls when long)
+  STATUS_SLOT_COUNT
+};
 
-  char line1[64];
-  // Line 1: Temperature and Humidity
-  if (sensorAvailable) {
-    int displayTemp = cfg.useFahrenheit ? (temperature * 9 / 5 + 32) : temperature;
-    const char* tempUnit = cfg.useFahrenheit ? "oF" : "oC";  // Using 'o' as degree symbol
-    snprintf(line1, sizeof(line1), "Temp: %d%s  Humidity: %d%%", displayTemp, tempUnit, humidity);
-  } else {
-    snprintf(line1, sizeof(line1), "Sensor: Not detected");
-  }
+enum StatusDirty : uint32_t {
+  STATUS_DIRTY_SENSOR = 1 << STATUS_SLOT_SENSOR,
+  STATUS_DIRTY_EXTRA  = 1 << STATUS_SLOT_EXTRA,
+  STATUS_DIRTY_DATE   = 1 << STATUS_SLOT_DATE,
+  STATUS_DIRTY_TZ     = 1 << STATUS_SLOT_TZ,
+  STATUS_DIRTY_FRAME  = 1 << STATUS_SLOT_COUNT,          // background + separator, forces every slot
+  STATUS_DIRTY_ALL    = (1 << (STATUS_SLOT_COUNT + 1)) - 1
+};
 
-  char line2[64];
-  // Line 2: Date and Timezone
-  snprintf(line2, sizeof(line2), "%s  %s", currDate, cfg.tz);
+struct StatusSlot {
+  int16_t x, y, w;
+  uint16_t color;
+  int16_t textW;          // rendered width of text (px)
+  int16_t scroll;         // scroll offset when textW > w
+  uint32_t scrollMs;      // last scroll step (or start of the pause at offset 0)
+  bool ready;             // sprite created
+  char text[64];
+};
 
-  uint32_t now = millis();
-  bool changed = (strncmp(line1, lastLine1, sizeof(line1)) != 0) ||
-                 (strncmp(line2, lastLine2, sizeof(line2)) != 0);
-  if (!changed && (now - lastDrawMs) < 1000) return;
+static const int STATUS_TEXT_H = 16;        // font 2 line height
+static const int STATUS_SCROLL_GAP = 32;    // px between the end of scrolling text and its repeat
+static TFT_eSprite statusSpr[STATUS_SLOT_COUNT] = {TFT_eSprite(&tft), TFT_eSprite(&tft),
+                                                   TFT_eSprite(&tft), TFT_eSprite(&tft)};
+static StatusSlot statusSlots[STATUS_SLOT_COUNT];
+static std::atomic<uint32_t> statusDirty{STATUS_DIRTY_ALL};
+static uint8_t statusExtraIdx = 1;   // 0 = pressure, 1 = IP, 2 = uptime (no reading at boot)
+static uint32_t statusRotateMs = 0;
+static uint32_t statusUptimeMin = 0;
 
-  strlcpy(lastLine1, line1, sizeof(lastLine1));
-  strlcpy(lastLine2, line2, sizeof(lastLine2));
-  lastDrawMs = now;
+/**
+ * Ask the render task to refresh status bar slots (safe from any task)
+ * @param bits StatusDirty bits
+ */
+static void markStatusDirty(uint32_t bits) {
+  statusDirty.fetch_or(bits, std::memory_order_release);
+  wakeRenderer();
+}
 
-  tft.fillRect(0, barY, tft.width(), STATUS_BAR_H, TFT_BLACK);
-  tft.drawFastHLine(0, barY, tft.width(), TFT_DARKGREY);
+// OTA progress replaces the extra slot's rotation while an update runs (ArduinoOTA or /api/ota)
+static const int8_t OTA_PCT_UNKNOWN = 101;      // upload size unknown: show kilobytes instead
+static std::atomic<int8_t> otaProgressPct{-1};  // -1 idle, 0-100, or OTA_PCT_UNKNOWN
+static std::atomic<uint32_t> otaProgressKb{0};
 
-  tft.setTextDatum(TL_DATUM);
-  tft.setTextColor(TFT_CYAN, TFT_BLACK);
-  tft.setTextFont(2);
-  tft.setTextSize(1);
-  tft.drawString(line1, 6, barY + 6);
+static bool otaRunning() { return otaProgressPct.load() >= 0; }
 
-  tft.setTextColor(TFT_LIGHTGREY, TFT_BLACK);
-  tft.drawString(line2, 6, barY + 24);
-#endif
+/**
+ * Publish OTA progress; the slot is only marked dirty when the next OTA_PROGRESS_STEP band (or
+ * OTA_PROGRESS_KB_STEP) is reached, so a 1 MB upload repaints it about 20 times
+ * @param total Expected bytes (0 = unknown)
+ */
+static void otaProgressSet(uint32_t done, uint32_t total) {
+  const int8_t pct = total ? (int8_t)min<uint64_t>(100, (uint64_t)done * 100 / total) : OTA_PCT_UNKNOWN;
+  const uint32_t kb = done / 1024;
+  const int8_t shown = otaProgressPct.load();
+  const bool step = total ? shown < 0 || shown == OTA_PCT_UNKNOWN || pct / OTA_PROGRESS_STEP != shown / OTA_PROGRESS_STEP
+                          : shown != OTA_PCT_UNKNOWN || kb / OTA_PROGRESS_KB_STEP != otaProgressKb.load() / OTA_PROGRESS_KB_STEP;
+  if (!step) return;
+  otaProgressKb.store(kb);
+  otaProgressPct.store(pct);
+  markStatusDirty(STATUS_DIRTY_EXTRA);
+  DBG_VERBOSE("OTA Progress: %u/%u bytes\n", (unsigned)done, (unsigned)total);
 }
 
-static void renderFBToTFT() {
-  const int pitch = fbPitch;
-  const int sprW = LED_MATRIX_W * pitch; // 320 when 64x32 with pitch 5
-  const int sprH = LED_MATRIX_H * pitch; // 160 when 64x32 with pitch 5
+static void otaProgressEnd() {
+  otaProgressPct.store(-1);
+  markStatusDirty(STATUS_DIRTY_EXTRA);
+}
 
-  int matrixAreaH = tft.height() - STATUS_BAR_H;
-  if (matrixAreaH < sprH) matrixAreaH = tft.height();
+// Position a slot and clear its cached text so the next drawStatusBar() repaints it
+static void placeStatusSlot(int id, int x, int y, int w, uint16_t color) {
+  StatusSlot& s = statusSlots[id];
+  s.x = (int16_t)x;
+  s.y = (int16_t)y;
+  s.w = (int16_t)w;
+  s.color = color;
+  s.textW = 0;
+  s.scroll = 0;
+  s.scrollMs = 0;
+  s.text[0] = '\0';
+}
 
-  int x0 = (tft.width()  - sprW) / 2;
-  int y0 = (matrixAreaH - sprH) / 2;
+/**
+ * Lay out the slots and create their sprites. Call once the TFT rotation is set.
+ */
+static void initStatusBar() {
+#if STATUS_BAR_H > 0
+  for (int i = 0; i < STATUS_SLOT_COUNT; i++) {
+    if (statusSlots[i].ready) statusSpr[i].deleteSprite();
+    statusSlots[i].ready = false;
+  }
+  const int w = tft.width();
+  int barY = tft.height() - STATUS_BAR_H;
+  if (barY < 0) barY = tft.height();
+  const int dateW = tft.textWidth("Sep 30, 2026", 2) + 12;
+  const int extraX = w * 2 / 3;
+
+  placeStatusSlot(STATUS_SLOT_SENSOR, 6, barY + 6, extraX - 12, TFT_CYAN);
+  placeStatusSlot(STATUS_SLOT_EXTRA, extraX, barY + 6, w - extraX - 4, TFT_LIGHTGREY);
+  placeStatusSlot(STATUS_SLOT_DATE, 6, barY + 24, dateW, TFT_LIGHTGREY);
+  placeStatusSlot(STATUS_SLOT_TZ, 6 + dateW, barY + 24, w - 10 - dateW, TFT_LIGHTGREY);
+
+  for (int i = 0; i < STATUS_SLOT_COUNT; i++) {
+    StatusSlot& s = statusSlots[i];
+    if (s.w <= 0) continue;
+    statusSpr[i].setColorDepth(1);
+    s.ready = statusSpr[i].createSprite(s.w, STATUS_TEXT_H) != nullptr;
+    if (!s.ready) DBG_WARN("Status slot %d sprite failed, drawing direct\n", i);
+  }
+  markStatusDirty(STATUS_DIRTY_ALL);
+#endif
+}
 
-  // Base RGB components from cfg.ledColor
-  const uint8_t baseR = (cfg.ledColor >> 16) & 0xFF;
-  const uint8_t baseG = (cfg.ledColor >> 8)  & 0xFF;
-  const uint8_t baseB = (cfg.ledColor >> 0)  & 0xFF;
+// Render the current text of a slot (any task may have changed the values; benign torn reads)
+static void composeStatusSlot(int id, char* out, size_t n) {
+  switch (id) {
+    case STATUS_SLOT_SENSOR:
+      if (sensorAvailable) {
+        int displayTemp = cfg.useFahrenheit ? (temperature * 9 / 5 + 32) : temperature;
+        const char* tempUnit = cfg.useFahrenheit ? "oF" : "oC";  // Using 'o' as degree symbol
+        snprintf(out, n, "Temp: %d%s  Humidity: %d%%", displayTemp, tempUnit, humidity);
+      } else {
+        snprintf(out, n, "Sensor: Not detected");
+      }
+      break;
+    case STATUS_SLOT_EXTRA: {
+      const int8_t ota = otaProgressPct.load();
+      if (ota == OTA_PCT_UNKNOWN) {
+        snprintf(out, n, "OTA %u KB", (unsigned)otaProgressKb.load());
+        break;
+      }
+      if (ota >= 0) {
+        snprintf(out, n, "OTA %d%%", ota);
+        break;
+      }
+      // drawStatusBar() skips the pressure entry without a reading; one lost mid-dwell shows the IP
+      if (statusExtraIdx == 0 && sensorAvailable && pressure > 0) {
+        snprintf(out, n, "%d hPa", pressure);
+      } else if (statusExtraIdx != 2) {
+        char ip[16];
+        if (netInfo(nullptr, 0, ip, sizeof(ip))) snprintf(out, n, "%s", ip);
+        else snprintf(out, n, "No WiFi");
+      } else {
+        const uint32_t m = millis() / 60000UL;
+        snprintf(out, n, "Up %lud %02lu:%02lu", (unsigned long)(m / 1440), (unsigned long)(m / 60 % 24),
+                 (unsigned long)(m % 60));
+      }
+      break;
+    }
+    case STATUS_SLOT_DATE:
+      portENTER_CRITICAL(&clockMux);
+      strlcpy(out, currDate, n);
+      portEXIT_CRITICAL(&clockMux);
+      break;
+    default:
+      snprintf(out, n, "%s", cfg.tz);
+      break;
+  }
+}
 
-  int gapWanted = (int)cfg.ledGap;
-  if (gapWanted < 0) gapWanted = 0;
-  if (gapWanted > pitch - 1) gapWanted = pitch - 1;
+// Push one slot to the TFT at its current scroll offset
+static void paintStatusSlot(int id) {
+  StatusSlot& s = statusSlots[id];
+  if (!s.ready) {
+    tft.fillRect(s.x, s.y, s.w, STATUS_TEXT_H, TFT_BLACK);
+    tft.setTextDatum(TL_DATUM);
+    tft.setTextColor(s.color, TFT_BLACK);
+    tft.drawString(s.text, s.x, s.y, 2);
+    return;
+  }
+  TFT_eSprite& spr1 = statusSpr[id];
+  spr1.fillSprite(0);
+  spr1.setTextDatum(TL_DATUM);
+  spr1.setTextColor(1, 0);
+  spr1.drawString(s.text, -s.scroll, 0, 2);
+  if (s.textW > s.w) spr1.drawString(s.text, -s.scroll + s.textW + STATUS_SCROLL_GAP, 0, 2);
+  spr1.setBitmapColor(s.color, TFT_BLACK);
+  spr1.pushSprite(s.x, s.y);
+}
 
-  int dot = pitch - gapWanted;
-  int maxDot = (int)cfg.ledDiameter;
-  if (maxDot < 1) maxDot = 1;
-  if (dot > maxDot) dot = maxDot;
+/**
+ * Milliseconds until the status bar needs another step for scrolling or rotation (render task only)
+ */
+static uint32_t statusBarDueMs() {
+#if STATUS_BAR_H > 0
+  const uint32_t now = millis();
+  uint32_t due = STATUS_ROTATE_MS - min<uint32_t>(now - statusRotateMs, STATUS_ROTATE_MS);
+  for (int i = 0; i < STATUS_SLOT_COUNT; i++) {
+    const StatusSlot& s = statusSlots[i];
+    if (s.textW <= s.w) continue;
+    const uint32_t step = s.scroll == 0 ? STATUS_SCROLL_PAUSE_MS : STATUS_SCROLL_MS;
+    const uint32_t since = now - s.scrollMs;
+    due = min<uint32_t>(due, since >= step ? 0 : step - since);
+  }
+  return due;
+#else
+  return UINT32_MAX;
+#endif
+}
+
+/**
+ * Repaint the status bar slots that changed, scrolled or rotated (render task only)
+ */
+static void drawStatusBar() {
+#if STATUS_BAR_H > 0
+  const uint32_t now = millis();
+  uint32_t dirty = statusDirty.exchange(0, std::memory_order_acquire);
+
+  if (now - statusRotateMs >= STATUS_ROTATE_MS) {
+    statusRotateMs = now;
+    statusExtraIdx = (statusExtraIdx + 1) % 3;
+    if (statusExtraIdx == 0 && !(sensorAvailable && pressure > 0)) statusExtraIdx = 1;
+    dirty |= STATUS_DIRTY_EXTRA;
+  }
+  const uint32_t upMin = now / 60000UL;
+  if (upMin != statusUptimeMin) {
+    statusUptimeMin = upMin;
+    if (statusExtraIdx == 2) dirty |= STATUS_DIRTY_EXTRA;
+  }
+
+  if (dirty & STATUS_DIRTY_FRAME) {
+    int barY = tft.height() - STATUS_BAR_H;
+    if (barY < 0) barY = tft.height();
+    tft.fillRect(0, barY, tft.width(), STATUS_BAR_H, TFT_BLACK);
+    tft.drawFastHLine(0, barY, tft.width(), TFT_DARKGREY);
+  }
+
+  for (int i = 0; i < STATUS_SLOT_COUNT; i++) {
+    StatusSlot& s = statusSlots[i];
+    if (s.w <= 0) continue;
+    bool paint = (dirty & STATUS_DIRTY_FRAME) != 0;
+
+    if (dirty & (1u << i)) {
+      char text[sizeof(s.text)];
+      composeStatusSlot(i, text, sizeof(text));
+      if (strcmp(text, s.text) != 0) {
+        strlcpy(s.text, text, sizeof(s.text));
+        s.textW = (int16_t)tft.textWidth(s.text, 2);
+        s.scroll = 0;
+        s.scrollMs = now;
+        paint = true;
+      }
+    }
+
+    // Long text: hold at the start, then scroll one pixel per STATUS_SCROLL_MS and wrap
+    if (s.textW > s.w && s.ready) {
+      const uint32_t step = s.scroll == 0 ? STATUS_SCROLL_PAUSE_MS : STATUS_SCROLL_MS;
+      if (now - s.scrollMs >= step) {
+        s.scroll = (int16_t)((s.scroll + 1) % (s.textW + STATUS_SCROLL_GAP));
+        s.scrollMs = now;
+        paint = true;
+      }
+    }
+
+    if (paint) paintStatusSlot(i);
+  }
+#endif
+}
+
+/**
+ * Force the next renderFBToTFT() call to repaint the whole matrix
+ * (after screen clears, rotation changes or sprite rebuilds). Safe from any task.
+ */
+static void requestFullRedraw() { postRenderRequest(RENDER_REQ_FULL); }
+
+/**
+ * Define the dirty-tracking cells as a list of column start positions.
+ * Boundaries at 0 and LED_MATRIX_W are added automatically.
+ * @param starts Column where each cell begins (ascending)
+ * @param n Number of entries in starts
+ */
+static void setDirtyCells(const int* starts, int n) {
+  uint8_t count = 0;
+  dirtyCellX[0] = 0;
+  for (int i = 0; i < n && count < MAX_DIRTY_CELLS - 1; i++) {
+    if (starts[i] <= dirtyCellX[count] || starts[i] >= LED_MATRIX_W) continue;
+    dirtyCellX[++count] = (uint16_t)starts[i];
+  }
+  dirtyCellX[++count] = LED_MATRIX_W;
+  dirtyCellCount = count;
+  sceneDirtyCells = 0xFFFFFFFFu;
+  invalidatePalette();  // per-digit palette bands follow the cell layout
+}
+
+// LED-space rectangle (inclusive) that needs repainting
+struct DirtyRect { int16_t x0, y0, x1, y1; };
+
+// Per-frame LED geometry in TFT pixels
+struct LedGeometry {
+  int pitch;
+  int dot;
+  int inset;
+  uint8_t shape;   // LedShape
+};
+
+// Dot stamp: per-pixel coverage of one LED cell (pitch x pitch), rebuilt on geometry change.
+// Row kinds let the blitter memset blank scanlines and memcpy repeated ones.
+enum DotRowKind : uint8_t { DOT_ROW_BLANK = 0, DOT_ROW_REPEAT, DOT_ROW_BUILD };
+static uint8_t dotMask[DOT_STAMP_MAX][DOT_STAMP_MAX];
+static uint8_t dotRowKind[DOT_STAMP_MAX];
+static bool dotStampValid = false;
+
+/**
+ * Find the bounding box of pixels that differ between fb and fbShown within columns [cx0, cx1)
+ * and rows [ry0, ry1)
+ * @return true if anything changed
+ */
+static bool findDirtyRect(int cx0, int cx1, int ry0, int ry1, DirtyRect& r) {
+  int minX = cx1, maxX = cx0 - 1, minY = ry1, maxY = -1;
+  const int span = cx1 - cx0;
+
+  for (int y = ry0; y < ry1; y++) {
+    if (!fbSpanDiffers(fb[y], fbShown[y], cx0, cx1)) continue;
+
+    bool rowDirty = false;
+    for (int x = 0; x < span; x++) {
+      if (fbGetPx(fb[y], cx0 + x) == fbGetPx(fbShown[y], cx0 + x)) continue;
+      rowDirty = true;
+      if (cx0 + x < minX) minX = cx0 + x;
+      if (cx0 + x > maxX) maxX = cx0 + x;
+    }
+    if (!rowDirty) continue;   // packed rows: the differing word only held LEDs outside the span
+    if (y < minY) minY = y;
+    maxY = y;
+  }
+
+  if (maxY < 0) return false;
+  r = DirtyRect{(int16_t)minX, (int16_t)minY, (int16_t)maxX, (int16_t)maxY};
+  return true;
+}
+
+/**
+ * Rasterize the LED dot into dotMask (0 = off, 255 = fully lit).
+ * Square dots fill dot x dot; round dots keep pixels whose centre lies inside
+ * a circle of diameter dot; soft dots add a one-pixel anti-aliased rim.
+ */
+static void rebuildDotStamp(const LedGeometry& g) {
+  const int pitch = g.pitch;
+  memset(dotMask, 0, sizeof(dotMask));
+  dotStampValid = pitch <= DOT_STAMP_MAX;
+  if (!dotStampValid) return;
+
+  const float c = g.inset + g.dot * 0.5f;  // dot centre within the cell
+  const float radius = g.dot * 0.5f;
+
+  for (int sy = 0; sy < pitch; sy++) {
+    for (int sx = 0; sx < pitch; sx++) {
+      uint8_t cov = 0;
+      const bool inSquare = sx >= g.inset && sx < g.inset + g.dot &&
+                            sy >= g.inset && sy < g.inset + g.dot;
+      if (g.shape == LED_SHAPE_SQUARE || g.dot <= 2) {
+        cov = inSquare ? 255 : 0;
+      } else {
+        const float dx = (sx + 0.5f) - c;
+        const float dy = (sy + 0.5f) - c;
+        const float d = sqrtf(dx * dx + dy * dy);
+        if (g.shape == LED_SHAPE_ROUND) {
+          cov = d <= radius ? 255 : 0;
+        } else {
+          // Soft: full inside radius-1, linear falloff over the outer pixel
+          float a = radius - d;
+          if (a >= 1.0f) cov = 255;
+          else if (a > 0.0f) cov = (uint8_t)(a * 255.0f);
+        }
+      }
+      dotMask[sy][sx] = cov;
+    }
+  }
+
+  for (int sy = 0; sy < pitch; sy++) {
+    bool blank = true;
+    for (int sx = 0; sx < pitch; sx++) if (dotMask[sy][sx]) { blank = false; break; }
+    if (blank) dotRowKind[sy] = DOT_ROW_BLANK;
+    else if (sy > 0 && memcmp(dotMask[sy], dotMask[sy - 1], pitch) == 0) dotRowKind[sy] = DOT_ROW_REPEAT;
+    else dotRowKind[sy] = DOT_ROW_BUILD;
+  }
+}
+
+// Sprite buffers hold RGB565 byte-swapped (display order)
+static inline uint16_t swap565(uint16_t c) { return (uint16_t)((c >> 8) | (c << 8)); }
+
+/**
+ * Blit one LED-space rectangle straight into a 16-bit sprite buffer.
+ *
+ * Each logical row is written as pitch scanlines: blank scanlines are cleared,
+ * scanlines whose mask row repeats the previous one are memcpy'd, and the rest
+ * are built LED by LED from the dot stamp. Every pixel of the rectangle is written,
+ * so no prior clear is needed.
+ * @param buf Sprite pixel buffer (spr.getPointer())
+ * @param bufW Sprite width in pixels
+ * @param vx,vy LED at the sprite origin (top-left of the viewport)
+ */
+static void blitLedRect(uint16_t* buf, int bufW, int vx, int vy, const DirtyRect& r, const LedGeometry& g) {
+  const int pitch = g.pitch;
+  const int px0 = (r.x0 - vx) * pitch;
+  const size_t lineBytes = (size_t)(r.x1 - r.x0 + 1) * pitch * sizeof(uint16_t);
+
+  uint8_t scratch[LED_MATRIX_W];
+  for (int y = r.y0; y <= r.y1; y++) {
+    const uint8_t* row = fbRowBytes(fb[y], scratch);
+    const uint8_t rb = rowBand[y];
+    uint16_t* line = buf + (size_t)((y - vy) * pitch) * bufW + px0;
+    const uint16_t* prevLine = nullptr;
+
+    for (int sy = 0; sy < pitch; sy++, line += bufW) {
+      const uint8_t kind = dotRowKind[sy];
+      if (kind == DOT_ROW_BLANK) {
+        memset(line, 0, lineBytes);
+      } else if (kind == DOT_ROW_REPEAT && prevLine) {
+        memcpy(line, prevLine, lineBytes);
+      } else {
+        const uint8_t* mask = dotMask[sy];
+        uint16_t* out = line;
+        for (int x = r.x0; x <= r.x1; x++, out += pitch) {
+          const uint8_t v = row[x];
+          if (!v) {
+            for (int sx = 0; sx < pitch; sx++) out[sx] = 0;
+            continue;
+          }
+          const uint16_t* lut = paletteLut[rb + colBand[x]];
+          const uint16_t col = swap565(lut[v]);
+          for (int sx = 0; sx < pitch; sx++) {
+            const uint8_t cov = mask[sx];
+            if (cov == 255) out[sx] = col;
+            else if (cov == 0) out[sx] = 0;
+            else out[sx] = swap565(lut[(v * (cov + 1)) >> 8]);
+          }
+        }
+      }
+      prevLine = line;
+    }
+  }
+}
+
+/**
+ * Repaint one LED-space rectangle onto a drawing target (sprite or TFT)
+ * @param gfx Target (TFT_eSprite derives from TFT_eSPI)
+ * @param ox,oy Target pixel offset of LED (0,0)
+ */
+static void paintLedRect(TFT_eSPI& gfx, int ox, int oy, const DirtyRect& r, const LedGeometry& g) {
+  // fillRect per LED: used for direct draw and when the pitch exceeds DOT_STAMP_MAX
+  const int pitch = g.pitch;
+  gfx.fillRect(ox + r.x0 * pitch, oy + r.y0 * pitch,
+               (r.x1 - r.x0 + 1) * pitch, (r.y1 - r.y0 + 1) * pitch, TFT_BLACK);
+
+  uint8_t scratch[LED_MATRIX_W];
+  for (int y = r.y0; y <= r.y1; y++) {
+    const uint8_t* row = fbRowBytes(fb[y], scratch);
+    const uint8_t rb = rowBand[y];
+    for (int x = r.x0; x <= r.x1; x++) {
+      uint8_t v = row[x];
+      if (!v) continue;
+      const uint16_t col = paletteLut[rb + colBand[x]][v];
+      gfx.fillRect(ox + x * pitch + g.inset, oy + y * pitch + g.inset, g.dot, g.dot, col);
+    }
+  }
+}
+
+// Record a repainted rectangle as shown
+static void markRectShown(const DirtyRect& r) {
+  for (int y = r.y0; y <= r.y1; y++) fbCopySpan(fbShown[y], fb[y], r.x0, r.x1 + 1);
+}
+
+// =========================
+// DMA push (ping-pong strips)
+// =========================
+// A second full-size sprite does not fit next to the first in CYD heap, so windows are
+// copied into two small DMA-capable strips: one strip is filled while the other is on the bus.
+static uint16_t* dmaStrip[2] = {nullptr, nullptr};
+static uint8_t dmaStripIdx = 0;
+static bool dmaReady = false;
+
+static void initDmaStrips() {
+  const size_t bytes = (size_t)tft.width() * DMA_STRIP_LINES * sizeof(uint16_t);
+  for (int i = 0; i < 2; i++) {
+    dmaStrip[i] = (uint16_t*)heap_caps_malloc(bytes, MALLOC_CAP_DMA);
+  }
+  dmaReady = dmaStrip[0] && dmaStrip[1] && tft.initDMA();
+  if (!dmaReady) {
+    for (int i = 0; i < 2; i++) {
+      if (dmaStrip[i]) heap_caps_free(dmaStrip[i]);
+      dmaStrip[i] = nullptr;
+    }
+    DBG_WARN("TFT DMA unavailable, using blocking sprite pushes\n");
+  } else {
+    DBG_INFO("TFT DMA ready (2 x %u byte strips)\n", (unsigned)bytes);
+  }
+}
+
+/**
+ * Push a window of the sprite to the TFT (inside startWrite/endWrite).
+ * With DMA, rows are staged into alternating strips so copying overlaps the transfer;
+ * pushImageDMA() waits for the previous strip before starting the next.
+ */
+static void pushSpriteWindow(int tx, int ty, int sx, int sy, int sw, int sh) {
+  const uint16_t* src = (const uint16_t*)spr.getPointer();
+  if (!dmaReady || !src || sw > tft.width()) {
+    spr.pushSprite(tx, ty, sx, sy, sw, sh);
+    return;
+  }
+
+  const int sprW = spr.width();
+  for (int line = 0; line < sh; line += DMA_STRIP_LINES) {
+    const int n = min(DMA_STRIP_LINES, sh - line);
+    uint16_t* strip = dmaStrip[dmaStripIdx];
+    dmaStripIdx ^= 1;
+    for (int i = 0; i < n; i++) {
+      memcpy(strip + i * sw, src + (size_t)(sy + line + i) * sprW + sx, sw * sizeof(uint16_t));
+    }
+    tft.pushImageDMA(tx, ty + line, sw, n, strip);
+  }
+}
+
+/**
+ * Resolve LED dot size/inset for the current pitch from cfg.ledDiameter / cfg.ledGap
+ */
+static LedGeometry computeLedGeometry(int pitch) {
+  int gapWanted = (int)cfg.ledGap;
+  if (gapWanted < 0) gapWanted = 0;
+  if (gapWanted > pitch - 1) gapWanted = pitch - 1;
+
+  int dot = pitch - gapWanted;
+  int maxDot = (int)cfg.ledDiameter;
+  if (maxDot < 1) maxDot = 1;
+  if (dot > maxDot) dot = maxDot;
   if (dot < 1) dot = 1;
 
-  int gap = pitch - dot;
   const int inset = (pitch - dot) / 2;
+  return LedGeometry{pitch, dot, inset, cfg.ledShape};
+}
+
+/**
+ * Render the logical framebuffer to the TFT, repainting only what changed.
+ *
+ * fb is compared against fbShown (the last frame actually pushed) per dirty cell;
+ * each cell with changes is repainted and pushed as a sub-rectangle of the sprite.
+ * Frames with no changes skip all sprite work and SPI traffic.
+ * Geometry or color changes fall back to one full repaint.
+ */
+static void renderFBToTFT() {
+  const int64_t perfT0 = esp_timer_get_time();
+  const int pitch = fbPitch;
+  const LayoutBox view = renderView;
+  const int sprW = view.w * pitch; // 320 when the whole 64x32 matrix is shown with pitch 5
+  const int sprH = view.h * pitch; // 160 when the whole 64x32 matrix is shown with pitch 5
+
+  int matrixAreaH = tft.height() - STATUS_BAR_H;
+  if (matrixAreaH < sprH) matrixAreaH = tft.height();
+
+  // TFT position of the sprite, and of LED (0,0) for direct drawing
+  int x0 = (tft.width()  - sprW) / 2;
+  int y0 = (matrixAreaH - sprH) / 2;
+  const int ledOx = x0 - view.x * pitch;
+  const int ledOy = y0 - view.y * pitch;
+
+  const LedGeometry geom = computeLedGeometry(pitch);
+  const int dot = geom.dot;
+  const int gap = pitch - dot;
   appliedDot = (uint8_t)dot;
   appliedGap = (uint8_t)gap;
   appliedPitch = (uint8_t)pitch;
 
+  // Any change in how an LED looks invalidates everything already on screen
+  static LedGeometry lastGeom{0, 0, 0, 0};
+  if (geom.pitch != lastGeom.pitch || geom.dot != lastGeom.dot ||
+      geom.inset != lastGeom.inset || geom.shape != lastGeom.shape) {
+    lastGeom = geom;
+    rebuildDotStamp(geom);
+    fbShownValid = false;
+  }
+  if (!paletteValid) {
+    rebuildPalette();
+    fbShownValid = false;
+  }
+
+  // Collect dirty rectangles (one per changed cell, or the whole view), clipped to the view
+  DirtyRect rects[MAX_DIRTY_CELLS];
+  int rectCount = 0;
+  const bool full = !fbShownValid;
+  const int vx1 = view.x + view.w;
+  const int vy1 = view.y + view.h;
+
+  if (full) {
+    rects[rectCount++] = DirtyRect{view.x, view.y, (int16_t)(vx1 - 1), (int16_t)(vy1 - 1)};
+  } else {
+    if (dirtyCellCount == 0) {
+      // No layout registered yet: fall back to uniform 8-column cells
+      int starts[LED_MATRIX_W / 8 + 1];
+      int n = 0;
+      for (int x = 8; x < LED_MATRIX_W; x += 8) starts[n++] = x;
+      setDirtyCells(starts, n);
+    }
+    for (int i = 0; i < dirtyCellCount; i++) {
+      if (!(sceneDirtyCells & (1u << i))) continue;   // drawFrame() left this cell alone
+      const int cx0 = max<int>(dirtyCellX[i], view.x);
+      const int cx1 = min<int>(dirtyCellX[i + 1], vx1);
+      DirtyRect r;
+      if (cx0 < cx1 && findDirtyRect(cx0, cx1, view.y, vy1, r)) rects[rectCount++] = r;
+    }
+  }
+  sceneDirtyCells = 0;
+
   // Verbose debug output (print once per second)
   static uint32_t lastDbg = 0;
+  static uint32_t pushedPx = 0;
+  static uint32_t pushedRects = 0;
   if (millis() - lastDbg > 1000) {
-    DBG_VERBOSE("Render: pitch=%d dot=%d gap=%d ledD=%d ledG=%d\n",
-                pitch, dot, gap, cfg.ledDiameter, cfg.ledGap);
+    DBG_VERBOSE("Render: pitch=%d dot=%d gap=%d ledD=%d ledG=%d rects/s=%u px/s=%u\n",
+                pitch, dot, gap, cfg.ledDiameter, cfg.ledGap,
+                (unsigned)pushedRects, (unsigned)pushedPx);
+    pushedRects = 0;
+    pushedPx = 0;
     lastDbg = millis();
   }
 
-  if (useSprite) {
-    spr.fillSprite(TFT_BLACK);
-
-    for (int y = 0; y < LED_MATRIX_H; y++) {
-      for (int x = 0; x < LED_MATRIX_W; x++) {
-        uint8_t v = fb[y][x];
-        if (!v) continue;
-
-        // Scale base color by intensity v (0..255)
-        uint8_t r = (uint8_t)((baseR * (uint16_t)v) / 255);
-        uint8_t g = (uint8_t)((baseG * (uint16_t)v) / 255);
-        uint8_t b = (uint8_t)((baseB * (uint16_t)v) / 255);
-
-        uint16_t colScaled = rgb888_to_565(((uint32_t)r << 16) | ((uint32_t)g << 8) | b);
+  if (rectCount > 0) {
+    if (useSprite) {
+      uint16_t* sprBuf = (uint16_t*)spr.getPointer();
+      const bool blit = dotStampValid && sprBuf != nullptr;
+      if (full && !blit) {
+        spr.fillSprite(TFT_BLACK);
+      }
+      for (int i = 0; i < rectCount; i++) {
+        if (blit) blitLedRect(sprBuf, sprW, view.x, view.y, rects[i], geom);
+        else paintLedRect(spr, -view.x * pitch, -view.y * pitch, rects[i], geom);
+      }
 
-        spr.fillRect(x * pitch + inset, y * pitch + inset, dot, dot, colScaled);
+      // Sprite already holds the full matrix; push only the changed windows
+      tft.startWrite();
+      for (int i = 0; i < rectCount; i++) {
+        const DirtyRect& r = rects[i];
+        const int sx = (r.x0 - view.x) * pitch;
+        const int sy = (r.y0 - view.y) * pitch;
+        const int sw = (r.x1 - r.x0 + 1) * pitch;
+        const int sh = (r.y1 - r.y0 + 1) * pitch;
+        pushSpriteWindow(x0 + sx, y0 + sy, sx, sy, sw, sh);
+        pushedPx += (uint32_t)sw * sh;
+      }
+      if (dmaReady) tft.dmaWait();
+      tft.endWrite();
+    } else {
+      // -------------------------
+      // Fallback (direct draw): slower, and may flicker inside changed cells
+      // -------------------------
+      for (int i = 0; i < rectCount; i++) {
+        paintLedRect(tft, ledOx, ledOy, rects[i], geom);
+        pushedPx += (uint32_t)(rects[i].x1 - rects[i].x0 + 1) * pitch *
+                    (uint32_t)(rects[i].y1 - rects[i].y0 + 1) * pitch;
       }
     }
 
-    // No need to clear TFT region; sprite fully covers its area
-    tft.startWrite();
-    spr.pushSprite(x0, y0);
-    tft.endWrite();
+    for (int i = 0; i < rectCount; i++) markRectShown(rects[i]);
+    pushedRects += rectCount;
+    fbShownValid = true;
+  }
+  perfRecord(PERF_RENDER, (uint32_t)(esp_timer_get_time() - perfT0));
+
+  {
+    PerfScope ps(PERF_STATUS_BAR);
     drawStatusBar();
-    return;
   }
+}
 
-  // -------------------------
-  // Fallback (direct draw): slower but correct
-  // -------------------------
-  tft.fillScreen(TFT_BLACK);
+#ifdef HUB75_ENABLE
+// =========================
+// HUB75 panel backend
+// =========================
+// The panel is refreshed by DMA from BCM bit planes (include/hub75_dma.h); per frame only row pairs
+// whose fb pixels changed since the last conversion are rebuilt, so a static clock costs two
+// memcmp's per row pair and a morph only touches the rows it moves through.
+static Hub75Dma hub75;
+static FbRow hub75Shown[LED_MATRIX_H];   // fb as last converted into the planes
+static bool hub75Valid = false;
+static uint32_t hub75PaletteGen = 0;
+static uint8_t hub75Brightness = 0;
+static uint32_t hub75RowsConverted = 0;   // lifetime row pairs rebuilt (/api/perf)
+
+static bool hub75Begin() {
+  if (!hub75.begin()) return false;
+  DBG_INFO("HUB75 panel: %dx%d, %d planes, %u Hz refresh\n", LED_MATRIX_W, LED_MATRIX_H, HUB75_PLANES,
+           (unsigned)hub75.refreshHz());
+  return true;
+}
 
-  for (int y = 0; y < LED_MATRIX_H; y++) {
-    for (int x = 0; x < LED_MATRIX_W; x++) {
-      uint8_t v = fb[y][x];
-      if (!v) continue;
+// LED (x, y) at intensity v as gamma-corrected R, G, B drive levels: palette band color x v x displayLevel
+static inline void hub75Rgb(int x, int y, uint8_t v, uint8_t* out) {
+  if (!v) {
+    out[0] = out[1] = out[2] = 0;
+    return;
+  }
+  const uint32_t level = ((uint32_t)v * (hub75Brightness + 1)) >> 8;
+  const uint32_t base = paletteBase[rowBand[y] + colBand[x]];
+  out[0] = GAMMA_CIE[(((base >> 16) & 0xFF) * level + 127) / 255];
+  out[1] = GAMMA_CIE[(((base >> 8) & 0xFF) * level + 127) / 255];
+  out[2] = GAMMA_CIE[((base & 0xFF) * level + 127) / 255];
+}
+
+// Rebuild the colour bits of every plane for row address r (LED rows r and r + HUB75_ROWS)
+static void hub75ConvertRow(int r) {
+  uint8_t scratchTop[LED_MATRIX_W], scratchBottom[LED_MATRIX_W];
+  const uint8_t* top = fbRowBytes(fb[r], scratchTop);
+  const uint8_t* bottom = fbRowBytes(fb[r + HUB75_ROWS], scratchBottom);
+  for (int x = 0; x < LED_MATRIX_W; x++) {
+    uint8_t c[6];
+    hub75Rgb(x, r, top[x], c);
+    hub75Rgb(x, r + HUB75_ROWS, bottom[x], c + 3);
+    for (int b = 0; b < HUB75_PLANES; b++) {
+      const int shift = 8 - HUB75_PLANES + b;   // planes carry the top HUB75_PLANES bits
+      uint16_t bits = 0;
+      for (int k = 0; k < 6; k++) bits |= (uint16_t)(((c[k] >> shift) & 1) << k);
+      uint16_t& w = hub75.word(r, b, x);
+      w = (uint16_t)((w & ~HUB75_RGB_MASK) | bits);
+    }
+  }
+}
 
-      uint8_t r = (uint8_t)((baseR * (uint16_t)v) / 255);
-      uint8_t g = (uint8_t)((baseG * (uint16_t)v) / 255);
-      uint8_t b = (uint8_t)((baseB * (uint16_t)v) / 255);
+/**
+ * Bring the bit planes up to date with fb (render task, after renderFBToTFT(), which keeps the
+ * palette current). Palette or brightness changes rebuild every row.
+ */
+static void hub75Present() {
+  if (!hub75.ready()) return;
+  PerfScope ps(PERF_HUB75);
+  const uint8_t level = displayLevel.load(std::memory_order_relaxed);
+  const bool full = !hub75Valid || hub75PaletteGen != paletteGen || hub75Brightness != level;
+  hub75PaletteGen = paletteGen;
+  hub75Brightness = level;
+
+  for (int r = 0; r < HUB75_ROWS; r++) {
+    const int r2 = r + HUB75_ROWS;
+    if (!full && memcmp(fb[r], hub75Shown[r], sizeof(FbRow)) == 0 &&
+        memcmp(fb[r2], hub75Shown[r2], sizeof(FbRow)) == 0) continue;
+    hub75ConvertRow(r);
+    memcpy(hub75Shown[r], fb[r], sizeof(FbRow));
+    memcpy(hub75Shown[r2], fb[r2], sizeof(FbRow));
+    hub75RowsConverted++;
+  }
+  hub75Valid = true;
+}
+#endif
 
-      uint16_t colScaled = rgb888_to_565(((uint32_t)r << 16) | ((uint32_t)g << 8) | b);
+// =========================
+// Display backends
+// =========================
+// Every frame in fb goes to each started backend in turn (render task), so the TFT emulation and a
+// physical panel can run at the same time. The TFT is brought up by setup() itself (boot screens),
+// so it has no begin step.
+struct DisplayBackend {
+  const char* name;
+  bool (*begin)();     // nullptr = nothing to start; false = unavailable (skipped)
+  void (*present)();   // show fb
+};
 
-      tft.fillRect(x0 + x * pitch + inset, y0 + y * pitch + inset, dot, dot, colScaled);
-    }
+static const DisplayBackend DISPLAY_BACKENDS[] = {
+  {"TFT", nullptr, renderFBToTFT},
+#ifdef HUB75_ENABLE
+  {"HUB75", hub75Begin, hub75Present},
+#endif
+};
+static const size_t DISPLAY_BACKEND_COUNT = sizeof(DISPLAY_BACKENDS) / sizeof(DISPLAY_BACKENDS[0]);
+static bool backendActive[DISPLAY_BACKEND_COUNT];
+
+static void startDisplayBackends() {
+  for (size_t i = 0; i < DISPLAY_BACKEND_COUNT; i++) {
+    const DisplayBackend& b = DISPLAY_BACKENDS[i];
+    backendActive[i] = !b.begin || b.begin();
+    if (!backendActive[i]) DBG_WARN("Display backend %s unavailable\n", b.name);
   }
+}
 
-  drawStatusBar();
+static void presentFrame() {
+  for (size_t i = 0; i < DISPLAY_BACKEND_COUNT; i++) {
+    if (backendActive[i]) DISPLAY_BACKENDS[i].present();
+  }
 }
 
 
@@ -701,10 +1892,38 @@ static void loadConfig() {
   cfg.dateFormat = (uint8_t)prefs.getUChar("dfmt", 0);  // Default: YYYY-MM-DD
   cfg.ledDiameter = (uint8_t)prefs.getUChar("ledd", DEFAULT_LED_DIAMETER);
   cfg.ledGap = (uint8_t)prefs.getUChar("ledg", DEFAULT_LED_GAP);
+  cfg.ledShape = (uint8_t)prefs.getUChar("ledshp", DEFAULT_LED_SHAPE);
+  if (cfg.ledShape >= LED_SHAPE_COUNT) cfg.ledShape = DEFAULT_LED_SHAPE;
+  cfg.fontStyle = (uint8_t)prefs.getUChar("font", DEFAULT_FONT_STYLE);
+  if (cfg.fontStyle >= FONT_STYLE_COUNT) cfg.fontStyle = DEFAULT_FONT_STYLE;
+  cfg.morphStyle = (uint8_t)prefs.getUChar("morph", DEFAULT_MORPH_STYLE);
+  if (cfg.morphStyle >= MORPH_STYLE_COUNT) cfg.morphStyle = DEFAULT_MORPH_STYLE;
+  cfg.viewport = (uint8_t)prefs.getUChar("view", DEFAULT_VIEWPORT);
+  if (cfg.viewport >= VIEWPORT_COUNT) cfg.viewport = DEFAULT_VIEWPORT;
   cfg.ledColor = prefs.getUInt("col", 0xFF0000);
+  cfg.ledColor2 = prefs.getUInt("col2", 0x0000FF);
+  cfg.paletteMode = (uint8_t)prefs.getUChar("pal", PALETTE_SOLID);
+  if (cfg.paletteMode >= PALETTE_MODE_COUNT) cfg.paletteMode = PALETTE_SOLID;
   cfg.brightness = (uint8_t)prefs.getUChar("bl", 255);
+  cfg.dimMode = (uint8_t)prefs.getUChar("dim", DIM_MANUAL);
+  if (cfg.dimMode >= DIM_MODE_COUNT) cfg.dimMode = DIM_MANUAL;
+  cfg.nightBrightness = (uint8_t)prefs.getUChar("nbl", DEFAULT_NIGHT_BRIGHTNESS);
+  cfg.nightStart = (uint8_t)min<int>(prefs.getUChar("nstart", DEFAULT_NIGHT_START), 23);
+  cfg.nightEnd = (uint8_t)min<int>(prefs.getUChar("nend", DEFAULT_NIGHT_END), 23);
+  cfg.mirrorFps = (uint8_t)constrain(prefs.getUChar("mfps", MIRROR_DEFAULT_FPS), 1, MIRROR_MAX_FPS);
   cfg.flipDisplay = prefs.getBool("flip", false);
   cfg.useFahrenheit = prefs.getBool("useFahr", false);
+  cfg.powerSave = prefs.getBool("pwrsave", DEFAULT_POWER_SAVE);
+  cfg.nightBlank = prefs.getBool("nblank", DEFAULT_NIGHT_BLANK);
+  cfg.telemetryMode = (uint8_t)prefs.getUChar("tlm", TELEMETRY_OFF);
+  if (cfg.telemetryMode >= TELEMETRY_MODE_COUNT) cfg.telemetryMode = TELEMETRY_OFF;
+  s = prefs.getString("tlmhost", "");
+  strlcpy(cfg.telemetryHost, s.c_str(), sizeof(cfg.telemetryHost));
+  cfg.telemetryPort = prefs.getUShort("tlmport", 0);
+  cfg.telemetryInterval = (uint16_t)constrain(prefs.getUShort("tlmint", DEFAULT_TELEMETRY_INTERVAL_S),
+                                              TELEMETRY_MIN_INTERVAL_S, TELEMETRY_MAX_INTERVAL_S);
+  s = prefs.getString("tlmtopic", DEFAULT_TELEMETRY_TOPIC);
+  strlcpy(cfg.telemetryTopic, s.c_str(), sizeof(cfg.telemetryTopic));
   debugLevel = (uint8_t)prefs.getUChar("dbglvl", DEBUG_LEVEL);
 
   prefs.end();
@@ -713,31 +1932,125 @@ static void loadConfig() {
   DBG("  NTP: %s\n", cfg.ntp);
   DBG("  24h: %s\n", cfg.use24h ? "true" : "false");
   DBG("  DateFmt: %u\n", cfg.dateFormat);
+  DBG("  Font: %s  Morph: %u  Viewport: %u\n", FONTS[cfg.fontStyle].name, cfg.morphStyle, cfg.viewport);
   DBG("  Color: #%06X\n", (unsigned)cfg.ledColor);
-  DBG("  Brightness: %u\n", cfg.brightness);
+  DBG("  Color2: #%06X  PaletteMode: %u\n", (unsigned)cfg.ledColor2, cfg.paletteMode);
+  DBG("  Brightness: %u  DimMode: %u  Night: %u (%02u-%02u h)\n", cfg.brightness, cfg.dimMode,
+      cfg.nightBrightness, cfg.nightStart, cfg.nightEnd);
+  DBG("  MirrorFps: %u\n", cfg.mirrorFps);
   DBG("  FlipDisplay: %s\n", cfg.flipDisplay ? "true" : "false");
   DBG("  UseFahrenheit: %s\n", cfg.useFahrenheit ? "true" : "false");
+  DBG("  PowerSave: %s  NightBlank: %s\n", cfg.powerSave ? "true" : "false", cfg.nightBlank ? "true" : "false");
   DBG("  DebugLevel: %u\n", debugLevel);
+  DBG("  Telemetry: %u %s:%u every %u s\n", cfg.telemetryMode, cfg.telemetryHost, cfg.telemetryPort,
+      cfg.telemetryInterval);
 
   DBG_OK("Config loaded.");
 }
 
-static void saveConfig() {
+// Bit per persisted config key, so only changed keys are written (see markConfigDirty())
+enum ConfigKey : uint32_t {
+  CFG_KEY_TZ     = 1 << 0,
+  CFG_KEY_NTP    = 1 << 1,
+  CFG_KEY_24H    = 1 << 2,
+  CFG_KEY_DFMT   = 1 << 3,
+  CFG_KEY_LEDD   = 1 << 4,
+  CFG_KEY_LEDG   = 1 << 5,
+  CFG_KEY_LEDSHP = 1 << 6,
+  CFG_KEY_COL    = 1 << 7,
+  CFG_KEY_COL2   = 1 << 8,
+  CFG_KEY_PAL    = 1 << 9,
+  CFG_KEY_BL     = 1 << 10,
+  CFG_KEY_MFPS   = 1 << 11,
+  CFG_KEY_FLIP   = 1 << 12,
+  CFG_KEY_FAHR   = 1 << 13,
+  CFG_KEY_DBGLVL = 1 << 14,
+  CFG_KEY_FONT   = 1 << 15,
+  CFG_KEY_MORPH  = 1 << 16,
+  CFG_KEY_VIEW   = 1 << 17,
+  CFG_KEY_DIM    = 1 << 18,
+  CFG_KEY_NBL    = 1 << 19,
+  CFG_KEY_NSTART = 1 << 20,
+  CFG_KEY_NEND   = 1 << 21,
+  CFG_KEY_TLM    = 1 << 22,
+  CFG_KEY_TLMHST = 1 << 23,
+  CFG_KEY_TLMPRT = 1 << 24,
+  CFG_KEY_TLMINT = 1 << 25,
+  CFG_KEY_TLMTOP = 1 << 26,
+  CFG_KEY_PWR    = 1 << 27,
+  CFG_KEY_NBLANK = 1 << 28,
+  CFG_KEY_ALL    = (1 << 29) - 1
+};
+
+static uint32_t cfgDirtyKeys = 0;        // changed in RAM, not yet in NVS
+static uint32_t cfgDirtySince = 0;       // millis() of the last change (debounce start)
+static uint32_t nvsWrites = 0;           // individual key writes since boot
+static uint32_t nvsSaves = 0;            // prefs.begin/end sessions since boot
+
+/**
+ * Write config keys to NVS
+ * @param keys ConfigKey mask of keys to write (default: all)
+ */
+static void saveConfig(uint32_t keys = CFG_KEY_ALL) {
+  if (!keys) return;
   DBG_STEP("Saving config to NVS...");
+  uint32_t n = 0;
   prefs.begin("retroclock", false);
-  prefs.putString("tz", cfg.tz);
-  prefs.putString("ntp", cfg.ntp);
-  prefs.putBool("24h", cfg.use24h);
-  prefs.putUChar("dfmt", cfg.dateFormat);
-  prefs.putUChar("ledd", cfg.ledDiameter);
-  prefs.putUChar("ledg", cfg.ledGap);
-  prefs.putUInt("col", cfg.ledColor);
-  prefs.putUChar("bl", cfg.brightness);
-  prefs.putBool("flip", cfg.flipDisplay);
-  prefs.putBool("useFahr", cfg.useFahrenheit);
-  prefs.putUChar("dbglvl", debugLevel);
+  if (keys & CFG_KEY_TZ)     { prefs.putString("tz", cfg.tz); n++; }
+  if (keys & CFG_KEY_NTP)    { prefs.putString("ntp", cfg.ntp); n++; }
+  if (keys & CFG_KEY_24H)    { prefs.putBool("24h", cfg.use24h); n++; }
+  if (keys & CFG_KEY_DFMT)   { prefs.putUChar("dfmt", cfg.dateFormat); n++; }
+  if (keys & CFG_KEY_LEDD)   { prefs.putUChar("ledd", cfg.ledDiameter); n++; }
+  if (keys & CFG_KEY_LEDG)   { prefs.putUChar("ledg", cfg.ledGap); n++; }
+  if (keys & CFG_KEY_LEDSHP) { prefs.putUChar("ledshp", cfg.ledShape); n++; }
+  if (keys & CFG_KEY_COL)    { prefs.putUInt("col", cfg.ledColor); n++; }
+  if (keys & CFG_KEY_COL2)   { prefs.putUInt("col2", cfg.ledColor2); n++; }
+  if (keys & CFG_KEY_PAL)    { prefs.putUChar("pal", cfg.paletteMode); n++; }
+  if (keys & CFG_KEY_BL)     { prefs.putUChar("bl", cfg.brightness); n++; }
+  if (keys & CFG_KEY_MFPS)   { prefs.putUChar("mfps", cfg.mirrorFps); n++; }
+  if (keys & CFG_KEY_FLIP)   { prefs.putBool("flip", cfg.flipDisplay); n++; }
+  if (keys & CFG_KEY_FAHR)   { prefs.putBool("useFahr", cfg.useFahrenheit); n++; }
+  if (keys & CFG_KEY_DBGLVL) { prefs.putUChar("dbglvl", debugLevel); n++; }
+  if (keys & CFG_KEY_FONT)   { prefs.putUChar("font", cfg.fontStyle); n++; }
+  if (keys & CFG_KEY_MORPH)  { prefs.putUChar("morph", cfg.morphStyle); n++; }
+  if (keys & CFG_KEY_VIEW)   { prefs.putUChar("view", cfg.viewport); n++; }
+  if (keys & CFG_KEY_DIM)    { prefs.putUChar("dim", cfg.dimMode); n++; }
+  if (keys & CFG_KEY_NBL)    { prefs.putUChar("nbl", cfg.nightBrightness); n++; }
+  if (keys & CFG_KEY_NSTART) { prefs.putUChar("nstart", cfg.nightStart); n++; }
+  if (keys & CFG_KEY_NEND)   { prefs.putUChar("nend", cfg.nightEnd); n++; }
+  if (keys & CFG_KEY_TLM)    { prefs.putUChar("tlm", cfg.telemetryMode); n++; }
+  if (keys & CFG_KEY_TLMHST) { prefs.putString("tlmhost", cfg.telemetryHost); n++; }
+  if (keys & CFG_KEY_TLMPRT) { prefs.putUShort("tlmport", cfg.telemetryPort); n++; }
+  if (keys & CFG_KEY_TLMINT) { prefs.putUShort("tlmint", cfg.telemetryInterval); n++; }
+  if (keys & CFG_KEY_TLMTOP) { prefs.putString("tlmtopic", cfg.telemetryTopic); n++; }
+  if (keys & CFG_KEY_PWR)    { prefs.putBool("pwrsave", cfg.powerSave); n++; }
+  if (keys & CFG_KEY_NBLANK) { prefs.putBool("nblank", cfg.nightBlank); n++; }
   prefs.end();
-  DBG_OK("Config saved.");
+  nvsWrites += n;
+  nvsSaves++;
+  DBG_INFO("✓ Config saved (%u keys).\n", (unsigned)n);
+}
+
+// Record keys changed in RAM; they reach NVS once no change arrived for CONFIG_SAVE_DEBOUNCE_MS
+static void markConfigDirty(uint32_t keys) {
+  if (!keys) return;
+  cfgDirtyKeys |= keys;
+  cfgDirtySince = millis();
+}
+
+// Write pending keys now (explicit save, OTA, restart)
+static void flushConfig() {
+  CfgLock lock;
+  if (!cfgDirtyKeys) return;
+  const uint32_t keys = cfgDirtyKeys;
+  cfgDirtyKeys = 0;
+  saveConfig(keys);
+}
+
+// Called from loop(): persist pending keys after the quiet period
+static void configPersistTick() {
+  CfgLock lock;
+  if (cfgDirtyKeys && millis() - cfgDirtySince >= CONFIG_SAVE_DEBOUNCE_MS) flushConfig();
 }
 
 // =========================
@@ -757,142 +2070,234 @@ static void applyDisplayRotation() {
 // =========================
 // Sensor Functions
 // =========================
-/**
- * Test and initialize I2C sensor
- * @return true if sensor detected and working, false otherwise
- */
-static bool testSensor() {
-  Wire.begin(SENSOR_SDA_PIN, SENSOR_SCL_PIN);
-  DBG_STEP("Testing I2C sensor...");
-
-#ifdef USE_BME280
-  // Test BME280 sensor
-  if (!bme280.begin(0x76, &Wire)) {
-    DBG_WARN("BME280 sensor not found at 0x76\n");
-    if (!bme280.begin(0x77, &Wire)) {
-      DBG_WARN("BME280 sensor not found at 0x77 either\n");
-      return false;
-    }
+static void requestStatePush();  // Mirror stream section
+
+// Drivers are probed at boot; only the one that answers is allocated
+static Adafruit_BME280* bme280 = nullptr;
+static Adafruit_SHT31* sht3x = nullptr;
+static Adafruit_HTU21DF* htu21d = nullptr;
+
+static bool bme280Begin(uint8_t addr) {
+  if (!bme280) bme280 = new (std::nothrow) Adafruit_BME280();
+  if (!bme280 || !bme280->begin(addr, &Wire)) {  // begin() also checks the chip ID (rejects BMP280)
+    delete bme280;
+    bme280 = nullptr;
+    return false;
   }
+  bme280->setSampling(Adafruit_BME280::MODE_FORCED,
+                      Adafruit_BME280::SAMPLING_X1,
+                      Adafruit_BME280::SAMPLING_X1,
+                      Adafruit_BME280::SAMPLING_X1,
+                      Adafruit_BME280::FILTER_OFF);
+  return true;
+}
 
-  bme280.setSampling(Adafruit_BME280::MODE_FORCED,
-                     Adafruit_BME280::SAMPLING_X1,
-                     Adafruit_BME280::SAMPLING_X1,
-                     Adafruit_BME280::SAMPLING_X1,
-                     Adafruit_BME280::FILTER_OFF);
-
-  float temp = bme280.readTemperature();
-  float hum = bme280.readHumidity();
+static void bme280Read(float& temp, float& hum, float& pres) {
+  bme280->takeForcedMeasurement();
+  temp = bme280->readTemperature();
+  hum = bme280->readHumidity();
+  pres = bme280->readPressure() / 100.0F;
+}
 
-  if (isnan(temp) || isnan(hum) || temp < -50 || temp > 100 || hum < 0 || hum > 100) {
-    DBG_WARN("BME280 readings invalid\n");
+static bool sht3xBegin(uint8_t addr) {
+  if (!sht3x) sht3x = new (std::nothrow) Adafruit_SHT31(&Wire);
+  if (!sht3x || !sht3x->begin(addr)) {
+    delete sht3x;
+    sht3x = nullptr;
     return false;
   }
-
-  DBG_INFO("BME280 OK: %.1f°C, %.1f%%\n", temp, hum);
-  sensorType = "BME280";
   return true;
+}
 
-#elif defined(USE_SHT3X)
-  // Test SHT3X sensor
-  if (!sht3x.begin(0x44)) {  // Default I2C address for SHT3X
-    DBG_WARN("SHT3X sensor not found at 0x44\n");
-    if (!sht3x.begin(0x45)) {  // Alternative I2C address
-      DBG_WARN("SHT3X sensor not found at 0x45 either\n");
-      return false;
-    }
-  }
-
-  // Read initial values to verify sensor is working
-  float temp = sht3x.readTemperature();
-  float hum = sht3x.readHumidity();
+static void sht3xRead(float& temp, float& hum, float&) {
+  temp = sht3x->readTemperature();
+  hum = sht3x->readHumidity();
+}
 
-  if (isnan(temp) || isnan(hum) || temp < -50 || temp > 100 || hum < 0 || hum > 100) {
-    DBG_WARN("SHT3X readings invalid\n");
+static bool htu21dBegin(uint8_t) {
+  if (!htu21d) htu21d = new (std::nothrow) Adafruit_HTU21DF();
+  if (!htu21d || !htu21d->begin(&Wire)) {
+    delete htu21d;
+    htu21d = nullptr;
     return false;
   }
-
-  DBG_INFO("SHT3X OK: %.1f°C, %.1f%%\n", temp, hum);
-  sensorType = "SHT3X";
   return true;
+}
 
-#elif defined(USE_HTU21D)
-  // Test HTU21D sensor
-  if (!htu21d.begin()) {  // HTU21D uses fixed I2C address 0x40
-    DBG_WARN("HTU21D sensor not found at 0x40\n");
-    return false;
-  }
+static void htu21dRead(float& temp, float& hum, float&) {
+  temp = htu21d->readTemperature();
+  hum = htu21d->readHumidity();
+}
 
-  // Read initial values to verify sensor is working
-  float temp = htu21d.readTemperature();
-  float hum = htu21d.readHumidity();
+// Supported sensors, probed in this order (first address that ACKs and passes begin() wins)
+struct SensorDriver {
+  const char* name;
+  uint8_t addrs[2];                                     // candidate I2C addresses (0 = unused)
+  bool hasPressure;
+  bool (*begin)(uint8_t addr);                          // allocate + initialise at addr
+  void (*read)(float& temp, float& hum, float& pres);  // blocking read; NAN for unsupported values
+};
 
-  if (isnan(temp) || isnan(hum) || temp < -50 || temp > 100 || hum < 0 || hum > 100) {
-    DBG_WARN("HTU21D readings invalid\n");
-    return false;
-  }
+static const SensorDriver SENSOR_DRIVERS[] = {
+  {"BME280", {0x76, 0x77}, true,  bme280Begin, bme280Read},
+  {"SHT3X",  {0x44, 0x45}, false, sht3xBegin,  sht3xRead},
+  {"HTU21D", {0x40, 0x00}, false, htu21dBegin, htu21dRead},
+};
 
-  DBG_INFO("HTU21D OK: %.1f°C, %.1f%%\n", temp, hum);
-  sensorType = "HTU21D";
-  return true;
+static const SensorDriver* activeSensor = nullptr;
+
+// True if a device ACKs its address on the sensor bus
+static bool i2cProbe(uint8_t addr) {
+  Wire.beginTransmission(addr);
+  return Wire.endTransmission() == 0;
+}
 
+/**
+ * Probe the sensor bus and bind the first supported sensor found
+ * @return true if a sensor was detected and returned plausible readings
+ */
+static bool detectSensor() {
+#if HUB75_SENSOR_PIN_CONFLICT
+  DBG_WARN("I2C sensor pins drive the HUB75 panel, sensor probing skipped\n");
+  return false;
 #else
-  DBG_WARN("No sensor type defined in configuration\n");
+  Wire.begin(SENSOR_SDA_PIN, SENSOR_SCL_PIN);
+  DBG_STEP("Probing I2C sensors...");
+
+  for (const SensorDriver& d : SENSOR_DRIVERS) {
+    for (uint8_t addr : d.addrs) {
+      if (!addr || !i2cProbe(addr)) continue;
+      DBG_INFO("I2C device at 0x%02X, trying %s\n", addr, d.name);
+      if (!d.begin(addr)) {
+        DBG_WARN("%s init failed at 0x%02X\n", d.name, addr);
+        continue;
+      }
+
+      // Read initial values to verify sensor is working
+      float temp = NAN, hum = NAN, pres = NAN;
+      d.read(temp, hum, pres);
+      if (isnan(temp) || isnan(hum) || temp < -50 || temp > 100 || hum < 0 || hum > 100) {
+        DBG_WARN("%s readings invalid\n", d.name);
+        continue;
+      }
+
+      DBG_INFO("%s OK at 0x%02X: %.1f°C, %.1f%%\n", d.name, addr, temp, hum);
+      activeSensor = &d;
+      sensorType = d.name;
+      return true;
+    }
+  }
+
+  DBG_WARN("No supported sensor found (BME280 0x76/0x77, SHT3X 0x44/0x45, HTU21D 0x40)\n");
   return false;
 #endif
 }
 
+// Blocking driver read (sensor task only; the HTU21D/BME280 conversions take tens of ms)
+static void readSensorRaw(float& temp, float& hum, float& pres) {
+  temp = NAN;
+  hum = NAN;
+  pres = NAN;
+  if (activeSensor) activeSensor->read(temp, hum, pres);
+}
+
+// Median-of-3 (drops single-sample spikes) followed by an EMA, on values in tenths
+struct SensorFilter {
+  int16_t win[3];
+  uint8_t pos;    // next window slot
+  uint8_t n;      // samples seen (saturates at 3)
+  int32_t emaQ4;  // tenths << 4
+};
+
+static int16_t filterPush(SensorFilter& f, int16_t x10) {
+  f.win[f.pos] = x10;
+  f.pos = (uint8_t)((f.pos + 1) % 3);
+  if (f.n < 3) f.n++;
+  int16_t m = x10;
+  if (f.n == 3) {
+    const int16_t a = f.win[0], b = f.win[1], c = f.win[2];
+    m = std::max(std::min(a, b), std::min(std::max(a, b), c));
+  }
+  if (f.n == 1) f.emaQ4 = (int32_t)m << 4;
+  else f.emaQ4 += (((int32_t)m << 4) - f.emaQ4) >> SENSOR_EMA_SHIFT;
+  return (int16_t)((f.emaQ4 + (f.emaQ4 >= 0 ? 8 : -8)) / 16);
+}
+
+static SensorFilter filtTemp, filtHum, filtPres;
+
+// 24 h history: one filtered sample per SENSOR_HISTORY_PERIOD_MS as int16 offsets (tenths)
+static const int16_t SENSOR_HIST_NONE = INT16_MIN;
+static const int SENSOR_PRES_BASE = 1000;  // hPa; pressure is stored as tenths above/below this
+struct SensorSample {
+  int16_t t10;   // °C * 10
+  int16_t h10;   // %RH * 10
+  int16_t p10;   // (hPa - SENSOR_PRES_BASE) * 10
+};
+static SensorSample sensorHist[SENSOR_HISTORY_LEN];
+static uint16_t sensorHistHead = 0;   // next write slot
+static uint16_t sensorHistCount = 0;
+static uint32_t sensorHistLastMs = 0;
+static portMUX_TYPE sensorMux = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t sensorTaskHandle = nullptr;
+
+// Every filtered sample since the last telemetry message went out (newest TELEMETRY_BATCH_MAX), under sensorMux
+static SensorSample telemetryBatch[TELEMETRY_BATCH_MAX];
+static uint8_t telemetryBatchHead = 0;   // next write slot
+static uint8_t telemetryBatchCount = 0;
+static uint32_t telemetryBatchPushed = 0;   // samples pushed since boot
+
+// Telemetry task status (written by that task only, shown in /api/state)
+static uint32_t telemetrySent = 0;       // messages handed to the network stack
+static uint32_t telemetryErrors = 0;     // failed resolves, connects and sends
+static bool telemetryLinkUp = false;     // MQTT: broker connection open; UDP: last send succeeded
+static char telemetryId[16] = "";        // "rc-" + the last three MAC bytes (message "id", MQTT client id)
+
+static int tenthsToInt(int16_t x10) { return (int)lroundf(x10 / 10.0f); }
+
 /**
- * Update sensor readings from I2C sensor
+ * Take one sample, filter it, publish the readings and extend the history
  */
 static void updateSensorData() {
   if (!sensorAvailable) return;
 
-  float temp = NAN;
-  float hum = NAN;
-  float pres = NAN;
-
-#ifdef USE_BME280
-  // Read BME280 sensor
-  bme280.takeForcedMeasurement();
-  temp = bme280.readTemperature();
-  hum = bme280.readHumidity();
-  pres = bme280.readPressure() / 100.0F;
-
-#elif defined(USE_SHT3X)
-  // Read SHT3X sensor
-  temp = sht3x.readTemperature();
-  hum = sht3x.readHumidity();
-  // SHT3X doesn't have a pressure sensor, so pressure remains NAN
-
-#elif defined(USE_HTU21D)
-  // Read HTU21D sensor
-  temp = htu21d.readTemperature();
-  hum = htu21d.readHumidity();
-  // HTU21D doesn't have a pressure sensor, so pressure remains NAN
-#endif
-
-  // Update temperature if valid
-  if (!isnan(temp) && temp >= -50 && temp <= 100) {
-    temperature = (int)round(temp);
-  }
-
-  // Update humidity if valid
-  if (!isnan(hum) && hum >= 0 && hum <= 100) {
-    humidity = (int)round(hum);
-  }
+  float temp, hum, pres;
+  readSensorRaw(temp, hum, pres);
 
-  // Update pressure if valid (only for BME280)
+  SensorSample s = {SENSOR_HIST_NONE, SENSOR_HIST_NONE, SENSOR_HIST_NONE};
+  if (!isnan(temp) && temp >= -50 && temp <= 100) s.t10 = filterPush(filtTemp, (int16_t)lroundf(temp * 10));
+  if (!isnan(hum) && hum >= 0 && hum <= 100) s.h10 = filterPush(filtHum, (int16_t)lroundf(hum * 10));
+  // Pressure only for BME280
   if (!isnan(pres) && pres >= 800 && pres <= 1200) {
-    pressure = (int)round(pres);
+    s.p10 = filterPush(filtPres, (int16_t)lroundf((pres - SENSOR_PRES_BASE) * 10));
   }
 
-  // Output sensor readings to serial (always at INFO level for visibility)
-  if (sensorAvailable && debugLevel >= DBG_LEVEL_INFO) {
+  const int oldTemp = temperature, oldHum = humidity, oldPres = pressure;
+  const uint32_t now = millis();
+  portENTER_CRITICAL(&sensorMux);
+  if (s.t10 != SENSOR_HIST_NONE) temperature = tenthsToInt(s.t10);
+  if (s.h10 != SENSOR_HIST_NONE) humidity = tenthsToInt(s.h10);
+  if (s.p10 != SENSOR_HIST_NONE) pressure = SENSOR_PRES_BASE + tenthsToInt(s.p10);
+  if (sensorHistCount == 0 || now - sensorHistLastMs >= SENSOR_HISTORY_PERIOD_MS) {
+    sensorHistLastMs = now;
+    sensorHist[sensorHistHead] = s;
+    sensorHistHead = (uint16_t)((sensorHistHead + 1) % SENSOR_HISTORY_LEN);
+    if (sensorHistCount < SENSOR_HISTORY_LEN) sensorHistCount++;
+  }
+  telemetryBatch[telemetryBatchHead] = s;
+  telemetryBatchHead = (uint8_t)((telemetryBatchHead + 1) % TELEMETRY_BATCH_MAX);
+  if (telemetryBatchCount < TELEMETRY_BATCH_MAX) telemetryBatchCount++;
+  telemetryBatchPushed++;
+  portEXIT_CRITICAL(&sensorMux);
+
+  if (temperature == oldTemp && humidity == oldHum && pressure == oldPres) return;
+  markStatusDirty(STATUS_DIRTY_SENSOR | STATUS_DIRTY_EXTRA);
+  requestStatePush();
+
+  // Output sensor readings to serial when the displayed value changes (INFO level for visibility)
+  if (debugLevel >= DBG_LEVEL_INFO) {
     int displayTemp = cfg.useFahrenheit ? (temperature * 9 / 5 + 32) : temperature;
     const char* unit = cfg.useFahrenheit ? "F" : "C";
 
-#ifdef USE_BME280
     if (pressure > 0) {
       DBG_INFO("Sensor Update - %s: %d°%s, Humidity: %d%%, Pressure: %d hPa\n",
                sensorType, displayTemp, unit, humidity, pressure);
@@ -900,108 +2305,374 @@ static void updateSensorData() {
       DBG_INFO("Sensor Update - %s: %d°%s, Humidity: %d%%\n",
                sensorType, displayTemp, unit, humidity);
     }
-#else
-    DBG_INFO("Sensor Update - %s: %d°%s, Humidity: %d%%\n",
-             sensorType, displayTemp, unit, humidity);
-#endif
   }
 }
 
-// =========================
-// Time / NTP
-// =========================
 /**
- * Lookup timezone POSIX string from timezone name
- * @param tzName Timezone name (e.g., "Sydney, Australia")
- * @return POSIX timezone string, or "UTC0" if not found
+ * Copy the history oldest-first
+ * @param out Destination (SENSOR_HISTORY_LEN entries)
+ * @param newestAgeMs Set to the age of the newest sample
+ * @return Number of samples copied
  */
-static const char* lookupTimezone(const char* tzName) {
-  if (!tzName || !tzName[0]) return timezones[0].tzString;  // Default to Sydney
-
-  // Search for timezone by name
-  for (int i = 0; i < numTimezones; i++) {
-    if (strcmp(tzName, timezones[i].name) == 0) {
-      return timezones[i].tzString;
-    }
-  }
-
-  // If not found, return first (default)
-  DBG_WARN("Timezone '%s' not found, using default\n", tzName);
-  return timezones[0].tzString;
+static uint16_t copySensorHistory(SensorSample* out, uint32_t& newestAgeMs) {
+  portENTER_CRITICAL(&sensorMux);
+  const uint16_t n = sensorHistCount;
+  const uint16_t first = (uint16_t)((sensorHistHead + SENSOR_HISTORY_LEN - n) % SENSOR_HISTORY_LEN);
+  for (uint16_t i = 0; i < n; i++) out[i] = sensorHist[(first + i) % SENSOR_HISTORY_LEN];
+  newestAgeMs = millis() - sensorHistLastMs;
+  portEXIT_CRITICAL(&sensorMux);
+  return n;
 }
 
-static void startNtp() {
-  DBG_STEP("Starting NTP...");
-  const char* tzEnv = lookupTimezone(cfg.tz);
+// Probe the bus and take the first reading
+static void sensorBringUp() {
+  sensorAvailable = detectSensor();
+  if (sensorAvailable) {
+    updateSensorData();
+    lastSensorUpdate = millis();
+    DBG_OK("Sensor initialized and reading.");
+    // Green flash for sensor found
+    flashRGBLed(0, 1, 0);
+  } else {
+    DBG_WARN("No sensor detected. Temperature/humidity features disabled.");
+    // Yellow flash (red+green) for no sensor
+    flashRGBLed(1, 1, 0);
+  }
+  bootMark("sensor");
+}
+
+// Probes and samples the sensor off loop() so slow I2C init and conversions never stall boot, HTTP,
+// OTA or the clock. Exits if nothing answers the probe.
+static void sensorTask(void*) {
+  sensorBringUp();
+  if (!sensorAvailable) {
+    sensorTaskHandle = nullptr;
+    vTaskDelete(nullptr);
+  }
+  TickType_t lastWake = xTaskGetTickCount();
+  for (;;) {
+    vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(SENSOR_UPDATE_INTERVAL));
+    PerfScope ps(PERF_SENSOR);
+    updateSensorData();
+  }
+}
+
+static void startSensorTask() {
+  BaseType_t ok = xTaskCreatePinnedToCore(sensorTask, "sensor", SENSOR_TASK_STACK, nullptr,
+                                          SENSOR_TASK_PRIO, &sensorTaskHandle, SENSOR_TASK_CORE);
+  if (ok != pdPASS) {
+    sensorTaskHandle = nullptr;
+    DBG_WARN("Sensor task create failed, sampling from loop()\n");
+    sensorBringUp();
+  }
+}
+
+// =========================
+// Time / NTP
+// =========================
+/**
+ * Lookup timezone POSIX string from timezone name
+ * @param tzName Timezone name (e.g., "Sydney, Australia")
+ * @return POSIX timezone string, or "UTC0" if not found
+ */
+static const char* lookupTimezone(const char* tzName) {
+  if (!tzName || !tzName[0]) return timezones[0].tzString;  // Default to Sydney
+
+  // Search for timezone by name
+  for (int i = 0; i < numTimezones; i++) {
+    if (strcmp(tzName, timezones[i].name) == 0) {
+      return timezones[i].tzString;
+    }
+  }
+
+  // If not found, return first (default)
+  DBG_WARN("Timezone '%s' not found, using default\n", tzName);
+  return timezones[0].tzString;
+}
+
+// =========================
+// Clock service
+// =========================
+/**
+ * Non-blocking wall clock. clockServiceTick() (loop) refreshes a cached broken-down time once per
+ * second from time() + localtime_r(); every other caller reads the cache through clockNow(), so
+ * nothing ever waits for SNTP. Sync events arrive via onSntpSync() on the lwIP task and only touch
+ * atomics.
+ */
+struct ClockSnapshot {
+  struct tm tm;   // local time (valid only if .valid)
+  time_t epoch;   // UTC seconds
+  bool valid;     // wall clock has been set (SNTP now or earlier, RTC kept across soft reset)
+  bool synced;    // SNTP has completed at least one sync since boot
+};
+
+// Epochs before this mean the RTC was never set (2021-01-01T00:00:00Z)
+static const time_t CLOCK_VALID_EPOCH = 1609459200;
+
+static ClockSnapshot clockCache = {};
+static portMUX_TYPE clockCacheMux = portMUX_INITIALIZER_UNLOCKED;
+static std::atomic<bool> sntpSynced{false};
+static std::atomic<uint32_t> sntpSyncCount{0};
+
+static void onSntpSync(struct timeval* tv) {
+  (void)tv;
+  sntpSynced.store(true);
+  sntpSyncCount.fetch_add(1);
+}
+
+/**
+ * Refresh the cached time if the second changed (call every loop pass; never blocks)
+ * @return true when a new second was cached
+ */
+static bool clockServiceTick() {
+  const time_t now = time(nullptr);
+  if (now == clockCache.epoch) return false;
+
+  ClockSnapshot next = {};
+  next.epoch = now;
+  next.valid = now >= CLOCK_VALID_EPOCH;
+  next.synced = sntpSynced.load();
+  if (next.valid) localtime_r(&now, &next.tm);
+
+  portENTER_CRITICAL(&clockCacheMux);
+  clockCache = next;
+  portEXIT_CRITICAL(&clockCacheMux);
+
+  // Deferred from onSntpSync(), which runs on the lwIP task
+  static uint32_t loggedSyncs = 0;
+  const uint32_t syncs = sntpSyncCount.load();
+  if (syncs != loggedSyncs) {
+    if (loggedSyncs == 0) {
+      DBG_INFO("[TIME] SNTP synced (%s)\n", cfg.ntp);
+      bootMark("timeSynced");
+    } else {
+      DBG_VERBOSE("[TIME] SNTP resync #%u\n", (unsigned)syncs);
+    }
+    loggedSyncs = syncs;
+  }
+  return true;
+}
+
+// Force the next tick to recompute local time (timezone changed)
+static void clockServiceInvalidate() {
+  portENTER_CRITICAL(&clockCacheMux);
+  clockCache.epoch = 0;
+  portEXIT_CRITICAL(&clockCacheMux);
+}
+
+// Latest cached time; safe from any task
+static ClockSnapshot clockNow() {
+  portENTER_CRITICAL(&clockCacheMux);
+  ClockSnapshot c = clockCache;
+  portEXIT_CRITICAL(&clockCacheMux);
+  return c;
+}
+
+// Last synced epoch in NVS ("epoch"): after a power loss the RTC starts from zero, so setup() seeds
+// the clock from it and the display shows an estimate until SNTP answers. Soft resets keep the RTC
+// time and skip the seed.
+static bool timeFromCache = false;   // clock was seeded from NVS at boot (until SNTP overrides it)
+
+static void timeCacheSeed() {
+  if (time(nullptr) >= CLOCK_VALID_EPOCH) return;
+  prefs.begin("retroclock", true);
+  const uint32_t saved = prefs.getUInt("epoch", 0);
+  prefs.end();
+  if (saved < (uint32_t)CLOCK_VALID_EPOCH) return;
+  struct timeval tv = {(time_t)saved, 0};
+  settimeofday(&tv, nullptr);
+  timeFromCache = true;
+  DBG_INFO("[TIME] Seeded from NVS: %lu (estimate until SNTP sync)\n", (unsigned long)saved);
+}
+
+// Called from loop(): store the time after the first sync, then every TIME_CACHE_SAVE_MS
+static void timeCacheTick() {
+  static bool saved = false;
+  static uint32_t lastSave = 0;
+  const ClockSnapshot clk = clockNow();
+  if (!clk.synced) return;
+  const uint32_t now = millis();
+  if (saved && now - lastSave < TIME_CACHE_SAVE_MS) return;
+  saved = true;
+  lastSave = now;
+
+  CfgLock lock;   // prefs is shared with saveConfig()
+  prefs.begin("retroclock", false);
+  prefs.putUInt("epoch", (uint32_t)clk.epoch);
+  prefs.end();
+  nvsWrites++;
+  nvsSaves++;
+  DBG_VERBOSE("[TIME] Cached %lu in NVS\n", (unsigned long)clk.epoch);
+}
+
+static void startNtp() {
+  DBG_STEP("Starting NTP...");
+  const char* tzEnv = lookupTimezone(cfg.tz);
   DBG_INFO("Timezone: %s -> %s\n", cfg.tz, tzEnv);
+  sntp_set_time_sync_notification_cb(onSntpSync);
   configTzTime(tzEnv, cfg.ntp);
+  ntpStarted.store(true);
+  clockServiceInvalidate();
   DBG_OK("NTP configured.");
 
   // Green flash on successful NTP config
   flashRGBLed(0, 1, 0);
 }
 
-static bool getLocalTimeSafe(struct tm& timeinfo, uint32_t timeoutMs = 2000) {
-  uint32_t start = millis();
-  while ((millis() - start) < timeoutMs) {
-    if (getLocalTime(&timeinfo, 50)) return true;
-    delay(10);
-  }
-  return false;
-}
-
 // =========================
 // Web handlers
 // =========================
 // Forward declaration (defined later in Clock logic section)
 static void formatDate(struct tm& ti, char* out, size_t n);
+// Forward declarations (defined later in Mirror stream section)
+static void copyMirrorFrame(uint8_t* out);
+static uint16_t copyMirrorFrames(uint8_t* out, uint8_t* base, uint16_t ackSeq, bool* hasBase);
+
+// Timezone list cache: the /api/timezones JSON is constant for a given firmware, so it is written once to LittleFS
+// (TZ_CACHE_DIR/<etag>.json, streamed straight to the file without a JSON document) and then served
+// with an ETag. Browsers revalidate and get 304s; nothing is rebuilt on the heap per request.
+static char tzEtag[12] = "";    // quoted FNV-1a of the table, e.g. "\"1a2b3c4d\""
+static char tzCachePath[40] = "";
+static bool tzCacheReady = false;
+
+// Print adapter that forwards to server.sendContent() in TZ_STREAM_CHUNK pieces
+class ChunkedResponse : public Print {
+ public:
+  size_t write(uint8_t c) override {
+    buf[len++] = (char)c;
+    if (len == sizeof(buf)) flush();
+    return 1;
+  }
+  void flush() {
+    if (len) server.sendContent(buf, len);
+    len = 0;
+  }
+ private:
+  char buf[TZ_STREAM_CHUNK];
+  size_t len = 0;
+};
 
-static void handleGetTimezones() {
-  DBG_VERBOSE("Web: GET /api/timezones from %s\n", server.client().remoteIP().toString().c_str());
-
-  JsonDocument doc;
-  JsonArray regions = doc["regions"].to<JsonArray>();
+// Write a JSON string literal (timezone names and POSIX strings contain no control characters)
+static void writeJsonString(Print& out, const char* s) {
+  out.write('"');
+  for (; *s; s++) {
+    if (*s == '"' || *s == '\\') out.write('\\');
+    out.write((uint8_t)*s);
+  }
+  out.write('"');
+}
 
-  // Define region boundaries (indices from timezones.h)
-  struct Region {
-    const char* name;
-    int start;
-    int end;
-  };
+/**
+ * Serialize the timezone table grouped by region (same shape the web UI has always used):
+ * {"regions":[{"name":..,"timezones":[{"name":..,"tz":..},..]},..],"count":N}
+ * Regions come from each entry's TimezoneInfo::region, in TimezoneRegion order.
+ */
+static void writeTimezonesJson(Print& out) {
+  out.print("{\"regions\":[");
+  bool firstRegion = true;
+  for (uint8_t r = 0; r < TZR_COUNT; r++) {
+    bool firstTz = true;
+    for (int i = 0; i < numTimezones; i++) {
+      if (timezones[i].region != r) continue;
+      if (firstTz) {
+        if (!firstRegion) out.write(',');
+        out.print("{\"name\":");
+        writeJsonString(out, timezoneRegionNames[r]);
+        out.print(",\"timezones\":[");
+        firstRegion = false;
+      } else {
+        out.write(',');
+      }
+      firstTz = false;
+      out.print("{\"name\":");
+      writeJsonString(out, timezones[i].name);
+      out.print(",\"tz\":");
+      writeJsonString(out, timezones[i].tzString);
+      out.write('}');
+    }
+    if (!firstTz) out.print("]}");
+  }
+  out.printf("],\"count\":%d}", numTimezones);
+}
 
-  const Region regionDefs[] = {
-    {"Australia & Oceania", 0, 11},
-    {"North America", 12, 22},
-    {"South America", 23, 28},
-    {"Western Europe", 29, 39},
-    {"Northern Europe", 40, 43},
-    {"Central & Eastern Europe", 44, 51},
-    {"Middle East", 52, 56},
-    {"South Asia", 57, 63},
-    {"Southeast Asia", 64, 70},
-    {"East Asia", 71, 76},
-    {"Central Asia", 77, 79},
-    {"Caucasus", 80, 82},
-    {"Africa", 83, 86}
-  };
+/**
+ * Compute the table ETag and make sure the cached JSON file for it exists
+ * (stale files from older firmware are removed). Called once from setup().
+ */
+static void initTimezoneCache() {
+  uint32_t h = 2166136261u;
+  auto mix = [&h](const char* s) { for (; *s; s++) { h ^= (uint8_t)*s; h *= 16777619u; } h ^= 0xFF; h *= 16777619u; };
+  for (uint8_t r = 0; r < TZR_COUNT; r++) mix(timezoneRegionNames[r]);
+  for (int i = 0; i < numTimezones; i++) {
+    mix(timezones[i].name);
+    mix(timezones[i].tzString);
+    h ^= timezones[i].region;
+    h *= 16777619u;
+  }
+  snprintf(tzEtag, sizeof(tzEtag), "\"%08x\"", (unsigned)h);
+  snprintf(tzCachePath, sizeof(tzCachePath), "%s/%08x.json", TZ_CACHE_DIR, (unsigned)h);
 
-  for (const auto& region : regionDefs) {
-    JsonObject regionObj = regions.add<JsonObject>();
-    regionObj["name"] = region.name;
-    JsonArray tzArray = regionObj["timezones"].to<JsonArray>();
+  if (LittleFS.exists(tzCachePath)) {
+    tzCacheReady = true;
+    DBG_OK("Timezone cache present.");
+    return;
+  }
 
-    for (int i = region.start; i <= region.end && i < numTimezones; i++) {
-      JsonObject tz = tzArray.add<JsonObject>();
-      tz["name"] = timezones[i].name;
-      tz["tz"] = timezones[i].tzString;
+  // Drop caches written by other firmware versions
+  if (!LittleFS.exists(TZ_CACHE_DIR)) LittleFS.mkdir(TZ_CACHE_DIR);
+  File dir = LittleFS.open(TZ_CACHE_DIR);
+  if (dir) {
+    File f = dir.openNextFile();
+    while (f) {
+      String stale = String(TZ_CACHE_DIR) + "/" + f.name();
+      f.close();
+      LittleFS.remove(stale);
+      f = dir.openNextFile();
     }
   }
 
-  doc["count"] = numTimezones;
+  File f = LittleFS.open(tzCachePath, "w");
+  if (!f) {
+    DBG_WARN("Timezone cache: cannot write %s, streaming from flash tables\n", tzCachePath);
+    return;
+  }
+  writeTimezonesJson(f);
+  const size_t size = f.size();
+  f.close();
+  tzCacheReady = true;
+  DBG_INFO("Timezone cache written: %s (%u bytes)\n", tzCachePath, (unsigned)size);
+}
 
-  String out;
-  serializeJson(doc, out);
-  server.send(200, "application/json", out);
+/**
+ * GET /api/timezones
+ * Served from the LittleFS cache with ETag (304 when the browser already has it); falls back to
+ * chunked streaming from the const table if the cache could not be written.
+ */
+static void handleGetTimezones() {
+  DBG_VERBOSE("Web: GET /api/timezones from %s\n", server.client().remoteIP().toString().c_str());
+
+  server.sendHeader("ETag", tzEtag);
+  server.sendHeader("Cache-Control", "no-cache");  // always revalidate; body only when the ETag changed
+  if (tzEtag[0] && server.header("If-None-Match") == tzEtag) {
+    server.send(304);
+    return;
+  }
+
+  if (tzCacheReady) {
+    File f = LittleFS.open(tzCachePath, "r");
+    if (f) {
+      server.streamFile(f, "application/json");
+      f.close();
+      return;
+    }
+  }
+
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.send(200, "application/json", "");
+  ChunkedResponse out;
+  writeTimezonesJson(out);
+  out.flush();
+  server.sendContent("");
 }
 
 /**
@@ -1015,6 +2686,7 @@ static void handleResetWiFi() {
   DBG_INFO("Web: POST /api/reset-wifi from %s\n", clientIP.c_str());
 
   server.send(200, "application/json", "{\"status\":\"WiFi reset initiated. Device will restart...\"}");
+  flushConfig();
 
   delay(1000);
 
@@ -1027,41 +2699,53 @@ static void handleResetWiFi() {
 }
 
 /**
- * GET /api/state
- *
- * Returns comprehensive system state as JSON for web interface.
- *
- * Response includes:
- * - Time & Network: current time, date, WiFi SSID, IP address
- * - Configuration: timezone, NTP server, time format, date format, LED settings, brightness, debug level
- * - System Diagnostics: uptime (seconds), free heap, total heap size, CPU frequency
- * - Hardware Info: board type, display model, sensor status, firmware version, OTA status
- *
- * This endpoint is polled by the web interface every second to update:
- * - Live clock display
- * - System diagnostics panel
- * - Configuration field values
- * - Display mirror state
+ * POST /api/wake - show the clock for POWER_WAKE_MS while night blank is in effect
  */
-static void handleGetState() {
-  DBG_VERBOSE("Web: GET /api/state from %s\n", server.client().remoteIP().toString().c_str());
+static void handlePostWake() {
+  DBG_INFO("Web: POST /api/wake from %s\n", server.client().remoteIP().toString().c_str());
+  powerWake();
+  requestStatePush();
+  server.send(200, "application/json", "{\"ok\":true}");
+}
+
+// High-water mark of the state JSON arenas (bytes, /api/perf); raised by the HTTP task and loop()
+static std::atomic<size_t> stateArenaPeak{0};
+
+static void noteStateArenaPeak(size_t bytes) {
+  size_t cur = stateArenaPeak.load(std::memory_order_relaxed);
+  while (bytes > cur && !stateArenaPeak.compare_exchange_weak(cur, bytes, std::memory_order_relaxed)) {}
+}
 
-  struct tm ti{};
-  bool ok = getLocalTimeSafe(ti, 300);
+// Share of free heap that is not usable as one block, in percent (0 = a single free region)
+static uint8_t heapFragPct() {
+  const size_t freeBytes = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+  const size_t largest = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+  return freeBytes ? (uint8_t)(100 - largest * 100 / freeBytes) : 0;
+}
+
+/**
+ * Fill doc with the full device state (shared by GET /api/state and the mirror stream)
+ * @param doc Destination document
+ */
+static void buildStateJson(JsonDocument& doc) {
+  CfgLock lock;
+  ClockSnapshot clk = clockNow();
   char tbuf[16] = "--:--:--";
   char dbuf[16] = "----/--/--";
-  if (ok) {
-    strftime(tbuf, sizeof(tbuf), "%H:%M:%S", &ti);
-    formatDate(ti, dbuf, sizeof(dbuf));  // Use configured date format
+  if (clk.valid) {
+    strftime(tbuf, sizeof(tbuf), "%H:%M:%S", &clk.tm);
+    formatDate(clk.tm, dbuf, sizeof(dbuf));  // Use configured date format
   }
 
-  JsonDocument doc;
-
   // Time & Network
   doc["time"] = tbuf;
   doc["date"] = dbuf;
-  doc["wifi"] = (WiFi.isConnected() ? WiFi.SSID() : String("DISCONNECTED"));
-  doc["ip"] = WiFi.isConnected() ? WiFi.localIP().toString() : String("0.0.0.0");
+  doc["timeSynced"] = clk.synced;
+  doc["timeSource"] = clk.synced ? "ntp" : timeFromCache ? "cache" : clk.valid ? "rtc" : "none";
+  char ssid[sizeof(netSsid)], ip[sizeof(netIp)];
+  netInfo(ssid, sizeof(ssid), ip, sizeof(ip));
+  doc["wifi"] = ssid;
+  doc["ip"] = ip;
 
   // Config
   doc["tz"] = cfg.tz;
@@ -1070,20 +2754,57 @@ static void handleGetState() {
   doc["dateFormat"] = cfg.dateFormat;
   doc["ledDiameter"] = cfg.ledDiameter;
   doc["ledGap"] = cfg.ledGap;
+  doc["ledShape"] = cfg.ledShape;
+  doc["fontStyle"] = cfg.fontStyle;
+  doc["morphStyle"] = cfg.morphStyle;
+  doc["viewport"] = cfg.viewport;
   doc["ledColor"] = cfg.ledColor;
+  doc["ledColor2"] = cfg.ledColor2;
+  doc["paletteMode"] = cfg.paletteMode;
   doc["brightness"] = cfg.brightness;
+  doc["dimMode"] = cfg.dimMode;
+  doc["nightBrightness"] = cfg.nightBrightness;
+  doc["nightStart"] = cfg.nightStart;
+  doc["nightEnd"] = cfg.nightEnd;
+  doc["ambient"] = ambientLevel.load(std::memory_order_relaxed);
+  doc["ambientRaw"] = ambientRaw.load(std::memory_order_relaxed);
+  doc["displayLevel"] = displayLevel.load(std::memory_order_relaxed);
+  doc["paletteLevel"] = paletteLevel.load(std::memory_order_relaxed);
+  doc["powerSave"] = cfg.powerSave;
+  doc["nightBlank"] = cfg.nightBlank;
+  doc["blanked"] = displayBlank.load(std::memory_order_relaxed);
+  doc["mirrorFps"] = cfg.mirrorFps;
+
+  // Palette band colors + cell boundaries so the web mirror can reproduce multi-color modes
+  JsonArray palColors = doc["paletteColors"].to<JsonArray>();
+  for (int i = 0; i < PALETTE_BANDS; i++) palColors.add(paletteBase[i]);
+  JsonArray palCells = doc["paletteCells"].to<JsonArray>();
+  for (int i = 0; i <= dirtyCellCount; i++) palCells.add(dirtyCellX[i]);
   doc["flipDisplay"] = cfg.flipDisplay;
 
+  // Matrix size and the part of it shown on the TFT, so the web mirror can show the same view
+  doc["matrixW"] = LED_MATRIX_W;
+  doc["matrixH"] = LED_MATRIX_H;
+  const LayoutBox view = computeViewport(computeLayout(activeFont()));
+  JsonArray viewBox = doc["view"].to<JsonArray>();
+  viewBox.add(view.x);
+  viewBox.add(view.y);
+  viewBox.add(view.w);
+  viewBox.add(view.h);
+
   // System diagnostics
   uint32_t uptime = millis() / 1000;  // seconds
   doc["uptime"] = uptime;
   doc["freeHeap"] = ESP.getFreeHeap();
   doc["heapSize"] = ESP.getHeapSize();
+  doc["heapMinFree"] = ESP.getMinFreeHeap();
+  doc["heapLargest"] = (uint32_t)heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+  doc["heapFrag"] = heapFragPct();
   doc["cpuFreq"] = ESP.getCpuFreqMHz();
   doc["debugLevel"] = debugLevel;
 
   // Sensor data
-  doc["sensorAvailable"] = sensorAvailable;
+  doc["sensorAvailable"] = sensorAvailable.load();
   doc["sensorType"] = sensorType;
   doc["temperature"] = temperature;
   doc["humidity"] = humidity;
@@ -1095,25 +2816,71 @@ static void handleGetState() {
   doc["display"] = "320×240 ILI9341";
 
   // Build sensor info string
-  String sensorInfo;
+  char sensorInfo[40];
   if (sensorAvailable) {
-    sensorInfo = String(sensorType);
-#ifdef USE_BME280
-    sensorInfo += " (Temp/Humid/Press)";
-#else
-    sensorInfo += " (Temp/Humid)";
-#endif
+    snprintf(sensorInfo, sizeof(sensorInfo), "%s %s", sensorType,
+             (activeSensor && activeSensor->hasPressure) ? "(Temp/Humid/Press)" : "(Temp/Humid)");
   } else {
-    sensorInfo = "None detected";
+    strlcpy(sensorInfo, "None detected", sizeof(sensorInfo));
   }
   doc["sensors"] = sensorInfo;
 
   doc["firmware"] = FIRMWARE_VERSION;
   doc["otaEnabled"] = true;
 
-  String out;
-  serializeJson(doc, out);
-  server.send(200, "application/json", out);
+  // Telemetry push
+  doc["telemetryMode"] = cfg.telemetryMode;
+  doc["telemetryHost"] = cfg.telemetryHost;
+  doc["telemetryPort"] = cfg.telemetryPort;
+  doc["telemetryInterval"] = cfg.telemetryInterval;
+  doc["telemetryTopic"] = cfg.telemetryTopic;
+  doc["telemetryId"] = telemetryId;
+  doc["telemetrySent"] = telemetrySent;
+  doc["telemetryErrors"] = telemetryErrors;
+  doc["telemetryLinkUp"] = telemetryLinkUp;
+}
+
+/**
+ * GET /api/state
+ *
+ * Returns comprehensive system state as JSON for web interface.
+ *
+ * Response includes:
+ * - Time & Network: current time, date, timeSynced, timeSource, WiFi SSID, IP address
+ * - Configuration: timezone, NTP server, time format, date format, LED settings, brightness, debug level
+ * - System Diagnostics: uptime (seconds), free heap, total heap size, CPU frequency
+ * - Hardware Info: board type, display model, sensor status, firmware version, OTA status
+ *
+ * ?fmt=bin returns the same document as MessagePack (application/msgpack) for fleet pollers.
+ * Built in a static arena and serialized into a static buffer: no heap allocation per request.
+ *
+ * The web interface polls this every second when the mirror stream is unavailable, to update:
+ * - Live clock display
+ * - System diagnostics panel
+ * - Configuration field values
+ * - Display mirror state
+ */
+static void handleGetState() {
+  DBG_VERBOSE("Web: GET /api/state from %s\n", server.client().remoteIP().toString().c_str());
+
+  // Arena and output buffer are static: a poll costs no heap (HTTP task only)
+  alignas(8) static uint8_t arenaMem[STATE_JSON_ARENA];
+  static ArenaAllocator arena(arenaMem, sizeof(arenaMem));
+  static char out[STATE_JSON_MAX];
+
+  arena.reset();
+  JsonDocument doc(&arena);
+  buildStateJson(doc);
+  noteStateArenaPeak(arena.peak());
+
+  const bool bin = server.hasArg("fmt") && server.arg("fmt") == "bin";
+  const size_t n = bin ? serializeMsgPack(doc, out, sizeof(out)) : serializeJson(doc, out, sizeof(out));
+  if (doc.overflowed() || n == 0 || n >= sizeof(out)) {
+    DBG_WARN("State: buffer too small (arena %u/%u)\n", (unsigned)arena.peak(), (unsigned)arena.capacity());
+    server.send(500, "text/plain", "state overflow");
+    return;
+  }
+  server.send_P(200, bin ? "application/msgpack" : "application/json", out, n);
 }
 
 /**
@@ -1136,10 +2903,31 @@ static void handleGetState() {
  * - dateFormat: Integer 0-4 for date format selection
  * - ledDiameter: Integer 1-10 for LED dot size
  * - ledGap: Integer 0-8 for spacing between LEDs
+ * - ledShape: Integer 0-2 for LED dot shape (0=square, 1=round, 2=soft round)
+ * - fontStyle: Integer 0-4 for the clock font (see FontStyle in include/fonts.h)
+ * - morphStyle: Integer 0-4 for digit transitions (0=particle, 1=spawn, 2=crossfade, 3=slide, 4=scramble)
+ * - viewport: Integer 0-3 for the part of the matrix shown on the TFT (0=all, 1=clock, 2=HH:MM, 3=date)
  * - ledColor: RGB888 color value (0-16777215)
- * - brightness: Integer 0-255 for backlight brightness
+ * - ledColor2: RGB888 gradient end color (palette modes 1 and 2)
+ * - paletteMode: Integer 0-3 (0=solid, 1=vertical gradient, 2=gradient per digit, 3=rainbow rows)
+ * - brightness: Integer 0-255 perceived brightness (day level in auto / schedule modes)
+ * - dimMode: Integer 0-2 (0=manual, 1=auto from the LDR, 2=night schedule)
+ * - nightBrightness: Integer 0-255 level in the dark / during the night window
+ * - nightStart, nightEnd: Integer 0-23 hours of the night window (may wrap past midnight)
+ * - powerSave: Boolean; lower CPU clock and blocking loop / network polls
+ * - nightBlank: Boolean; display off during the night window (touch or POST /api/wake shows it)
+ * - mirrorFps: Integer 1-30 for the WebSocket mirror push rate
+ * - telemetryMode: Integer 0-2 (0=off, 1=UDP, 2=MQTT)
+ * - telemetryHost, telemetryPort: collector / broker (port 0 = 8094 for UDP, 1883 for MQTT)
+ * - telemetryInterval: Integer 5-3600 seconds between messages
+ * - telemetryTopic: MQTT topic prefix (messages go to <prefix>/<device id>)
  * - flipDisplay: Boolean for display rotation (false=normal, true=180° flip)
  * - debugLevel: Integer 0-4 for logging verbosity
+ * - persist: Boolean; write pending changes to NVS now instead of after CONFIG_SAVE_DEBOUNCE_MS
+ *
+ * Changes apply in RAM immediately; only changed keys are written to NVS, once the UI has been
+ * quiet for CONFIG_SAVE_DEBOUNCE_MS (slider drags coalesce into one write). NTP restarts only when
+ * tz/ntp change, sprite rebuilds only when LED geometry changes.
  */
 static void handlePostConfig() {
   String clientIP = server.client().remoteIP().toString();
@@ -1159,6 +2947,8 @@ static void handlePostConfig() {
     return;
   }
 
+  CfgLock lock;  // loopTask may be persisting or serialising cfg
+
   // Capture old values for logging
   char oldTz[64];
   char oldNtp[64];
@@ -1166,11 +2956,33 @@ static void handlePostConfig() {
   uint8_t oldDateFormat = cfg.dateFormat;
   uint8_t oldLedDiameter = cfg.ledDiameter;
   uint8_t oldLedGap = cfg.ledGap;
+  uint8_t oldLedShape = cfg.ledShape;
+  uint8_t oldFontStyle = cfg.fontStyle;
+  uint8_t oldMorphStyle = cfg.morphStyle;
+  uint8_t oldViewport = cfg.viewport;
   uint32_t oldLedColor = cfg.ledColor;
+  uint32_t oldLedColor2 = cfg.ledColor2;
+  uint8_t oldPaletteMode = cfg.paletteMode;
   uint8_t oldBrightness = cfg.brightness;
+  uint8_t oldDimMode = cfg.dimMode;
+  uint8_t oldNightBrightness = cfg.nightBrightness;
+  uint8_t oldNightStart = cfg.nightStart;
+  uint8_t oldNightEnd = cfg.nightEnd;
+  uint8_t oldMirrorFps = cfg.mirrorFps;
   bool oldFlipDisplay = cfg.flipDisplay;
+  bool oldUseFahrenheit = cfg.useFahrenheit;
+  bool oldPowerSave = cfg.powerSave;
+  bool oldNightBlank = cfg.nightBlank;
+  uint8_t oldDebugLevel = debugLevel;
+  uint8_t oldTelemetryMode = cfg.telemetryMode;
+  uint16_t oldTelemetryPort = cfg.telemetryPort;
+  uint16_t oldTelemetryInterval = cfg.telemetryInterval;
+  char oldTelemetryHost[sizeof(cfg.telemetryHost)];
+  char oldTelemetryTopic[sizeof(cfg.telemetryTopic)];
   strlcpy(oldTz, cfg.tz, sizeof(oldTz));
   strlcpy(oldNtp, cfg.ntp, sizeof(oldNtp));
+  strlcpy(oldTelemetryHost, cfg.telemetryHost, sizeof(oldTelemetryHost));
+  strlcpy(oldTelemetryTopic, cfg.telemetryTopic, sizeof(oldTelemetryTopic));
 
   // Update config and log each change
   if (!doc["tz"].isNull()) {
@@ -1220,11 +3032,66 @@ static void handlePostConfig() {
     }
   }
 
+  if (!doc["ledShape"].isNull()) {
+    cfg.ledShape = (uint8_t)constrain(doc["ledShape"].as<int>(), 0, LED_SHAPE_COUNT - 1);
+    if (oldLedShape != cfg.ledShape) {
+      const char* shapes[] = {"Square", "Round", "Soft round"};
+      DBG_INFO("  [%s] LED shape changed: %s -> %s\n", clientIP.c_str(),
+               shapes[oldLedShape], shapes[cfg.ledShape]);
+    }
+  }
+
+  if (!doc["fontStyle"].isNull()) {
+    cfg.fontStyle = (uint8_t)constrain(doc["fontStyle"].as<int>(), 0, FONT_STYLE_COUNT - 1);
+    if (oldFontStyle != cfg.fontStyle) {
+      DBG_INFO("  [%s] Font changed: %s -> %s\n", clientIP.c_str(),
+               FONTS[oldFontStyle].name, FONTS[cfg.fontStyle].name);
+    }
+  }
+
+  if (!doc["morphStyle"].isNull()) {
+    cfg.morphStyle = (uint8_t)constrain(doc["morphStyle"].as<int>(), 0, MORPH_STYLE_COUNT - 1);
+    if (oldMorphStyle != cfg.morphStyle) {
+      const char* morphs[] = {"Particle", "Spawn", "Crossfade", "Slide", "Scramble"};
+      DBG_INFO("  [%s] Morph style changed: %s -> %s\n", clientIP.c_str(),
+               morphs[oldMorphStyle], morphs[cfg.morphStyle]);
+    }
+  }
+
+  if (!doc["viewport"].isNull()) {
+    cfg.viewport = (uint8_t)constrain(doc["viewport"].as<int>(), 0, VIEWPORT_COUNT - 1);
+    if (oldViewport != cfg.viewport) {
+      const char* views[] = {"Full matrix", "Clock", "HH:MM", "Date"};
+      DBG_INFO("  [%s] Viewport changed: %s -> %s\n", clientIP.c_str(),
+               views[oldViewport], views[cfg.viewport]);
+    }
+  }
+
   if (!doc["ledColor"].isNull()) {
     cfg.ledColor = doc["ledColor"].as<uint32_t>();
     if (oldLedColor != cfg.ledColor) {
       DBG_INFO("  [%s] LED color changed: #%06X -> #%06X\n", clientIP.c_str(),
                (unsigned int)oldLedColor, (unsigned int)cfg.ledColor);
+      invalidatePalette();
+    }
+  }
+
+  if (!doc["ledColor2"].isNull()) {
+    cfg.ledColor2 = doc["ledColor2"].as<uint32_t>() & 0xFFFFFF;
+    if (oldLedColor2 != cfg.ledColor2) {
+      DBG_INFO("  [%s] LED color 2 changed: #%06X -> #%06X\n", clientIP.c_str(),
+               (unsigned int)oldLedColor2, (unsigned int)cfg.ledColor2);
+      invalidatePalette();
+    }
+  }
+
+  if (!doc["paletteMode"].isNull()) {
+    cfg.paletteMode = (uint8_t)constrain(doc["paletteMode"].as<int>(), 0, PALETTE_MODE_COUNT - 1);
+    if (oldPaletteMode != cfg.paletteMode) {
+      const char* modes[] = {"Solid", "Vertical gradient", "Gradient per digit", "Rainbow rows"};
+      DBG_INFO("  [%s] Palette mode changed: %s -> %s\n", clientIP.c_str(),
+               modes[oldPaletteMode], modes[cfg.paletteMode]);
+      invalidatePalette();
     }
   }
 
@@ -1236,9 +3103,66 @@ static void handlePostConfig() {
     }
   }
 
+  if (!doc["dimMode"].isNull()) {
+    cfg.dimMode = (uint8_t)constrain(doc["dimMode"].as<int>(), 0, DIM_MODE_COUNT - 1);
+    if (oldDimMode != cfg.dimMode) {
+      const char* modes[] = {"Manual", "Auto (LDR)", "Schedule"};
+      DBG_INFO("  [%s] Dim mode changed: %s -> %s\n", clientIP.c_str(),
+               modes[oldDimMode], modes[cfg.dimMode]);
+    }
+  }
+
+  if (!doc["nightBrightness"].isNull()) {
+    cfg.nightBrightness = (uint8_t)constrain(doc["nightBrightness"].as<int>(), 0, 255);
+  }
+  if (!doc["nightStart"].isNull()) {
+    cfg.nightStart = (uint8_t)constrain(doc["nightStart"].as<int>(), 0, 23);
+  }
+  if (!doc["nightEnd"].isNull()) {
+    cfg.nightEnd = (uint8_t)constrain(doc["nightEnd"].as<int>(), 0, 23);
+  }
+  if (oldNightBrightness != cfg.nightBrightness || oldNightStart != cfg.nightStart ||
+      oldNightEnd != cfg.nightEnd) {
+    DBG_INFO("  [%s] Night dimming: %u (%02u-%02u h)\n", clientIP.c_str(),
+             cfg.nightBrightness, cfg.nightStart, cfg.nightEnd);
+  }
+
+  if (!doc["mirrorFps"].isNull()) {
+    cfg.mirrorFps = (uint8_t)constrain(doc["mirrorFps"].as<int>(), 1, MIRROR_MAX_FPS);
+    if (oldMirrorFps != cfg.mirrorFps) {
+      DBG_INFO("  [%s] Mirror rate changed: %u -> %u fps\n", clientIP.c_str(),
+               oldMirrorFps, cfg.mirrorFps);
+    }
+  }
+
+  // Telemetry push
+  if (!doc["telemetryMode"].isNull()) {
+    cfg.telemetryMode = (uint8_t)constrain(doc["telemetryMode"].as<int>(), 0, TELEMETRY_MODE_COUNT - 1);
+  }
+  if (!doc["telemetryHost"].isNull()) {
+    strlcpy(cfg.telemetryHost, doc["telemetryHost"].as<const char*>(), sizeof(cfg.telemetryHost));
+  }
+  if (!doc["telemetryPort"].isNull()) {
+    cfg.telemetryPort = (uint16_t)constrain(doc["telemetryPort"].as<int>(), 0, 65535);
+  }
+  if (!doc["telemetryInterval"].isNull()) {
+    cfg.telemetryInterval = (uint16_t)constrain(doc["telemetryInterval"].as<int>(),
+                                                TELEMETRY_MIN_INTERVAL_S, TELEMETRY_MAX_INTERVAL_S);
+  }
+  if (!doc["telemetryTopic"].isNull()) {
+    strlcpy(cfg.telemetryTopic, doc["telemetryTopic"].as<const char*>(), sizeof(cfg.telemetryTopic));
+    if (!cfg.telemetryTopic[0]) strlcpy(cfg.telemetryTopic, DEFAULT_TELEMETRY_TOPIC, sizeof(cfg.telemetryTopic));
+  }
+  if (oldTelemetryMode != cfg.telemetryMode || oldTelemetryPort != cfg.telemetryPort ||
+      oldTelemetryInterval != cfg.telemetryInterval || strcmp(oldTelemetryHost, cfg.telemetryHost) != 0 ||
+      strcmp(oldTelemetryTopic, cfg.telemetryTopic) != 0) {
+    const char* modes[] = {"Off", "UDP", "MQTT"};
+    DBG_INFO("  [%s] Telemetry: %s %s:%u every %u s\n", clientIP.c_str(), modes[cfg.telemetryMode],
+             cfg.telemetryHost, cfg.telemetryPort, cfg.telemetryInterval);
+  }
+
   // Debug level
   if (!doc["debugLevel"].isNull()) {
-    uint8_t oldDebugLevel = debugLevel;
     debugLevel = (uint8_t)constrain(doc["debugLevel"].as<int>(), 0, 4);
     if (oldDebugLevel != debugLevel) {
       const char* levels[] = {"Off", "Error", "Warning", "Info", "Verbose"};
@@ -1254,14 +3178,12 @@ static void handlePostConfig() {
       DBG_INFO("  [%s] Display flip changed: %s -> %s\n", clientIP.c_str(),
                oldFlipDisplay ? "flipped" : "normal",
                cfg.flipDisplay ? "flipped" : "normal");
-      applyDisplayRotation();  // Apply rotation immediately
-      tft.fillScreen(TFT_BLACK);  // Clear screen after rotation change
+      postRenderRequest(RENDER_REQ_ROTATION);  // Render task rotates and clears the screen
     }
   }
 
   // Temperature unit
   if (!doc["useFahrenheit"].isNull()) {
-    bool oldUseFahrenheit = cfg.useFahrenheit;
     cfg.useFahrenheit = doc["useFahrenheit"].as<bool>();
     if (oldUseFahrenheit != cfg.useFahrenheit) {
       DBG_INFO("  [%s] Temperature unit changed: %s -> %s\n", clientIP.c_str(),
@@ -1270,41 +3192,340 @@ static void handlePostConfig() {
     }
   }
 
+  // Power
+  if (!doc["powerSave"].isNull()) {
+    cfg.powerSave = doc["powerSave"].as<bool>();
+    if (oldPowerSave != cfg.powerSave) {
+      DBG_INFO("  [%s] Power save: %s\n", clientIP.c_str(), cfg.powerSave ? "on" : "off");
+    }
+  }
+  if (!doc["nightBlank"].isNull()) {
+    cfg.nightBlank = doc["nightBlank"].as<bool>();
+    if (oldNightBlank != cfg.nightBlank) {
+      DBG_INFO("  [%s] Night blank: %s\n", clientIP.c_str(), cfg.nightBlank ? "on" : "off");
+    }
+  }
+
   // Constrain LED rendering parameters
   // ledDiameter: max size of each LED dot (pitch is typically 5 for 320x240)
   // ledGap: space between LEDs (gap + dot <= pitch)
   cfg.ledDiameter = constrain(cfg.ledDiameter, 1, 10);
   cfg.ledGap      = constrain(cfg.ledGap, 0, 8);
 
-  saveConfig();
-  updateRenderPitch();  // Rebuild sprite if pitch changed
-  startNtp();
-  setBacklight(cfg.brightness);
+  // Everything above is already live in RAM; NVS only sees keys that actually changed
+  uint32_t changed = 0;
+  if (strcmp(oldTz, cfg.tz) != 0)            changed |= CFG_KEY_TZ;
+  if (strcmp(oldNtp, cfg.ntp) != 0)          changed |= CFG_KEY_NTP;
+  if (oldUse24h != cfg.use24h)               changed |= CFG_KEY_24H;
+  if (oldDateFormat != cfg.dateFormat)       changed |= CFG_KEY_DFMT;
+  if (oldLedDiameter != cfg.ledDiameter)     changed |= CFG_KEY_LEDD;
+  if (oldLedGap != cfg.ledGap)               changed |= CFG_KEY_LEDG;
+  if (oldLedShape != cfg.ledShape)           changed |= CFG_KEY_LEDSHP;
+  if (oldFontStyle != cfg.fontStyle)         changed |= CFG_KEY_FONT;
+  if (oldMorphStyle != cfg.morphStyle)       changed |= CFG_KEY_MORPH;
+  if (oldViewport != cfg.viewport)           changed |= CFG_KEY_VIEW;
+  if (oldLedColor != cfg.ledColor)           changed |= CFG_KEY_COL;
+  if (oldLedColor2 != cfg.ledColor2)         changed |= CFG_KEY_COL2;
+  if (oldPaletteMode != cfg.paletteMode)     changed |= CFG_KEY_PAL;
+  if (oldBrightness != cfg.brightness)       changed |= CFG_KEY_BL;
+  if (oldDimMode != cfg.dimMode)             changed |= CFG_KEY_DIM;
+  if (oldNightBrightness != cfg.nightBrightness) changed |= CFG_KEY_NBL;
+  if (oldNightStart != cfg.nightStart)       changed |= CFG_KEY_NSTART;
+  if (oldNightEnd != cfg.nightEnd)           changed |= CFG_KEY_NEND;
+  if (oldMirrorFps != cfg.mirrorFps)         changed |= CFG_KEY_MFPS;
+  if (oldFlipDisplay != cfg.flipDisplay)     changed |= CFG_KEY_FLIP;
+  if (oldUseFahrenheit != cfg.useFahrenheit) changed |= CFG_KEY_FAHR;
+  if (oldPowerSave != cfg.powerSave)         changed |= CFG_KEY_PWR;
+  if (oldNightBlank != cfg.nightBlank)       changed |= CFG_KEY_NBLANK;
+  if (oldDebugLevel != debugLevel)           changed |= CFG_KEY_DBGLVL;
+  if (oldTelemetryMode != cfg.telemetryMode) changed |= CFG_KEY_TLM;
+  if (strcmp(oldTelemetryHost, cfg.telemetryHost) != 0)   changed |= CFG_KEY_TLMHST;
+  if (oldTelemetryPort != cfg.telemetryPort) changed |= CFG_KEY_TLMPRT;
+  if (oldTelemetryInterval != cfg.telemetryInterval)     changed |= CFG_KEY_TLMINT;
+  if (strcmp(oldTelemetryTopic, cfg.telemetryTopic) != 0) changed |= CFG_KEY_TLMTOP;
+  markConfigDirty(changed);
+
+  // Side effects only for the fields that drive them
+  // Rebuild sprite if pitch changed (the viewport follows the font's layout)
+  if (changed & (CFG_KEY_LEDD | CFG_KEY_LEDG | CFG_KEY_VIEW | CFG_KEY_FONT)) postRenderRequest(RENDER_REQ_PITCH);
+  if (changed & (CFG_KEY_TZ | CFG_KEY_NTP)) ntpRestartPending.store(true);  // TZ env belongs to loopTask
+  if (changed & (CFG_KEY_TLM | CFG_KEY_TLMHST | CFG_KEY_TLMPRT | CFG_KEY_TLMINT | CFG_KEY_TLMTOP)) {
+    telemetryReconfig.store(true);
+  }
+  if (changed & (CFG_KEY_BL | CFG_KEY_DIM | CFG_KEY_NBL | CFG_KEY_NSTART | CFG_KEY_NEND)) dimApplyNow.store(true);
+  if (changed & CFG_KEY_TZ) markStatusDirty(STATUS_DIRTY_TZ);
+  if (changed & CFG_KEY_FAHR) markStatusDirty(STATUS_DIRTY_SENSOR);
+  if (changed) powerWake();     // a blank display shows what was changed
+  if (changed) wakeRenderer();  // show font/style changes without waiting for the idle frame
+
+  // "Save Now" asks for an immediate write instead of waiting for the debounce
+  const bool persistNow = doc["persist"].as<bool>();
+  if (persistNow) flushConfig();
+
+  if (changed) requestStatePush();  // Tell stream clients right away
 
   server.send(200, "application/json", "{\"ok\":true}");
 }
 
+/**
+ * GET /api/perf - per-stage timing summary (microseconds over the last PERF_RING_SIZE samples)
+ * Optional query: ?reset=1 clears all rings and the frame counters after responding.
+ * fps is the achieved frame rate over the last PERF_FPS_WINDOW_MS (FRAME_MS while animating, else idle rate).
+ * boot maps each boot milestone (bootMark()) to millis() when it was reached.
+ * power is the power state and a modelled current estimate (see powerSample()).
+ */
+static void addPowerJson(JsonObject o);  // Power section
+
+static void handleGetPerf() {
+  DBG_VERBOSE("Web: GET /api/perf from %s\n", server.client().remoteIP().toString().c_str());
+
+  JsonDocument doc;
+  doc["firmware"] = FIRMWARE_VERSION;
+  doc["build"] = __DATE__ " " __TIME__;
+  doc["uptime"] = millis() / 1000;
+  doc["frameMs"] = FRAME_MS;
+  doc["idleFrameMs"] = IDLE_FRAME_MS;
+  doc["ringSize"] = PERF_RING_SIZE;
+  doc["frames"] = perfRings[PERF_FRAME].total;
+  doc["missedFrames"] = perfMissedFrames;
+  doc["activeFrames"] = perfActiveFrames;
+  doc["idleFrames"] = perfIdleFrames;
+  doc["fps"] = perfFpsX10 / 10.0f;
+  doc["nvsWrites"] = nvsWrites;
+  doc["nvsSaves"] = nvsSaves;
+  doc["configPending"] = cfgDirtyKeys != 0;
+  doc["stateArenaPeak"] = stateArenaPeak.load(std::memory_order_relaxed);
+  doc["stateArenaSize"] = STATE_JSON_ARENA;
+  doc["fbBpp"] = FB_BPP;
+  doc["fbBytes"] = FB_BYTES;
+  doc["sceneRebuilds"] = sceneRebuilds;
+  doc["sceneItemDraws"] = sceneItemDraws;
+  BootPhase boot[BOOT_PHASES_MAX];
+  const uint8_t bootN = copyBootPhases(boot);
+  JsonObject bootObj = doc["boot"].to<JsonObject>();
+  for (uint8_t i = 0; i < bootN; i++) bootObj[boot[i].name] = boot[i].ms;
+  addPowerJson(doc["power"].to<JsonObject>());
+#ifdef HUB75_ENABLE
+  doc["hub75RefreshHz"] = hub75.ready() ? hub75.refreshHz() : 0;
+  doc["hub75RowsConverted"] = hub75RowsConverted;
+#endif
+
+  JsonArray stages = doc["stages"].to<JsonArray>();
+  for (uint8_t i = 0; i < PERF_STAGE_COUNT; i++) {
+    const PerfSummary p = perfSummarize((PerfStage)i);
+    JsonObject o = stages.add<JsonObject>();
+    o["name"] = PERF_STAGE_NAMES[i];
+    o["count"] = p.count;
+    o["total"] = perfRings[i].total;
+    o["min"] = p.minUs;
+    o["avg"] = p.avgUs;
+    o["p99"] = p.p99Us;
+    o["max"] = p.maxUs;
+  }
+
+  String out;
+  serializeJson(doc, out);
+  server.sendHeader("Cache-Control", "no-store");
+  server.send(200, "application/json", out);
+
+  if (server.hasArg("reset") && server.arg("reset") == "1") {
+    perfReset();
+    DBG_INFO("Perf counters reset\n");
+  }
+}
+
+/**
+ * GET /api/history - 24 h sensor history, binary little-endian:
+ *   [0..1] "SH"  [2] version (1)  [3] flags (bit0 pressure present)
+ *   [4..5] sample count  [6..7] period (s)  [8..11] age of the newest sample (s)
+ *   then count x {int16 temp*10 (°C), int16 hum*10 (%), int16 (pressure-1000)*10 (hPa)}, oldest first.
+ * Missing values are INT16_MIN.
+ */
+static void handleGetHistory() {
+  static const size_t HDR = 12;
+  static SensorSample samples[SENSOR_HISTORY_LEN];
+  static uint8_t out[HDR + sizeof(samples)];
+
+  uint32_t newestAgeMs = 0;
+  const uint16_t n = copySensorHistory(samples, newestAgeMs);
+  bool havePres = false;
+  for (uint16_t i = 0; i < n && !havePres; i++) havePres = samples[i].p10 != SENSOR_HIST_NONE;
+
+  const uint16_t periodS = SENSOR_HISTORY_PERIOD_MS / 1000;
+  const uint32_t ageS = newestAgeMs / 1000;
+  out[0] = 'S';
+  out[1] = 'H';
+  out[2] = 1;
+  out[3] = havePres ? 1 : 0;
+  out[4] = n & 0xFF;
+  out[5] = n >> 8;
+  out[6] = periodS & 0xFF;
+  out[7] = periodS >> 8;
+  for (int i = 0; i < 4; i++) out[8 + i] = (uint8_t)(ageS >> (8 * i));
+  uint8_t* p = out + HDR;
+  for (uint16_t i = 0; i < n; i++) {
+    const int16_t v[3] = {samples[i].t10, samples[i].h10, samples[i].p10};
+    for (int k = 0; k < 3; k++) {
+      *p++ = (uint8_t)(v[k] & 0xFF);
+      *p++ = (uint8_t)((uint16_t)v[k] >> 8);
+    }
+  }
+
+  server.sendHeader("Cache-Control", "no-store");
+  server.send_P(200, "application/octet-stream", (const char*)out, (size_t)(p - out));
+}
+
+/**
+ * GET /api/mirror
+ *
+ * Without arguments: raw framebuffer (W*H intensity bytes), as before.
+ * ?fmt=v1[&ack=<seq>]: mirror_codec.h message; with ack, an XOR delta against that frame when it is
+ * still in the device's history (keyframe otherwise), or a header-only SAME when nothing changed.
+ */
 static void handleGetMirror() {
-  const size_t fbSize = LED_MATRIX_W * LED_MATRIX_H;  // 64 * 32 = 2048
-  DBG_VERBOSE("Mirror: Sending %u bytes\n", (unsigned)fbSize);
+  static uint8_t frame[LED_MATRIX_W * LED_MATRIX_H];
+  static uint8_t base[LED_MATRIX_W * LED_MATRIX_H];
+  static uint8_t msg[MIRROR_CODEC_HDR + LED_MATRIX_W * LED_MATRIX_H];
   server.sendHeader("Cache-Control", "no-store");
-  server.send_P(200, "application/octet-stream", (const char*)fb, fbSize);
+
+  if (!server.hasArg("fmt")) {
+    const size_t fbSize = sizeof(frame);  // 64 * 32 = 2048
+    copyMirrorFrame(frame);
+    DBG_VERBOSE("Mirror: Sending %u bytes\n", (unsigned)fbSize);
+    server.send_P(200, "application/octet-stream", (const char*)frame, fbSize);
+    return;
+  }
+
+  if (server.arg("fmt") != "v1") {
+    server.send(400, "text/plain", "unsupported fmt (use v1)");
+    return;
+  }
+
+  const bool hasAck = server.hasArg("ack");
+  const uint16_t ack = hasAck ? (uint16_t)server.arg("ack").toInt() : 0;
+  bool hasBase = false;
+  const uint16_t seq = copyMirrorFrames(frame, hasAck ? base : nullptr, ack, &hasBase);
+  const size_t n = mirrorEncode(frame, hasBase ? base : nullptr, seq, ack, LED_MATRIX_W, LED_MATRIX_H, msg);
+  DBG_VERBOSE("Mirror: v1 seq=%u ack=%s%u enc=%u %u bytes\n", seq, hasAck ? "" : "-", ack, msg[2], (unsigned)n);
+  server.send_P(200, "application/octet-stream", (const char*)msg, n);
+}
+
+// =========================
+// Static web UI
+// =========================
+// scripts/build_web.py packs web/ into LittleFS as gzipped, content-hashed files plus /web.manifest.
+// Hashed assets never change under their URL, so they are cached as immutable; index.html is
+// revalidated against its ETag (the hash of its content, which includes the asset hashes).
+struct StaticAsset {
+  char url[40];
+  char path[44];
+  char etag[12];      // quoted strong ETag
+  char type[28];
+  bool immutable;
+};
+
+static StaticAsset staticAssets[STATIC_ASSET_MAX];
+static uint8_t staticAssetCount = 0;
+
+/**
+ * Load /web.manifest (written by scripts/build_web.py)
+ * @return Number of assets found (0 if the image has no manifest)
+ */
+static uint8_t loadStaticManifest() {
+  File f = LittleFS.open("/web.manifest", "r");
+  if (!f) return 0;
+  staticAssetCount = 0;
+  char line[160];
+  while (f.available() && staticAssetCount < STATIC_ASSET_MAX) {
+    const size_t n = f.readBytesUntil('\n', line, sizeof(line) - 1);
+    line[n] = '\0';
+    StaticAsset& a = staticAssets[staticAssetCount];
+    int immutable = 0;
+    if (sscanf(line, "%39s %43s %11s %27s %d", a.url, a.path, a.etag, a.type, &immutable) != 5) continue;
+    a.immutable = immutable != 0;
+    staticAssetCount++;
+  }
+  f.close();
+  return staticAssetCount;
+}
+
+// True only if Accept-Encoding lists gzip with q=0 (no header, or one without gzip, allows it)
+static bool clientRefusesGzip() {
+  const String ae = server.header("Accept-Encoding");
+  const char* at = strstr(ae.c_str(), "gzip");
+  if (!at) return false;
+  const char* end = strchr(at, ',');
+  const char* q = strstr(at, "q=");
+  return q && (!end || q < end) && atof(q + 2) <= 0;
+}
+
+/**
+ * Serve one packed asset: 304 on a matching ETag, otherwise the gzipped file in STATIC_CHUNK pieces.
+ * The image only holds the gzipped copies, so a client that refuses gzip gets 406.
+ * @param a Manifest entry
+ */
+static void sendStaticAsset(const StaticAsset& a) {
+  DBG_VERBOSE("Web: GET %s from %s\n", a.url, server.client().remoteIP().toString().c_str());
+  if (clientRefusesGzip()) {
+    DBG_WARN("Web: %s needs gzip, client refuses it\n", a.url);
+    server.send(406, "text/plain", "gzip encoding required");
+    return;
+  }
+
+  server.sendHeader("Vary", "Accept-Encoding");
+  server.sendHeader("ETag", a.etag);
+  server.sendHeader("Cache-Control", a.immutable ? "public, max-age=31536000, immutable" : "no-cache");
+  if (server.header("If-None-Match") == a.etag) {
+    server.send(304);
+    return;
+  }
+
+  File f = LittleFS.open(a.path, "r");
+  if (!f) {
+    DBG_WARN("Web: %s missing from LittleFS\n", a.path);
+    server.send(404, "text/plain", "Not found");
+    return;
+  }
+  server.sendHeader("Content-Encoding", "gzip");
+  server.setContentLength(f.size());
+  server.send(200, a.type, "");
+
+  // Small writes with a yield in between keep a slow client from starving the other core-0 tasks
+  // (mirror, telemetry) while the HTTP task streams
+  static uint8_t buf[STATIC_CHUNK];
+  WiFiClient client = server.client();
+  while (client.connected()) {
+    const size_t n = f.read(buf, sizeof(buf));
+    if (!n) break;
+    if (client.write(buf, n) != n) break;
+    yield();
+  }
+  f.close();
 }
 
 static void serveStaticFiles() {
-  server.on("/", HTTP_GET, []() {
-    DBG_VERBOSE("Web: GET / (index.html) from %s\n", server.client().remoteIP().toString().c_str());
-    File f = LittleFS.open("/index.html", "r");
-    if (!f) {
-      DBG_WARN("Web: index.html not found\n");
-      server.send(404, "text/plain", "Not found");
-      return;
+  if (loadStaticManifest()) {
+    for (uint8_t i = 0; i < staticAssetCount; i++) {
+      server.on(staticAssets[i].url, HTTP_GET, [i]() { sendStaticAsset(staticAssets[i]); });
     }
-    server.streamFile(f, "text/html");
-    f.close();
-  });
-  server.serveStatic("/app.js", LittleFS, "/app.js");
-  server.serveStatic("/style.css", LittleFS, "/style.css");
+    DBG("Web UI: %u packed assets\n", staticAssetCount);
+  } else {
+    // Image built without scripts/build_web.py: serve plain files as before
+    DBG_WARN("Web: no /web.manifest, serving uncompressed files\n");
+    server.on("/", HTTP_GET, []() {
+      DBG_VERBOSE("Web: GET / (index.html) from %s\n", server.client().remoteIP().toString().c_str());
+      File f = LittleFS.open("/index.html", "r");
+      if (!f) {
+        DBG_WARN("Web: index.html not found\n");
+        server.send(404, "text/plain", "Not found");
+        return;
+      }
+      server.streamFile(f, "text/html");
+      f.close();
+    });
+    server.serveStatic("/app.js", LittleFS, "/app.js");
+    server.serveStatic("/style.css", LittleFS, "/style.css");
+  }
 
   server.onNotFound([]() {
     DBG_VERBOSE("Web: 404 %s from %s\n", server.uri().c_str(), server.client().remoteIP().toString().c_str());
@@ -1329,8 +3550,43 @@ static void configModeCallback(WiFiManager* myWiFiManager) {
   setRGBLed(1, 0, 1);
 }
 
+// Rebuild the cached SSID/IP strings (WiFi event task, and once after startup)
+static void refreshNetInfo() {
+  const bool up = WiFi.isConnected();
+  char ssid[sizeof(netSsid)] = "DISCONNECTED";
+  char ip[sizeof(netIp)] = "0.0.0.0";
+  if (up) {
+    strlcpy(ssid, WiFi.SSID().c_str(), sizeof(ssid));
+    const IPAddress a = WiFi.localIP();
+    snprintf(ip, sizeof(ip), "%u.%u.%u.%u", a[0], a[1], a[2], a[3]);
+  }
+  portENTER_CRITICAL(&netMux);
+  memcpy(netSsid, ssid, sizeof(netSsid));
+  memcpy(netIp, ip, sizeof(netIp));
+  netUp = up;
+  portEXIT_CRITICAL(&netMux);
+  markStatusDirty(STATUS_DIRTY_EXTRA);
+  requestStatePush();
+}
+
+static void onWifiEvent(arduino_event_id_t event) {
+  switch (event) {
+    case ARDUINO_EVENT_WIFI_STA_GOT_IP:
+      if (!ntpStarted.load()) ntpRestartPending.store(true);  // first connection: loopTask starts SNTP
+      refreshNetInfo();
+      break;
+    case ARDUINO_EVENT_WIFI_STA_LOST_IP:
+    case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
+      refreshNetInfo();
+      break;
+    default:
+      break;
+  }
+}
+
 static void startWifi() {
   DBG_STEP("Starting WiFi (STA) + WiFiManager...");
+  WiFi.onEvent(onWifiEvent);
   WiFi.mode(WIFI_STA);
 
   // Blue LED during WiFi connection attempt
@@ -1356,77 +3612,525 @@ static void startWifi() {
         WiFi.SSID().c_str(),
         WiFi.localIP().toString().c_str());
     DBG_OK("WiFi ready.");
-    // Green flash for successful connection
+    // Green flash for successful connection (the blue connecting state ends with it)
+    setRGBLed(false, false, false);
     flashRGBLed(0, 1, 0, 500);
   } else {
     DBG_WARN("WiFi not connected (AP mode).");
     setRGBLed(false, false, false);
   }
+  refreshNetInfo();
 }
 
 // =========================
-// OTA
+// Mirror stream (WebSocket)
 // =========================
+/**
+ * Push-based mirror on ws://<ip>:WS_PORT/ served from its own task, so slow or many viewers never
+ * block loop() or the render task.
+ *
+ * Binary messages: mirror_codec.h frames at cfg.mirrorFps, only when the frame changed. Synced clients
+ * get XOR deltas against the previous frame (the ordered stream acknowledges it implicitly); new
+ * clients get a keyframe.
+ * Text messages: full state JSON (same as GET /api/state) when it changes, at least every
+ * MIRROR_STATE_HEARTBEAT_MS.
+ *
+ * The stream task is the only consumer of the framebuffer triple buffer. It keeps the last
+ * MIRROR_HISTORY frames by sequence number so GET /api/mirror?fmt=v1&ack=<seq> can send deltas too.
+ */
+static const size_t MIRROR_FRAME_BYTES = LED_MATRIX_W * LED_MATRIX_H;
+static_assert(LED_MATRIX_W <= 255 && LED_MATRIX_H <= 255, "mirror codec stores dimensions in one byte");
+
+static uint8_t mirrorHist[MIRROR_HISTORY][MIRROR_FRAME_BYTES];   // recent distinct frames
+static uint16_t mirrorHistSeq[MIRROR_HISTORY];
+static uint8_t mirrorHistHead = 0;                 // newest entry
+static uint16_t mirrorSeq = 0;                     // seq of mirrorHist[mirrorHistHead]
+static portMUX_TYPE mirrorSnapMux = portMUX_INITIALIZER_UNLOCKED;   // guards history (stream task writes, HTTP reads)
+
+static uint8_t mirrorSent[MIRROR_FRAME_BYTES];     // frame the synced stream clients currently hold
+static uint16_t mirrorSentSeq = 0;
+static uint8_t mirrorMsg[MIRROR_CODEC_HDR + MIRROR_FRAME_BYTES];
+static uint32_t mirrorNeedKey = 0;                // per-client bitmask, bit n = client n
+static std::atomic<uint8_t> mirrorClients{0};     // connected viewers (read from loopTask)
+static TaskHandle_t mirrorTaskHandle = nullptr;
+
+static SemaphoreHandle_t mirrorStateLock = nullptr;
+static char mirrorStateJson[STATE_JSON_MAX];      // last state built on loopTask
+static size_t mirrorStateLen = 0;
+static char mirrorStateTx[STATE_JSON_MAX];        // stream task's copy while sending
+static bool mirrorStateFresh = false;             // not yet broadcast
+static volatile bool mirrorStateRequested = true;
+static uint32_t mirrorStateStableHash = 0;
+static uint32_t mirrorLastStateMs = 0;
 
 /**
- * Draw OTA progress bar on TFT display
- * @param progress Progress percentage (0-100)
+ * Copy the newest mirror frame and, if still in history, the frame with sequence ackSeq
+ * @param out Current frame destination
+ * @param base Base frame destination (may be nullptr)
+ * @param ackSeq Sequence number the client holds
+ * @param hasBase Set when base was filled
+ * @return Sequence number of out
  */
-static void drawOTAProgress(unsigned int progress) {
-  const int barWidth = 280;
-  const int barHeight = 40;
-  const int barX = (tft.width() - barWidth) / 2;
-  const int barY = (tft.height() - barHeight) / 2;
+static uint16_t copyMirrorFrames(uint8_t* out, uint8_t* base, uint16_t ackSeq, bool* hasBase) {
+  bool found = false;
+  portENTER_CRITICAL(&mirrorSnapMux);
+  const uint16_t seq = mirrorSeq;
+  memcpy(out, mirrorHist[mirrorHistHead], MIRROR_FRAME_BYTES);
+  if (base) {
+    for (uint8_t i = 0; i < MIRROR_HISTORY; i++) {
+      if (mirrorHistSeq[i] == ackSeq) {
+        memcpy(base, mirrorHist[i], MIRROR_FRAME_BYTES);
+        found = true;
+        break;
+      }
+    }
+  }
+  portEXIT_CRITICAL(&mirrorSnapMux);
+  if (hasBase) *hasBase = found;
+  return seq;
+}
 
-  // Clear screen on first progress update
-  static bool firstDraw = true;
-  if (firstDraw) {
-    tft.fillScreen(TFT_BLACK);
-    firstDraw = false;
+static void copyMirrorFrame(uint8_t* out) { copyMirrorFrames(out, nullptr, 0, nullptr); }
+
+// Ask loop() to rebuild and push the state now (config changes)
+static void requestStatePush() { mirrorStateRequested = true; }
+
+static uint32_t fnv1a(const char* s, size_t n) {
+  uint32_t h = 2166136261u;
+  for (size_t i = 0; i < n; i++) { h ^= (uint8_t)s[i]; h *= 16777619u; }
+  return h;
+}
+
+/**
+ * Build the state JSON on loopTask (cfg is read under CfgLock) and hand it to the stream task
+ * when a non-volatile field changed, on request, or on the heartbeat. Checked once a second.
+ */
+static void mirrorStatePoll() {
+  static uint32_t lastCheck = 0;
+  const uint32_t now = millis();
+  if (!mirrorStateRequested && now - lastCheck < 1000) return;
+  lastCheck = now;
+  if (!mirrorStateLock || mirrorClients.load() == 0) return;
+
+  alignas(8) static uint8_t arenaMem[STATE_JSON_ARENA];
+  static ArenaAllocator arena(arenaMem, sizeof(arenaMem));
+  static char out[STATE_JSON_MAX];
+  static char stable[STATE_JSON_MAX];
+
+  arena.reset();
+  JsonDocument doc(&arena);
+  buildStateJson(doc);
+  noteStateArenaPeak(arena.peak());
+  const size_t n = serializeJson(doc, out, sizeof(out));
+  if (doc.overflowed() || n == 0 || n >= sizeof(out)) {
+    DBG_WARN("Mirror state: buffer too small\n");
+    return;
   }
 
-  // Draw title
-  tft.setTextDatum(TC_DATUM);
-  tft.setTextColor(TFT_CYAN, TFT_BLACK);
-  tft.setTextFont(4);
-  tft.drawString("OTA Update", tft.width() / 2, barY - 50);
-
-  // Draw progress bar border
-  tft.drawRect(barX - 2, barY - 2, barWidth + 4, barHeight + 4, TFT_WHITE);
-
-  // Fill progress bar
-  int fillWidth = (barWidth * progress) / 100;
-  if (fillWidth > 0) {
-    // Use gradient colors: red -> yellow -> green
-    uint16_t barColor;
-    if (progress < 33) {
-      barColor = TFT_RED;
-    } else if (progress < 66) {
-      barColor = TFT_YELLOW;
+  // Fields that tick every second don't count as a change on their own
+  doc.remove("time");
+  doc.remove("uptime");
+  doc.remove("freeHeap");
+  doc.remove("heapMinFree");
+  doc.remove("heapLargest");
+  doc.remove("heapFrag");
+  const size_t sn = serializeJson(doc, stable, sizeof(stable));
+  const uint32_t h = fnv1a(stable, sn);
+
+  if (!mirrorStateRequested && h == mirrorStateStableHash && now - mirrorLastStateMs < MIRROR_STATE_HEARTBEAT_MS) return;
+  mirrorStateRequested = false;
+  mirrorStateStableHash = h;
+  mirrorLastStateMs = now;
+
+  xSemaphoreTake(mirrorStateLock, portMAX_DELAY);
+  memcpy(mirrorStateJson, out, n + 1);
+  mirrorStateLen = n;
+  mirrorStateFresh = true;
+  xSemaphoreGive(mirrorStateLock);
+}
+
+/**
+ * Copy the latest state JSON into mirrorStateTx (stream task only)
+ * @param consume Clear the fresh flag (broadcast) or leave it (single new client)
+ * @return Length in bytes, 0 if no state was built yet
+ */
+static size_t takeMirrorState(bool consume) {
+  xSemaphoreTake(mirrorStateLock, portMAX_DELAY);
+  const size_t n = mirrorStateLen;
+  memcpy(mirrorStateTx, mirrorStateJson, n);
+  if (consume) mirrorStateFresh = false;
+  xSemaphoreGive(mirrorStateLock);
+  return n;
+}
+
+static void onMirrorEvent(uint8_t num, WStype_t type, uint8_t* payload, size_t length) {
+  (void)payload; (void)length;
+  if (num >= 32) return;
+  switch (type) {
+    case WStype_CONNECTED: {
+      mirrorClients.store((uint8_t)wsMirror.connectedClients());
+      DBG_INFO("Mirror stream: client %u connected (%u total)\n", num, (unsigned)mirrorClients.load());
+      mirrorNeedKey |= (1u << num);
+      // Send the last state straight away; a fresh one follows from loop()
+      const size_t n = takeMirrorState(false);
+      if (n) wsMirror.sendTXT(num, mirrorStateTx, n);
+      requestStatePush();
+      break;
+    }
+    case WStype_DISCONNECTED:
+      mirrorClients.store((uint8_t)wsMirror.connectedClients());
+      DBG_INFO("Mirror stream: client %u disconnected\n", num);
+      mirrorNeedKey &= ~(1u << num);
+      break;
+    default:
+      break;
+  }
+}
+
+/**
+ * Take the latest rendered frame into history (new seq only if it changed), then push it:
+ * XOR deltas to synced stream clients, keyframes to new ones
+ */
+static void mirrorPushFrame() {
+  const uint8_t* frame = latestFrame();
+  if (memcmp(frame, mirrorHist[mirrorHistHead], MIRROR_FRAME_BYTES) != 0) {
+    const uint8_t next = (mirrorHistHead + 1) % MIRROR_HISTORY;
+    portENTER_CRITICAL(&mirrorSnapMux);
+    memcpy(mirrorHist[next], frame, MIRROR_FRAME_BYTES);
+    mirrorHistSeq[next] = ++mirrorSeq;
+    mirrorHistHead = next;
+    portEXIT_CRITICAL(&mirrorSnapMux);
+  }
+
+  if (mirrorClients.load() == 0) return;
+  if (mirrorSentSeq == mirrorSeq && !mirrorNeedKey) return;  // nothing new
+
+  if (mirrorSentSeq != mirrorSeq) {
+    const size_t n = mirrorEncode(frame, mirrorSent, mirrorSeq, mirrorSentSeq, LED_MATRIX_W, LED_MATRIX_H, mirrorMsg);
+    for (uint8_t c = 0; c < WEBSOCKETS_SERVER_CLIENT_MAX; c++) {
+      if (!(mirrorNeedKey & (1u << c)) && wsMirror.clientIsConnected(c)) wsMirror.sendBIN(c, mirrorMsg, n);
+    }
+  }
+
+  if (mirrorNeedKey) {
+    const size_t n = mirrorEncode(frame, nullptr, mirrorSeq, mirrorSeq, LED_MATRIX_W, LED_MATRIX_H, mirrorMsg);
+    for (uint8_t c = 0; c < WEBSOCKETS_SERVER_CLIENT_MAX; c++) {
+      if ((mirrorNeedKey & (1u << c)) && wsMirror.clientIsConnected(c)) wsMirror.sendBIN(c, mirrorMsg, n);
+    }
+    mirrorNeedKey = 0;
+  }
+  memcpy(mirrorSent, frame, MIRROR_FRAME_BYTES);
+  mirrorSentSeq = mirrorSeq;
+}
+
+static void mirrorTask(void*) {
+  uint32_t lastFrameMs = 0;
+  for (;;) {
+    wsMirror.loop();
+
+    const uint32_t now = millis();
+    if (now - lastFrameMs >= 1000u / cfg.mirrorFps) {
+      lastFrameMs = now;
+      mirrorPushFrame();
+    }
+
+    if (mirrorStateFresh) {
+      const size_t n = takeMirrorState(true);
+      if (n) wsMirror.broadcastTXT(mirrorStateTx, n);
+    }
+
+    vTaskDelay(pdMS_TO_TICKS(powerPollMs(5)));
+  }
+}
+
+static void startMirrorStream() {
+  DBG_STEP("Starting mirror stream...");
+  mirrorStateLock = xSemaphoreCreateMutex();
+  wsMirror.begin();
+  wsMirror.onEvent(onMirrorEvent);
+  BaseType_t ok = xTaskCreatePinnedToCore(mirrorTask, "mirror", MIRROR_TASK_STACK, nullptr,
+                                          MIRROR_TASK_PRIO, &mirrorTaskHandle, MIRROR_TASK_CORE);
+  if (ok != pdPASS) {
+    mirrorTaskHandle = nullptr;
+    DBG_ERR("Mirror stream task create failed");
+    return;
+  }
+  DBG("Mirror stream ready on ws port %d\n", WS_PORT);
+}
+
+// =========================
+// HTTP task
+// =========================
+// WebServer handles one request at a time; running it here (network core) means a slow or stalled
+// client only delays other HTTP requests, never the clock logic on loopTask or frames on the render task.
+static TaskHandle_t httpTaskHandle = nullptr;
+
+static void webOtaTick();  // Web OTA section
+
+static void httpTask(void*) {
+  for (;;) {
+    {
+      PerfScope ps(PERF_HTTP);
+      server.handleClient();
+    }
+    webOtaTick();
+    vTaskDelay(pdMS_TO_TICKS(powerPollMs(HTTP_TASK_POLL_MS)));
+  }
+}
+
+static void startHttpTask() {
+  BaseType_t ok = xTaskCreatePinnedToCore(httpTask, "http", HTTP_TASK_STACK, nullptr,
+                                          HTTP_TASK_PRIO, &httpTaskHandle, HTTP_TASK_CORE);
+  if (ok != pdPASS) {
+    httpTaskHandle = nullptr;
+    DBG_WARN("HTTP task create failed, serving from loop()\n");
+  }
+}
+
+// =========================
+// Telemetry push
+// =========================
+// Fleet monitoring without polling /api/state. Every cfg.telemetryInterval seconds one compact JSON
+// message goes to cfg.telemetryHost. It holds the sensor samples taken since the last message, plus
+// uptime, heap, RSSI and frame timing. Transport is UDP (one datagram) or MQTT (a QoS 0 PUBLISH to
+// <telemetryTopic>/<device id> on a kept-open connection). Everything that can block (DNS, TCP
+// connect, socket writes) runs on this task, with static buffers. Failures back off exponentially
+// from TELEMETRY_BACKOFF_MIN_MS to TELEMETRY_BACKOFF_MAX_MS, and unsent samples stay queued.
+//
+//   {"id":"rc-a1b2c3","fw":"1.2.0","up":3600,"ts":1767225600,"heap":151234,"heapMin":140012,"heapFrag":3,
+//    "rssi":-61,"fps":1.0,"frames":3600,"missed":0,"frameP99":5120,"renderP99":3904,
+//    "dt":10,"t":[231,232],"h":[455,457],"p":[10132,10131]}
+//
+// t/h/p are the filtered samples oldest first, in tenths (°C, %RH, hPa), null where a reading failed;
+// dt is the sample period in seconds and the newest sample is at most dt old. ts is only sent once
+// the clock is set.
+static TaskHandle_t telemetryTaskHandle = nullptr;
+static WiFiClient telemetryTcp;
+static WiFiUDP telemetryUdp;
+
+/**
+ * Queued samples, oldest first (they stay queued until telemetryBatchDrop())
+ * @param upto Set to the push count the copy covers
+ */
+static uint8_t telemetryBatchCopy(SensorSample* out, uint32_t& upto) {
+  portENTER_CRITICAL(&sensorMux);
+  const uint8_t n = telemetryBatchCount;
+  const uint8_t first = (uint8_t)((telemetryBatchHead + TELEMETRY_BATCH_MAX - n) % TELEMETRY_BATCH_MAX);
+  for (uint8_t i = 0; i < n; i++) out[i] = telemetryBatch[(first + i) % TELEMETRY_BATCH_MAX];
+  upto = telemetryBatchPushed;
+  portEXIT_CRITICAL(&sensorMux);
+  return n;
+}
+
+// Forget the samples up to push count upto (sent); later ones stay queued
+static void telemetryBatchDrop(uint32_t upto) {
+  portENTER_CRITICAL(&sensorMux);
+  const uint32_t newer = telemetryBatchPushed - upto;
+  if (telemetryBatchCount > newer) telemetryBatchCount = (uint8_t)newer;
+  portEXIT_CRITICAL(&sensorMux);
+}
+
+/**
+ * Serialize one telemetry message
+ * @param upto Set to the batch position the message covers (for telemetryBatchDrop() once sent)
+ * @return Length, or 0 if it did not fit TELEMETRY_ARENA / cap
+ */
+static size_t telemetryBuild(char* out, size_t cap, uint32_t& upto) {
+  alignas(8) static uint8_t arenaMem[TELEMETRY_ARENA];
+  static ArenaAllocator arena(arenaMem, sizeof(arenaMem));
+  static SensorSample batch[TELEMETRY_BATCH_MAX];
+  const uint8_t n = telemetryBatchCopy(batch, upto);
+
+  arena.reset();
+  JsonDocument doc(&arena);
+  doc["id"] = telemetryId;
+  doc["fw"] = FIRMWARE_VERSION;
+  doc["up"] = millis() / 1000;
+  const ClockSnapshot clk = clockNow();
+  if (clk.valid) doc["ts"] = (uint32_t)clk.epoch;
+  doc["heap"] = ESP.getFreeHeap();
+  doc["heapMin"] = ESP.getMinFreeHeap();
+  doc["heapFrag"] = heapFragPct();
+  doc["rssi"] = WiFi.RSSI();
+  doc["fps"] = perfFpsX10 / 10.0f;
+  doc["frames"] = perfRings[PERF_FRAME].total;
+  doc["missed"] = perfMissedFrames;
+  doc["frameP99"] = perfSummarize(PERF_FRAME).p99Us;
+  doc["renderP99"] = perfSummarize(PERF_RENDER).p99Us;
+  if (n) {
+    doc["dt"] = SENSOR_UPDATE_INTERVAL / 1000;
+    JsonArray t = doc["t"].to<JsonArray>();
+    JsonArray h = doc["h"].to<JsonArray>();
+    JsonArray p = doc["p"].to<JsonArray>();
+    for (uint8_t i = 0; i < n; i++) {
+      const SensorSample& s = batch[i];
+      if (s.t10 != SENSOR_HIST_NONE) t.add(s.t10); else t.add(nullptr);
+      if (s.h10 != SENSOR_HIST_NONE) h.add(s.h10); else h.add(nullptr);
+      if (s.p10 != SENSOR_HIST_NONE) p.add(s.p10 + SENSOR_PRES_BASE * 10); else p.add(nullptr);
+    }
+  }
+
+  const size_t len = serializeJson(doc, out, cap);
+  if (doc.overflowed() || len == 0 || len >= cap) {
+    DBG_WARN("Telemetry: message too large (arena %u/%u)\n", (unsigned)arena.peak(), (unsigned)arena.capacity());
+    return 0;
+  }
+  return len;
+}
+
+// Open the broker connection and wait for CONNACK (blocks up to 2x TELEMETRY_CONNECT_TIMEOUT_MS)
+static bool telemetryMqttConnect(const IPAddress& ip, uint16_t port, uint16_t intervalS) {
+  telemetryTcp.stop();
+  if (!telemetryTcp.connect(ip, port, TELEMETRY_CONNECT_TIMEOUT_MS)) return false;
+  telemetryTcp.setNoDelay(true);
+
+  // Our messages are the only traffic, so the keepalive allows two missed intervals
+  uint8_t pkt[64];
+  const size_t n = mqttConnect(pkt, sizeof(pkt), telemetryId, (uint16_t)min<uint32_t>(2u * intervalS, 0xFFFF));
+  if (!n || telemetryTcp.write(pkt, n) != n) {
+    telemetryTcp.stop();
+    return false;
+  }
+
+  uint8_t ack[4];
+  size_t got = 0;
+  const uint32_t t0 = millis();
+  while (got < sizeof(ack) && millis() - t0 < TELEMETRY_CONNECT_TIMEOUT_MS && telemetryTcp.connected()) {
+    const int r = telemetryTcp.available() > 0 ? telemetryTcp.read(ack + got, sizeof(ack) - got) : 0;
+    if (r > 0) got += (size_t)r;
+    else vTaskDelay(pdMS_TO_TICKS(10));
+  }
+  const int code = mqttConnackCode(ack, got);
+  if (code != 0) {
+    DBG_WARN("Telemetry: MQTT broker refused the connection (%d)\n", code);
+    telemetryTcp.stop();
+    return false;
+  }
+  DBG_INFO("Telemetry: MQTT connected to %s:%u\n", ip.toString().c_str(), port);
+  return true;
+}
+
+// Hand one message to the network stack
+static bool telemetrySend(uint8_t mode, const IPAddress& ip, uint16_t port, const char* topic,
+                          const char* msg, size_t len) {
+  if (mode == TELEMETRY_UDP) {
+    return telemetryUdp.beginPacket(ip, port) && telemetryUdp.write((const uint8_t*)msg, len) == len &&
+           telemetryUdp.endPacket();
+  }
+  uint8_t hdr[MQTT_PUBLISH_HDR_MAX(sizeof(cfg.telemetryTopic) + sizeof(telemetryId))];
+  const size_t h = mqttPublishHeader(hdr, sizeof(hdr), topic, len);
+  return h && telemetryTcp.connected() && telemetryTcp.write(hdr, h) == h &&
+         telemetryTcp.write((const uint8_t*)msg, len) == len;
+}
+
+static void telemetryTask(void*) {
+  static char msg[TELEMETRY_MSG_MAX];
+  IPAddress ip;
+  bool resolved = false;
+  uint32_t lastTryMs = 0;
+  uint32_t backoffMs = 0;     // 0 = last attempt succeeded
+  bool sendNow = true;        // first message as soon as the network is up
+
+  for (;;) {
+    vTaskDelay(pdMS_TO_TICKS(1000));
+
+    // Snapshot of the target (cfg is written by the HTTP task)
+    uint8_t mode;
+    uint16_t port, intervalS;
+    char host[sizeof(cfg.telemetryHost)];
+    char topic[sizeof(cfg.telemetryTopic) + sizeof(telemetryId)];
+    {
+      CfgLock lock;
+      mode = cfg.telemetryMode;
+      intervalS = cfg.telemetryInterval;
+      port = cfg.telemetryPort ? cfg.telemetryPort : mode == TELEMETRY_MQTT ? TELEMETRY_MQTT_PORT : TELEMETRY_UDP_PORT;
+      strlcpy(host, cfg.telemetryHost, sizeof(host));
+      snprintf(topic, sizeof(topic), "%s/%s", cfg.telemetryTopic, telemetryId);
+    }
+
+    if (telemetryReconfig.exchange(false)) {
+      if (telemetryTcp.connected()) telemetryTcp.write(MQTT_DISCONNECT, sizeof(MQTT_DISCONNECT));
+      telemetryTcp.stop();
+      resolved = false;
+      backoffMs = 0;
+      sendNow = true;
+      telemetryLinkUp = false;
+    }
+    if (mode == TELEMETRY_OFF || !host[0] || !netInfo(nullptr, 0, nullptr, 0)) {
+      telemetryLinkUp = false;
+      continue;
+    }
+    if (mode == TELEMETRY_MQTT) {
+      while (telemetryTcp.available() > 0) telemetryTcp.read();   // nothing is subscribed; discard
+    }
+
+    const uint32_t now = millis();
+    const uint32_t waitMs = sendNow ? 0 : backoffMs ? backoffMs : intervalS * 1000u;
+    if (now - lastTryMs < waitMs) continue;
+    lastTryMs = now;
+    sendNow = false;
+
+    PerfScope ps(PERF_TELEMETRY);
+    bool ok = resolved || WiFi.hostByName(host, ip) == 1;
+    resolved = ok;
+    if (ok && mode == TELEMETRY_MQTT && !telemetryTcp.connected()) ok = telemetryMqttConnect(ip, port, intervalS);
+    uint32_t upto = 0;
+    const size_t len = ok ? telemetryBuild(msg, sizeof(msg), upto) : 0;
+    ok = len > 0 && telemetrySend(mode, ip, port, topic, msg, len);
+
+    if (ok) {
+      telemetryBatchDrop(upto);
+      telemetrySent++;
+      backoffMs = 0;
     } else {
-      barColor = TFT_GREEN;
+      telemetryErrors++;
+      telemetryTcp.stop();
+      resolved = false;   // the address may have moved
+      backoffMs = backoffMs ? min<uint32_t>(backoffMs * 2, TELEMETRY_BACKOFF_MAX_MS) : TELEMETRY_BACKOFF_MIN_MS;
+      DBG_WARN("Telemetry: send to %s:%u failed, retry in %lu s\n", host, port, (unsigned long)(backoffMs / 1000));
     }
-    tft.fillRect(barX, barY, fillWidth, barHeight, barColor);
+    telemetryLinkUp = ok;
   }
+}
 
-  // Clear remaining area
-  if (fillWidth < barWidth) {
-    tft.fillRect(barX + fillWidth, barY, barWidth - fillWidth, barHeight, TFT_BLACK);
+static void startTelemetryTask() {
+  const uint64_t mac = ESP.getEfuseMac();
+  snprintf(telemetryId, sizeof(telemetryId), "rc-%06x", (unsigned)((mac >> 24) & 0xFFFFFF));
+  BaseType_t ok = xTaskCreatePinnedToCore(telemetryTask, "telemetry", TELEMETRY_TASK_STACK, nullptr,
+                                          TELEMETRY_TASK_PRIO, &telemetryTaskHandle, TELEMETRY_TASK_CORE);
+  if (ok != pdPASS) {
+    telemetryTaskHandle = nullptr;
+    DBG_WARN("Telemetry task create failed, telemetry disabled\n");
   }
+}
+
+// =========================
+// OTA
+// =========================
+// Forward declarations (defined later in Render task section)
+static void pauseRenderer();
+static void resumeRenderer();
+
+// Forward declaration (defined later in Clock logic section)
+static void updateClockLogic();
+static void brightnessTick();  // Brightness section
+
+static std::atomic<bool> arduinoOtaActive{false};
+static std::atomic<uint32_t> arduinoOtaRuns{0};   // ArduinoOTA uploads since boot (they reuse the web OTA partition)
 
-  // Draw percentage text
-  char progressText[8];
-  snprintf(progressText, sizeof(progressText), "%u%%", progress);
+/**
+ * Full-screen OTA result (the renderer must be paused)
+ * @param detail Second line
+ */
+static void drawOtaMessage(bool ok, const char* detail) {
+  tft.fillScreen(TFT_BLACK);
   tft.setTextDatum(MC_DATUM);
-  tft.setTextColor(TFT_WHITE, TFT_BLACK);
+  tft.setTextColor(ok ? TFT_GREEN : TFT_RED, TFT_BLACK);
   tft.setTextFont(4);
-  tft.drawString(progressText, tft.width() / 2, barY + barHeight / 2);
-
-  // Draw size info below bar
-  tft.setTextDatum(TC_DATUM);
+  tft.drawString(ok ? "Update Complete!" : "Update Failed!", tft.width() / 2, tft.height() / 2 - 20);
   tft.setTextFont(2);
   tft.setTextColor(TFT_LIGHTGREY, TFT_BLACK);
-  tft.drawString("Please wait...", tft.width() / 2, barY + barHeight + 20);
+  tft.drawString(detail, tft.width() / 2, tft.height() / 2 + 20);
 }
 
 static void startOta() {
@@ -1438,43 +4142,37 @@ static void startOta() {
     DBG_INFO("OTA update started\n");
     // Set RGB LED to cyan (blue+green) during OTA
     setRGBLed(0, 1, 1);
-    // Clear screen for progress bar
-    tft.fillScreen(TFT_BLACK);
+    flushConfig();  // Don't lose debounced settings to the reboot
+    arduinoOtaRuns.fetch_add(1);
+    arduinoOtaActive.store(true);
+    // The clock keeps running; progress shows in the status bar (lit even inside the blank window)
+    powerWake();
+    otaProgressSet(0, 1);
   });
 
   ArduinoOTA.onProgress([](unsigned int progress, unsigned int total) {
-    unsigned int percent = (progress * 100) / total;
-    DBG_VERBOSE("OTA Progress: %u%% (%u/%u bytes)\n", percent, progress, total);
-    drawOTAProgress(percent);
+    otaProgressSet(progress, total);
+    // loop() is inside ArduinoOTA.handle() until the upload ends, so advance the clock from here
+    clockServiceTick();
+    updateClockLogic();
+    brightnessTick();
   });
 
   ArduinoOTA.onEnd([]() {
     DBG_INFO("OTA update completed\n");
-    // Display completion message
-    tft.fillScreen(TFT_BLACK);
-    tft.setTextDatum(MC_DATUM);
-    tft.setTextColor(TFT_GREEN, TFT_BLACK);
-    tft.setTextFont(4);
-    tft.drawString("Update Complete!", tft.width() / 2, tft.height() / 2 - 20);
-    tft.setTextFont(2);
-    tft.setTextColor(TFT_LIGHTGREY, TFT_BLACK);
-    tft.drawString("Restarting...", tft.width() / 2, tft.height() / 2 + 20);
-    // Green flash for successful update
-    flashRGBLed(0, 1, 0, 1000);
+    otaProgressEnd();
+    arduinoOtaActive.store(false);
+    pauseRenderer();
+    drawOtaMessage(true, "Restarting...");
+    // Green for successful update; hold the message before ArduinoOTA reboots
+    setRGBLed(0, 1, 0);
+    delay(1000);
   });
 
   ArduinoOTA.onError([](ota_error_t error) {
     DBG_ERROR("OTA update failed: error code %u\n", (unsigned)error);
-    // Display error message
-    tft.fillScreen(TFT_BLACK);
-    tft.setTextDatum(MC_DATUM);
-    tft.setTextColor(TFT_RED, TFT_BLACK);
-    tft.setTextFont(4);
-    tft.drawString("Update Failed!", tft.width() / 2, tft.height() / 2 - 20);
-
-    // Show error details
-    tft.setTextFont(2);
-    tft.setTextColor(TFT_LIGHTGREY, TFT_BLACK);
+    otaProgressEnd();
+    arduinoOtaActive.store(false);
     const char* errorMsg = "Unknown error";
     switch (error) {
       case OTA_AUTH_ERROR: errorMsg = "Auth Failed"; break;
@@ -1483,7 +4181,8 @@ static void startOta() {
       case OTA_RECEIVE_ERROR: errorMsg = "Receive Failed"; break;
       case OTA_END_ERROR: errorMsg = "End Failed"; break;
     }
-    tft.drawString(errorMsg, tft.width() / 2, tft.height() / 2 + 20);
+    pauseRenderer();
+    drawOtaMessage(false, errorMsg);
 
     // Red LED for error
     setRGBLed(1, 0, 0);
@@ -1492,10 +4191,330 @@ static void startOta() {
 
     // Return to normal display after 3 seconds
     tft.fillScreen(TFT_BLACK);
+    resumeRenderer();
   });
 
-  ArduinoOTA.begin();
-  DBG_OK("OTA ready.");
+  ArduinoOTA.begin();
+  DBG_OK("OTA ready.");
+}
+
+// =========================
+// Web OTA (/api/ota)
+// =========================
+/**
+ * Firmware upload through the HTTP task, so the render task keeps the clock running throughout.
+ * The body (multipart, one file) is a plain app image, a gzip of one, or an RCD1 delta against the
+ * running image, also gzipped (include/ota_delta.h, scripts/ota_delta.py). Decoded bytes are
+ * collected into whole flash sectors and written to the next OTA partition with one erase and one
+ * write each; esp_ota_set_boot_partition() verifies the image before it is booted.
+ *
+ * Uploads resume while the device stays up: ?id= names the upload, ?offset= is where this request's
+ * body starts in it and ?size= is its total length (without it, a plain image is complete once
+ * the length its segment headers add up to has arrived). When a connection drops, the session (decoder
+ * state included) waits OTA_RESUME_TIMEOUT_MS for the rest; GET /api/ota reports how far it got.
+ * Both need HTTP Basic auth (OTA_WEB_USER / OTA_PASSWORD). The session is only touched by the task
+ * that serves HTTP.
+ */
+enum WebOtaKind : uint8_t { WEB_OTA_UNKNOWN, WEB_OTA_IMAGE, WEB_OTA_DELTA };
+
+struct WebOtaInflate {
+  tinfl_decompressor inf;
+  uint32_t dictOfs;
+  uint8_t dict[TINFL_LZ_DICT_SIZE];   // tinfl writes into this window and refers back to it
+};
+
+struct WebOtaSession {
+  const esp_partition_t* part;
+  uint32_t id;            // client's upload id
+  uint32_t size;          // upload bytes in total (0 = unknown)
+  uint32_t received;      // upload bytes consumed; a resume must continue here
+  uint32_t flushed;       // image bytes in flash (sector multiple until the end)
+  uint32_t lastMs;        // last data received
+  uint32_t arduinoRuns;   // arduinoOtaRuns at start (one in between overwrote the partition)
+  WebOtaKind kind;
+  bool gzip;
+  bool gzDone;            // deflate stream ended (the gzip trailer is not checked)
+  const char* error;      // first failure
+  WebOtaInflate* z;       // gzip only
+  GzipHeader gzHdr;
+  OtaDelta delta;
+  OtaImageLength image;   // decoded bytes, so an upload without ?size= knows when it is complete
+  uint16_t sectorLen;
+  uint8_t sector[SPI_FLASH_SEC_SIZE];
+};
+
+static WebOtaSession* webOta = nullptr;
+static int webOtaReqCode = 0;                 // status decided at upload start (0 = accepted)
+static const char* webOtaReqError = nullptr;
+
+static void webOtaDrop() {
+  if (!webOta) return;
+  delete webOta->z;
+  delete webOta;
+  webOta = nullptr;
+  otaProgressEnd();
+}
+
+static bool webOtaFail(WebOtaSession& s, const char* msg) {
+  if (!s.error) s.error = msg ? msg : "decode failed";
+  return false;
+}
+
+// Write the buffered sector (the last one may be partial; its padding stays erased)
+static bool webOtaFlush(WebOtaSession& s) {
+  if (!s.sectorLen) return true;
+  const uint32_t len = (s.sectorLen + 3u) & ~3u;
+  memset(s.sector + s.sectorLen, 0xFF, len - s.sectorLen);
+  if (esp_partition_erase_range(s.part, s.flushed, SPI_FLASH_SEC_SIZE) != ESP_OK ||
+      esp_partition_write(s.part, s.flushed, s.sector, len) != ESP_OK) {
+    return webOtaFail(s, "flash write failed");
+  }
+  s.flushed += s.sectorLen;
+  s.sectorLen = 0;
+  return true;
+}
+
+// Decoded image bytes (OtaDelta::WriteFn)
+static bool webOtaWrite(void* ctx, const uint8_t* p, size_t n) {
+  WebOtaSession& s = *(WebOtaSession*)ctx;
+  if (n > s.part->size - s.flushed - s.sectorLen) return webOtaFail(s, "image larger than the OTA partition");
+  if (n && s.flushed + s.sectorLen == 0 && p[0] != OTA_IMAGE_MAGIC) return webOtaFail(s, "not an app image");
+  s.image.feed(p, n);
+  if (s.image.bad) return webOtaFail(s, "bad app image header");
+  while (n) {
+    const size_t k = min<size_t>(n, SPI_FLASH_SEC_SIZE - s.sectorLen);
+    memcpy(s.sector + s.sectorLen, p, k);
+    s.sectorLen += (uint16_t)k;
+    p += k;
+    n -= k;
+    if (s.sectorLen == SPI_FLASH_SEC_SIZE && !webOtaFlush(s)) return false;
+  }
+  return true;
+}
+
+// Delta base reads (OtaDelta::ReadBaseFn)
+static bool webOtaReadBase(void* ctx, uint32_t offset, uint8_t* p, size_t n) {
+  (void)ctx;
+  return esp_partition_read(esp_ota_get_running_partition(), offset, p, n) == ESP_OK;
+}
+
+// Uncompressed upload bytes: the first one tells a delta from an image
+static bool webOtaDecode(WebOtaSession& s, const uint8_t* p, size_t n) {
+  if (!n) return true;
+  if (s.kind == WEB_OTA_UNKNOWN) {
+    s.kind = p[0] == OTA_DELTA_MAGIC[0] ? WEB_OTA_DELTA : WEB_OTA_IMAGE;
+    if (s.kind == WEB_OTA_DELTA) {
+      s.delta.write = webOtaWrite;
+      s.delta.readBase = webOtaReadBase;
+      s.delta.ctx = &s;
+      s.delta.baseSha = esp_ota_get_app_description()->app_elf_sha256;
+      s.delta.baseSize = esp_ota_get_running_partition()->size;
+    }
+  }
+  if (s.kind == WEB_OTA_IMAGE) return webOtaWrite(&s, p, n);
+  return s.delta.feed(p, n) || webOtaFail(s, s.delta.error);
+}
+
+static bool webOtaInflate(WebOtaSession& s, const uint8_t* in, size_t n) {
+  WebOtaInflate& z = *s.z;
+  while (!s.gzDone) {
+    size_t inN = n;
+    size_t outN = TINFL_LZ_DICT_SIZE - z.dictOfs;
+    const tinfl_status st = tinfl_decompress(&z.inf, in, &inN, z.dict, z.dict + z.dictOfs, &outN,
+                                             TINFL_FLAG_HAS_MORE_INPUT);
+    in += inN;
+    n -= inN;
+    if (!webOtaDecode(s, z.dict + z.dictOfs, outN)) return false;
+    z.dictOfs = (z.dictOfs + (uint32_t)outN) & (TINFL_LZ_DICT_SIZE - 1);
+    if (st == TINFL_STATUS_DONE) s.gzDone = true;
+    else if (st < 0) return webOtaFail(s, "corrupt gzip data");
+    else if (st == TINFL_STATUS_NEEDS_MORE_INPUT && !n) break;
+  }
+  return true;
+}
+
+// Raw upload bytes, in order
+static bool webOtaFeed(WebOtaSession& s, const uint8_t* p, size_t n) {
+  if (!n) return true;
+  if (s.received == 0 && p[0] == 0x1F) {
+    s.gzip = true;
+    s.z = new (std::nothrow) WebOtaInflate;
+    if (!s.z) return webOtaFail(s, "out of memory");
+    tinfl_init(&s.z->inf);
+    s.z->dictOfs = 0;
+  }
+  s.received += (uint32_t)n;
+  if (!s.gzip) return webOtaDecode(s, p, n);
+  if (s.gzHdr.state != GzipHeader::DONE) {
+    const size_t k = s.gzHdr.feed(p, n);
+    p += k;
+    n -= k;
+    if (s.gzHdr.state == GzipHeader::BAD) return webOtaFail(s, "bad gzip header");
+    if (s.gzHdr.state != GzipHeader::DONE) return true;
+  }
+  return webOtaInflate(s, p, n);
+}
+
+static bool webOtaComplete(const WebOtaSession& s) {
+  if (s.gzip && !s.gzDone) return false;
+  if (s.kind == WEB_OTA_DELTA) return s.delta.done();
+  if (s.kind != WEB_OTA_IMAGE) return false;
+  return s.size ? s.received >= s.size : s.image.done();
+}
+
+static uint32_t argU32(const char* name) {
+  return server.hasArg(name) ? (uint32_t)strtoul(server.arg(name).c_str(), nullptr, 10) : 0;
+}
+
+static void webOtaReject(int code, const char* msg) {
+  webOtaReqCode = code;
+  webOtaReqError = msg;
+  DBG_WARN("Web OTA: %s\n", msg);
+}
+
+// Upload start: a new session at offset 0, otherwise the continuation of the current one
+static void webOtaBegin() {
+  webOtaReqCode = 0;
+  webOtaReqError = nullptr;
+  if (!server.authenticate(OTA_WEB_USER, OTA_PASSWORD)) return webOtaReject(401, "authentication required");
+  if (arduinoOtaActive.load()) return webOtaReject(409, "ArduinoOTA update in progress");
+
+  const uint32_t id = argU32("id");
+  const uint32_t offset = argU32("offset");
+  if (offset == 0) {
+    webOtaDrop();
+    const esp_partition_t* part = esp_ota_get_next_update_partition(nullptr);
+    if (!part) return webOtaReject(500, "no OTA partition");
+    webOta = new (std::nothrow) WebOtaSession();
+    if (!webOta) return webOtaReject(503, "out of memory");
+    webOta->part = part;
+    webOta->id = id;
+    webOta->arduinoRuns = arduinoOtaRuns.load();
+    DBG_INFO("Web OTA: upload %08x to %s (%u bytes)\n", (unsigned)id, part->label, (unsigned)argU32("size"));
+  } else if (!webOta || webOta->id != id || webOta->received != offset ||
+             webOta->arduinoRuns != arduinoOtaRuns.load()) {
+    return webOtaReject(409, "no upload to resume at this offset");
+  } else {
+    DBG_INFO("Web OTA: resuming %08x at %u\n", (unsigned)id, (unsigned)offset);
+  }
+
+  if (server.hasArg("size")) webOta->size = argU32("size");
+  webOta->lastMs = millis();
+  powerWake();
+  setRGBLed(0, 1, 1);
+  otaProgressSet(webOta->received, webOta->size);
+}
+
+static void handleOtaUpload() {
+  HTTPUpload& up = server.upload();
+  if (up.status == UPLOAD_FILE_START) {
+    webOtaBegin();
+    return;
+  }
+  if (webOtaReqCode || !webOta) return;
+  WebOtaSession& s = *webOta;
+  if (up.status == UPLOAD_FILE_WRITE) {
+    if (s.arduinoRuns != arduinoOtaRuns.load()) webOtaFail(s, "ArduinoOTA update took over the partition");
+    if (s.error) return;
+    webOtaFeed(s, up.buf, up.currentSize);
+    s.lastMs = millis();
+    otaProgressSet(s.received, s.size);
+  } else if (up.status == UPLOAD_FILE_ABORTED) {
+    DBG_WARN("Web OTA: connection lost at %u bytes, kept for resume\n", (unsigned)s.received);
+    otaProgressEnd();
+    setRGBLed(false, false, false);
+  }
+}
+
+static void sendOtaJson(int code, JsonDocument& doc) {
+  String out;
+  serializeJson(doc, out);
+  server.sendHeader("Cache-Control", "no-store");
+  server.send(code, "application/json", out);
+}
+
+/**
+ * POST /api/ota (after the upload callbacks) - 200 image verified and set to boot (then restarts),
+ * 202 upload ended before the image did (resume with ?offset=received), 4xx/5xx {"error"}
+ */
+static void handlePostOta() {
+  JsonDocument doc;
+  if (webOtaReqCode == 401) {
+    server.requestAuthentication();
+    return;
+  }
+  if (webOtaReqCode || !webOta) {
+    doc["error"] = webOtaReqError ? webOtaReqError : "no upload";
+    sendOtaJson(webOtaReqCode ? webOtaReqCode : 400, doc);
+    return;
+  }
+
+  WebOtaSession& s = *webOta;
+  if (!s.error && !webOtaComplete(s)) {
+    DBG_INFO("Web OTA: %u bytes so far, waiting for the rest\n", (unsigned)s.received);
+    otaProgressEnd();
+    setRGBLed(false, false, false);
+    doc["received"] = s.received;
+    sendOtaJson(202, doc);
+    return;
+  }
+  if (!s.error && webOtaFlush(s)) {
+    const esp_err_t err = esp_ota_set_boot_partition(s.part);
+    if (err != ESP_OK) {
+      DBG_ERROR("Web OTA: image rejected: %s\n", esp_err_to_name(err));
+      webOtaFail(s, "image verification failed");
+    }
+  }
+  if (s.error) {
+    DBG_ERROR("Web OTA failed: %s\n", s.error);
+    doc["error"] = s.error;
+    webOtaDrop();
+    flashRGBLed(1, 0, 0, 1000);
+    sendOtaJson(400, doc);
+    return;
+  }
+
+  DBG_OK("Web OTA complete, restarting.");
+  doc["written"] = s.flushed;
+  sendOtaJson(200, doc);
+  flushConfig();
+  otaProgressEnd();
+  pauseRenderer();
+  drawOtaMessage(true, "Restarting...");
+  setRGBLed(0, 1, 0);
+  delay(1000);
+  ESP.restart();
+}
+
+// GET /api/ota - current upload session, for resuming
+static void handleGetOta() {
+  if (!server.authenticate(OTA_WEB_USER, OTA_PASSWORD)) {
+    server.requestAuthentication();
+    return;
+  }
+  JsonDocument doc;
+  doc["active"] = webOta != nullptr;
+  doc["arduinoOta"] = arduinoOtaActive.load();
+  if (webOta) {
+    const WebOtaSession& s = *webOta;
+    doc["id"] = s.id;
+    doc["received"] = s.received;
+    doc["size"] = s.size;
+    doc["written"] = s.flushed + s.sectorLen;
+    doc["format"] = s.kind == WEB_OTA_DELTA ? "delta" : s.kind == WEB_OTA_IMAGE ? "image" : "unknown";
+    doc["gzip"] = s.gzip;
+    doc["partition"] = s.part->label;
+    doc["idleMs"] = millis() - s.lastMs;
+  }
+  sendOtaJson(200, doc);
+}
+
+// Drop a broken-off upload nobody resumed (HTTP task, between requests)
+static void webOtaTick() {
+  if (webOta && millis() - webOta->lastMs >= OTA_RESUME_TIMEOUT_MS) {
+    DBG_INFO("Web OTA: upload %08x expired\n", (unsigned)webOta->id);
+    webOtaDrop();
+  }
 }
 
 // =========================
@@ -1507,10 +4526,11 @@ static void formatTimeHHMMSS(struct tm& ti, char* out, size_t n) {
 }
 
 
-static uint32_t lastSecond = 0;
+static time_t lastClockEpoch = 0;
+// Written by updateClockLogic() (loop), read by drawFrame() (render task) under clockMux
 static char prevT[7] = "------";
 static char currT[7] = "------";
-static int morphStep = MORPH_STEPS;
+static int64_t morphStartUs = -(int64_t)MORPH_MS * 1000;  // esp_timer time of the last digit change
 
 /**
  * Format date according to user's selected format
@@ -1539,20 +4559,31 @@ static void formatDate(struct tm& ti, char* out, size_t n) {
 }
 
 static void updateClockLogic() {
-  struct tm ti{};
-  if (!getLocalTimeSafe(ti, 50)) return;
-
-  if ((uint32_t)ti.tm_sec == lastSecond) return;
-  lastSecond = (uint32_t)ti.tm_sec;
+  const ClockSnapshot clk = clockNow();
+  if (!clk.valid || clk.epoch == lastClockEpoch) return;
+  lastClockEpoch = clk.epoch;
+  struct tm ti = clk.tm;
 
   char t6[7] = {0};
   formatTimeHHMMSS(ti, t6, sizeof(t6));
-  formatDate(ti, currDate, sizeof(currDate));
+  char d[sizeof(currDate)];
+  formatDate(ti, d, sizeof(d));
+  if (strcmp(d, currDate) != 0) {
+    portENTER_CRITICAL(&clockMux);
+    memcpy(currDate, d, sizeof(currDate));
+    portEXIT_CRITICAL(&clockMux);
+    markStatusDirty(STATUS_DIRTY_DATE);
+    wakeRenderer();  // date row
+  }
 
   if (strncmp(t6, currT, 6) != 0) {
+    portENTER_CRITICAL(&clockMux);
     memcpy(prevT, currT, 7);
     memcpy(currT, t6, 7);
-    morphStep = 0;
+    // No transitions during an OTA: one frame per second keeps the CPU for the upload
+    morphStartUs = otaRunning() ? -(int64_t)MORPH_MS * 1000 : esp_timer_get_time();
+    portEXIT_CRITICAL(&clockMux);
+    wakeRenderer();
     if (cfg.use24h) {
       DBG("[TIME] %.2s:%.2s:%.2s\n", currT, currT+2, currT+4);
     } else {
@@ -1564,144 +4595,998 @@ static void updateClockLogic() {
 }
 
 /**
- * Draw a bitmap to the framebuffer with specified intensity
- * @param bm Bitmap to render
+ * Draw a glyph to the framebuffer with specified intensity
+ * @param g Glyph to render
  * @param x0 X position in framebuffer
  * @param y0 Y position in framebuffer
- * @param w Width of bitmap
  * @param intensity Brightness level (0-255), default 255
  */
-static void drawBitmapSolid(const Bitmap& bm, int x0, int y0, int w, uint8_t intensity = 255) {
-  for (int y=0; y<DIGIT_H; y++) {
-    for (int x=0; x<w; x++) {
-      bool on = (bm.rows[y] >> (15-x)) & 0x1;
-      if (!on) continue;
-      int yScaled = (y * LED_MATRIX_H) / DIGIT_H;
-      fbSet(x0 + x, y0 + yScaled, intensity);
-    }
+static void drawGlyphSolid(GlyphRef g, int x0, int y0, uint8_t intensity = 255) {
+  for (int y=0; y<g.h; y++) {
+    const uint32_t row = g.rows[y];
+    if (row) fbSetBits(x0, y0 + y, row, intensity);
   }
 }
 
 /**
- * Animated "spawn" morph effect for digit transitions
- * Pixels appear from random positions and move into their final positions
- * @param toBm Target bitmap to morph into
- * @param step Current animation step (0 to MORPH_STEPS)
- * @param x0 X position in framebuffer
- * @param y0 Y position in framebuffer
- * @param w Width of bitmap
+ * Draw a glyph shifted vertically, clipped to its own cell rows
+ * @param dy Row offset (negative = up)
  */
-static void drawSpawnMorphToTarget(const Bitmap& toBm, int step, int x0, int y0, int w) {
-  // Gather all ON pixels in target glyph
-  static Pt toPts[420];
-  int toN = buildPixelsFromBitmap(toBm, w, toPts, 420);
-  if (toN > 420) toN = 420;
+static void drawGlyphClipped(GlyphRef g, int x0, int y0, int dy, uint8_t intensity = 255) {
+  for (int y=0; y<g.h; y++) {
+    const int yy = y + dy;
+    if (yy < 0 || yy >= g.h) continue;
+    const uint32_t row = g.rows[y];
+    if (row) fbSetBits(x0, y0 + yy, row, intensity);
+  }
+}
+
+// =========================
+// Transition Engine
+// =========================
+// Digit transitions run on elapsed time (MORPH_MS), not frame count, so dropped frames never slow an
+// animation down. Progress is Q16 linear, shaped into Q8.8 (256 = 1.0) by each mode's easing curve
+// (include/easing.h); no floats per pixel.
+
+// One digit cell going from -> to
+struct TransitionCtx {
+  GlyphRef fromG;
+  GlyphRef toG;
+  GlyphRef digit0;     // glyph 0 of the same set (scramble picks other digits from it)
+  MorphSet* morph;     // particle tables for this set, or nullptr if unavailable
+  int from, to;        // digit values
+  int x0, y0;          // cell origin in fb
+  uint32_t linQ16;     // linear progress, 0..EASE_ONE_Q16
+  int ease;            // eased progress, Q8.8 (EASE_OUT_BACK overshoots 256)
+  uint32_t seed;       // per-cell value for pseudo-random effects
+};
+
+static inline int lin8(const TransitionCtx& t) { return (int)(t.linQ16 >> 8); }
+
+// Pixels fly out from the glyph centre into their final positions, fading in
+static void transitionSpawn(const TransitionCtx& t) {
+  const GlyphRef g = t.toG;
+  const int sx = (g.w - 1) * 128;   // spawn origin, Q8
+  const int sy = (g.h - 1) * 128;
+  const uint8_t alpha = (uint8_t)((255 * lin8(t)) >> 8);
+
+  for (int y=0; y<g.h; y++) {
+    const uint32_t row = g.rows[y];
+    if (!row) continue;
+    const int yf = sy + (((y * 256 - sy) * t.ease) >> 8);
+    for (int x=0; x<g.w; x++) {
+      if (!((row >> (31-x)) & 0x1)) continue;
+      const int xf = sx + (((x * 256 - sx) * t.ease) >> 8);
+      fbSet(t.x0 + ((xf + 128) >> 8), t.y0 + ((yf + 128) >> 8), alpha);
+    }
+  }
+}
+
+// Matched pixels travel to their partner in the new digit (precomputed tables)
+static void transitionParticle(const TransitionCtx& t) {
+  if (!t.morph) {
+    transitionSpawn(t);
+    return;
+  }
+  drawParticleMorph(*t.morph, t.from, t.to, t.ease, (uint8_t)((255 * lin8(t)) >> 8), t.x0, t.y0);
+}
 
-  // 0..1
-  float t = (float)step / (float)MORPH_STEPS;
-  if (t < 0) t = 0;
-  if (t > 1) t = 1;
+// Crossfade: pixels only in the old digit fade out, pixels only in the new one fade in
+static void transitionFade(const TransitionCtx& t) {
+  const int e = constrain(t.ease, 0, 256);
+  const uint8_t in = (uint8_t)((255 * e) >> 8);
+  const uint8_t out = (uint8_t)(255 - in);
+  for (int y=0; y<t.toG.h; y++) {
+    const uint32_t a = t.fromG.rows[y];
+    const uint32_t b = t.toG.rows[y];
+    if (!(a | b)) continue;
+    fbSetBits(t.x0, t.y0 + y, a & b, 255);
+    if (out) fbSetBits(t.x0, t.y0 + y, a & ~b, out);
+    if (in) fbSetBits(t.x0, t.y0 + y, b & ~a, in);
+  }
+}
 
-  // Ease-out (nice “snap into place”)
-  float te = 1.0f - (1.0f - t) * (1.0f - t);
+// Old digit scrolls up and out while the new one rises from below
+static void transitionSlide(const TransitionCtx& t) {
+  const int off = (t.toG.h * t.ease + 128) >> 8;
+  drawGlyphClipped(t.fromG, t.x0, t.y0, -off);
+  drawGlyphClipped(t.toG, t.x0, t.y0, t.toG.h - off);
+}
 
-  // Spawn origin inside the glyph (center-ish)
-  const float sx = (float)(w - 1) * 0.5f;
-  const float sy = (float)(DIGIT_H - 1) * 0.5f;
+// Flicker through pseudo-random digits, settling on the new one for the last quarter
+static void transitionScramble(const TransitionCtx& t) {
+  if (t.linQ16 >= EASE_ONE_Q16 * 3 / 4) {
+    drawGlyphSolid(t.toG, t.x0, t.y0);
+    return;
+  }
+  const uint32_t slot = t.linQ16 >> 12;   // new digit every 1/16 of the transition
+  const uint32_t h = (t.seed * 31u + slot) * 2654435761u;
+  const int d = (int)((h >> 16) % 10);
+  drawGlyphSolid(GlyphRef{t.digit0.rows + d * t.digit0.h, t.digit0.w, t.digit0.h}, t.x0, t.y0, 160);
+}
 
-  // Fade-in as it moves
-  uint8_t alpha = (uint8_t)(255 * t);
+struct Transition {
+  const char* name;
+  uint8_t ease;                            // EaseCurve applied to progress
+  void (*draw)(const TransitionCtx&);
+};
 
-  for (int i=0; i<toN; i++) {
-    float tx = (float)toPts[i].x;
-    float ty = (float)toPts[i].y;
+// Indexed by MorphStyle
+static const Transition TRANSITIONS[MORPH_STYLE_COUNT] = {
+  {"Particle",  EASE_IN_OUT_CUBIC, transitionParticle},
+  {"Spawn",     EASE_OUT_QUAD,     transitionSpawn},
+  {"Crossfade", EASE_LINEAR,       transitionFade},
+  {"Slide",     EASE_OUT_BACK,     transitionSlide},
+  {"Scramble",  EASE_LINEAR,       transitionScramble},
+};
 
-    float xf = sx + (tx - sx) * te;
-    float yf = sy + (ty - sy) * te;
+/**
+ * Draw text with the 5x7 character table, scaled up as far as the box allows and centred in it
+ * (characters without a glyph leave a blank cell)
+ */
+static void drawText5x7(const LayoutBox& box, const char* text, uint8_t intensity = 255) {
+  const int n = (int)strlen(text);
+  if (n == 0) return;
+  const int textW = n * 6 - 1;
+  int scale = min(box.w / textW, box.h / 8);
+  if (scale < 1) scale = 1;
+  if (scale > 32) scale = 32;
+
+  int x = box.x + (box.w - textW * scale) / 2;
+  const int y = box.y + (box.h - 7 * scale) / 2;
+  const uint32_t run = scale >= 32 ? 0xFFFFFFFFu : ~(0xFFFFFFFFu >> scale);   // scale set bits from bit 31
+  for (int i = 0; i < n; i++, x += 6 * scale) {
+    const uint8_t* rows = font5x7Char(text[i]);
+    if (!rows) continue;
+    for (int r = 0; r < 7; r++) {
+      // Each of the 5 columns widened to scale LEDs; written in 32-LED chunks
+      for (int c0 = 0; c0 < 5 * scale; c0 += 32) {
+        uint32_t bits = 0;
+        for (int c = 0; c < 5; c++) {
+          if (!(rows[r] & (0x10 >> c))) continue;
+          const int off = c * scale - c0;
+          if (off >= 32 || off + scale <= 0) continue;
+          bits |= off >= 0 ? run >> off : run << -off;
+        }
+        if (!bits) continue;
+        for (int sy = 0; sy < scale; sy++) fbSetBits(x + c0, y + r * scale + sy, bits, intensity);
+      }
+    }
+  }
+}
 
-    int x = (int)lroundf(xf);
-    int y = (int)lroundf(yf);
+// =========================
+// Retained Scene
+// =========================
+// The composed clock stays in sceneFb between frames. drawFrame() redraws a digit only when its value
+// or transition step changes and the date row only when its text does; the colons are painted once per
+// scene rebuild (boot or font change). Every redrawn item flags its dirty cells, so renderFBToTFT()
+// only diffs those. The fb slots rotate through the triple buffer, so each frame ends with a copy of
+// the scene into the current slot. Render task only.
+static FbRow sceneFb[LED_MATRIX_H];
+static uint32_t sceneDigitKey[6];     // (from << 28) | (to << 24) | (style << 20) | progress Q16, per digit
+static char sceneDate[sizeof(currDate)];
+static bool sceneDateValid = false;
+static const FontDesc* sceneFont = nullptr;
+
+static const uint32_t SCENE_KEY_NONE = 0xFFFFFFFFu;   // from = 15: never a real digit
+
+// Redraw every item on the next frame (the layout and colons stay)
+static void invalidateScene() {
+  for (int i = 0; i < 6; i++) sceneDigitKey[i] = SCENE_KEY_NONE;
+  sceneDateValid = false;
+}
 
-    int yScaled = (y * LED_MATRIX_H) / DIGIT_H;
-    fbSet(x0 + x, y0 + yScaled, alpha);
+// Flag the dirty cells overlapping columns [x0, x1)
+static void markSceneDirty(int x0, int x1) {
+  for (int i = 0; i < dirtyCellCount; i++) {
+    if (dirtyCellX[i] < x1 && dirtyCellX[i + 1] > x0) sceneDirtyCells |= 1u << i;
   }
 }
 
+// Turn off the scene LEDs in [x, x+w) x [y, y+h) (clipped to the matrix) and flag their cells
+static void sceneClearBox(int x, int y, int w, int h) {
+  const int x0 = max(x, 0);
+  const int x1 = min(x + w, LED_MATRIX_W);
+  const int y1 = min(y + h, LED_MATRIX_H);
+  if (x0 >= x1) return;
+  for (int yy = max(y, 0); yy < y1; yy++) fbClearSpan(sceneFb[yy], x0, x1);
+  markSceneDirty(x0, x1);
+}
+
 /**
- * Main frame rendering function - draws the complete clock display
- * Renders HH:MM:SS format with morphing animations on digit changes
- * Layout: 6 digits + 2 colons + 5 gaps, centered horizontally at top
+ * Main frame rendering function - brings the retained scene up to date and copies it into fb
+ * Renders HH:MM:SS format with morphing animations on digit changes, plus the date row on matrices
+ * tall enough for one. Positions come from computeLayout() (geometry + active font).
  */
 static void drawFrame() {
-  fbClear(0);
+  const FontDesc& font = activeFont();
+  const ClockLayout layout = computeLayout(font);
+  const int* cellX = layout.cellX;
+  const int y0 = layout.y0;
+  const int secY0 = layout.secY0;
+
+  // Consistent snapshot of the clock state (updated concurrently by loop())
+  char cur[7];
+  char prev[7];
+  char date[sizeof(currDate)];
+  int64_t startUs;
+  portENTER_CRITICAL(&clockMux);
+  memcpy(cur, currT, 7);
+  memcpy(prev, prevT, 7);
+  memcpy(date, currDate, sizeof(date));
+  startUs = morphStartUs;
+  portEXIT_CRITICAL(&clockMux);
+
+  // Transition progress from elapsed time, so speed is independent of the frame rate
+  const int64_t elapsedUs = esp_timer_get_time() - startUs;
+  const int64_t morphUs = (int64_t)MORPH_MS * 1000;
+  const uint32_t linQ16 = elapsedUs <= 0 ? 0
+                        : elapsedUs >= morphUs ? EASE_ONE_Q16
+                        : (uint32_t)((elapsedUs << 16) / morphUs);
+  const bool morphing = linQ16 < EASE_ONE_Q16;
+  const uint8_t style = cfg.morphStyle < MORPH_STYLE_COUNT ? cfg.morphStyle : 0;
+  const Transition& tr = TRANSITIONS[style];
+  const int ease = easeQ8(tr.ease, linQ16);
 
-  const int digitW = DIGIT_W;
-  const int colonW = COLON_W;
-  const int gap = DIGIT_GAP;
+  auto digitIdx = [&](char c)->int { return (c>='0' && c<='9') ? (c-'0') : 0; };
 
-  // HH:MM:SS with gaps between digit pairs for readability
-  // Total width = (6 * digitW) + (2 * colonW) + (5 * gap)
-  // Gaps: after each digit except the last one in each pair
-  const int totalW = (6 * digitW) + (2 * colonW) + (5 * gap);
-  int x0 = (LED_MATRIX_W - totalW) / 2;
-  if (x0 < 0) x0 = 0;
-  const int y0 = 0;  // Clock at top of display
+  // Particle tables follow the font; pairs of a newly selected font are matched on first use
+  const bool secSeparate = font.secRows != font.digitRows;
+  const bool particles = style == MORPH_STYLE_PARTICLE &&
+                         morphBind(morphBig, font.digit(0)) &&
+                         (!secSeparate || morphBind(morphSec, font.secDigit(0)));
+
+  FbRow* const slot = fb;
+  fb = sceneFb;   // the glyph and transition helpers draw through fb
+
+  // New font → new layout: one dirty-tracking cell per digit/colon, then everything from scratch
+  if (sceneFont != &font) {
+    setDirtyCells(cellX, 8);
+    fbClear(0);
+    drawGlyphSolid(font.colon(), cellX[2], y0, 255);
+    drawGlyphSolid(font.colon(), cellX[5], y0, 255);
+    invalidateScene();
+    sceneFont = &font;
+    sceneRebuilds++;
+  }
 
-  auto digitIdx = [&](char c)->int { return (c>='0' && c<='9') ? (c-'0') : 0; };
+  // Digits H H M M S S, and the layout cell each one sits in
+  static const uint8_t DIGIT_CELL[6] = {0, 1, 3, 4, 6, 7};
+  for (int pos = 0; pos < 6; pos++) {
+    const bool secs = pos >= 4;
+    const int to = digitIdx(cur[pos]);
+    const bool moving = morphing && cur[pos] != prev[pos];
+    const int from = moving ? digitIdx(prev[pos]) : to;
+    const uint32_t key = ((uint32_t)from << 28) | ((uint32_t)to << 24) |
+                         (moving ? ((uint32_t)style << 20) | linQ16 : EASE_ONE_Q16);
+    if (key == sceneDigitKey[pos]) continue;   // same glyph at the same step: already in the scene
+    sceneDigitKey[pos] = key;
+
+    const GlyphRef g = secs ? font.secDigit(to) : font.digit(to);
+    const int xx = cellX[DIGIT_CELL[pos]];
+    const int yy = secs ? secY0 : y0;
+    sceneClearBox(xx, yy, g.w, g.h);
+    sceneItemDraws++;
+    if (moving) {
+      // Digit changed → redraw whole digit with the selected transition
+      TransitionCtx t;
+      t.fromG = secs ? font.secDigit(from) : font.digit(from);
+      t.toG = g;
+      t.digit0 = secs ? font.secDigit(0) : font.digit(0);
+      t.morph = particles ? (secs && secSeparate ? &morphSec : &morphBig) : nullptr;
+      t.from = from;
+      t.to = to;
+      t.x0 = xx;
+      t.y0 = yy;
+      t.linQ16 = linQ16;
+      t.ease = ease;
+      t.seed = (uint32_t)pos;
+      tr.draw(t);
+    } else {
+      // Digit unchanged or morph finished → solid draw
+      drawGlyphSolid(g, xx, yy, 255);
+    }
+  }
 
-  // Indices for each digit
-  int c[6] = {
-    digitIdx(currT[0]), digitIdx(currT[1]),
-    digitIdx(currT[2]), digitIdx(currT[3]),
-    digitIdx(currT[4]), digitIdx(currT[5])
-  };
-  int p[6] = {
-    digitIdx(prevT[0]), digitIdx(prevT[1]),
-    digitIdx(prevT[2]), digitIdx(prevT[3]),
-    digitIdx(prevT[4]), digitIdx(prevT[5])
-  };
+  if (layout.date.h > 0 && (!sceneDateValid || strcmp(date, sceneDate) != 0)) {
+    const LayoutBox& b = layout.date;
+    sceneClearBox(b.x, b.y, b.w, b.h);
+    drawText5x7(b, date);
+    memcpy(sceneDate, date, sizeof(sceneDate));
+    sceneDateValid = true;
+    sceneItemDraws++;
+  }
+
+  fb = slot;
+  memcpy(fb, sceneFb, FB_BYTES);
+}
+
+// =========================
+// Brightness & auto-dim
+// =========================
+// The effective level (cfg.dimMode) is a perceived brightness. It reaches the TFT through the CIE table
+// as backlight PWM down to BACKLIGHT_MIN_DUTY; anything darker keeps the backlight at that floor and
+// dims the palette LUT instead, so night levels still go smoothly to black. loop() owns all of this;
+// the LDR is read once per LDR_SAMPLE_MS (one short ADC conversion) and averaged over a ring.
+static uint16_t ldrRing[LDR_AVG_SAMPLES];
+static uint8_t ldrPos = 0;
+static uint8_t ldrCount = 0;
+static uint32_t ldrSum = 0;
+static uint32_t lastLdrMs = 0;
+static uint8_t dimCurrent = 0;
+
+static void ldrSample() {
+  const uint16_t raw = (uint16_t)analogRead(LDR_PIN);
+  if (ldrCount == LDR_AVG_SAMPLES) ldrSum -= ldrRing[ldrPos];
+  else ldrCount++;
+  ldrRing[ldrPos] = raw;
+  ldrSum += raw;
+  ldrPos = (uint8_t)((ldrPos + 1) % LDR_AVG_SAMPLES);
+
+  const int avg = (int)(ldrSum / ldrCount);
+  const int level = (LDR_DARK_RAW - avg) * 255 / (LDR_DARK_RAW - LDR_BRIGHT_RAW);
+  ambientRaw.store((int16_t)avg, std::memory_order_relaxed);
+  ambientLevel.store((int16_t)constrain(level, 0, 255), std::memory_order_relaxed);
+}
+
+// True if hour lies in [nightStart, nightEnd), wrapping past midnight
+static bool inNightWindow(int hour) {
+  if (cfg.nightStart == cfg.nightEnd) return false;
+  if (cfg.nightStart < cfg.nightEnd) return hour >= cfg.nightStart && hour < cfg.nightEnd;
+  return hour >= cfg.nightStart || hour < cfg.nightEnd;
+}
+
+// Level the display should be at now
+static uint8_t dimTarget() {
+  // Blank (or the panel still asleep after a wake): the render task relights once a frame is up
+  if (displayBlank.load(std::memory_order_relaxed) || panelAsleep.load(std::memory_order_relaxed)) return 0;
+  const int day = cfg.brightness;
+  const int night = min<int>(cfg.nightBrightness, day);
+  switch (cfg.dimMode) {
+    case DIM_AUTO: {
+      const int a = ambientLevel.load(std::memory_order_relaxed);
+      return (uint8_t)(a < 0 ? day : night + (day - night) * a / 255);
+    }
+    case DIM_SCHEDULE: {
+      const ClockSnapshot clk = clockNow();
+      return (uint8_t)(clk.valid && inNightWindow(clk.tm.tm_hour) ? night : day);
+    }
+    default:
+      return (uint8_t)day;
+  }
+}
+
+/**
+ * Show a perceived brightness level: backlight duty from the CIE curve, with the part below
+ * BACKLIGHT_MIN_DUTY moved into the palette LUT (quantized to DIM_LUT_STEP, since each change
+ * repaints the matrix)
+ */
+static void applyDisplayLevel(uint8_t level) {
+  displayLevel.store(level, std::memory_order_relaxed);
+  const float y = (float)cieLuminance(level * 100.0 / 255.0);   // target luminance 0..1
+  const float floorY = BACKLIGHT_MIN_DUTY / 255.0f;
+  uint8_t duty = GAMMA_CIE[level];
+  int lut = 255;
+  if (level > 0 && y < floorY) {
+    const float want = y / floorY * 255.0f;   // pixel luminance that makes up the difference
+    lut = 1;   // the panel's own gamma is close to the CIE curve, so invert that for the pixel value
+    while (lut < 255 && GAMMA_CIE[lut] < want) lut++;
+    lut = constrain((lut + DIM_LUT_STEP / 2) / DIM_LUT_STEP * DIM_LUT_STEP, 1, 255);
+    duty = BACKLIGHT_MIN_DUTY;
+  }
+  setBacklight(level ? max<uint8_t>(duty, 1) : 0);
+  if (paletteLevel.exchange((uint8_t)lut, std::memory_order_relaxed) != lut) invalidatePalette();
+}
+
+static void initBrightness() {
+  pinMode(LDR_PIN, INPUT);
+  analogSetPinAttenuation(LDR_PIN, ADC_0db);   // the divider only spans a few hundred mV
+  dimCurrent = dimTarget();
+  applyDisplayLevel(dimCurrent);
+}
+
+// loop(): sample the LDR and move the display level towards dimTarget() by at most DIM_STEP per tick
+static void brightnessTick() {
+  const uint32_t now = millis();
+  const bool jump = dimApplyNow.exchange(false);
+  if (!jump && now - lastLdrMs < LDR_SAMPLE_MS) return;
+  if (now - lastLdrMs >= LDR_SAMPLE_MS) {
+    lastLdrMs = now;
+    ldrSample();
+  }
+
+  const int target = dimTarget();
+  int next = target;
+  if (!jump) next = constrain(target, dimCurrent - DIM_STEP, dimCurrent + DIM_STEP);
+  if (next == dimCurrent && !jump) return;
+  dimCurrent = (uint8_t)next;
+  applyDisplayLevel(dimCurrent);
+}
+
+// =========================
+// Power management
+// =========================
+// loop() owns the power state. Power save lowers the CPU clock and makes loop() and the HTTP / mirror
+// tasks block between passes (powerPollMs()), so both cores reach their idle task. Night blank fades
+// the display to 0 inside the night window, then the render task puts the panel to sleep and stops
+// drawing; a touch (XPT2046 PENIRQ, polled) or powerWake() shows the clock again for POWER_WAKE_MS.
+//
+// The idle hook waits for the next interrupt itself and adds that time up per core, which gives the
+// CPU load behind the current estimate. While automatic light sleep is on (CONFIG_PM_ENABLE builds,
+// blank only) it steps aside for the PM implementation and the model uses POWER_MA_LIGHT_SLEEP.
+static volatile uint32_t powerIdleUs[portNUM_PROCESSORS];   // WAITI time per core (wraps; deltas only)
+static uint32_t powerIdleLast[portNUM_PROCESSORS];
+static std::atomic<bool> powerLightSleep{false};
+static std::atomic<uint32_t> powerWakeMs{0};   // last wake; the clock also shows for POWER_WAKE_MS after boot
+static uint32_t powerFullMhz = 240;            // CPU clock at boot, used while power save is off
+static int8_t powerAppliedSave = -1;           // last mode powerApply() set up (-1 = none yet)
+static bool powerAppliedSleep = false;
+static uint32_t powerSampleMs = 0;
+static uint8_t touchLowPolls = 0;
+
+struct PowerStats {
+  float loadPct[portNUM_PROCESSORS];   // busy share of the last window, -1 = unknown (light sleep)
+  float estMa;                         // modelled current in the last window
+  double mAs;                          // integrated since boot
+  uint32_t spanMs;                     // time covered by mAs
+};
+static portMUX_TYPE powerMux = portMUX_INITIALIZER_UNLOCKED;
+static PowerStats powerStats = {};
+
+static bool powerIdleHook() {
+  if (powerLightSleep.load(std::memory_order_relaxed)) return true;
+  const int64_t t0 = esp_timer_get_time();
+  cpu_hal_waiti();
+  powerIdleUs[xPortGetCoreID()] += (uint32_t)(esp_timer_get_time() - t0);
+  return false;   // already waited; skips the WAITI in esp_vApplicationIdleHook()
+}
+
+// Show the clock now (any task): lifts night blank for POWER_WAKE_MS
+static void powerWake() {
+  powerWakeMs.store(millis());
+  if (displayBlank.exchange(false)) wakeRenderer();
+}
+
+// True once PENIRQ read low on two polls in a row (ADC conversions put short dips on GPIO36)
+static bool touchPressed() {
+#if TOUCH_IRQ_PIN >= 0
+  touchLowPolls = digitalRead(TOUCH_IRQ_PIN) == LOW ? (uint8_t)min(touchLowPolls + 1, 2) : 0;
+  return touchLowPolls == 2;
+#else
+  return false;
+#endif
+}
+
+/**
+ * Set the CPU clock (and light sleep) for a power mode; no-op if already applied
+ * @param lightSleep Allow automatic light sleep (only honoured in CONFIG_PM_ENABLE builds)
+ */
+static void powerApply(bool save, bool lightSleep) {
+  if (powerAppliedSave == (int8_t)save && powerAppliedSleep == lightSleep) return;
+  const uint32_t mhz = save ? POWER_SAVE_CPU_MHZ : powerFullMhz;
+  bool sleeping = false;
+#if CONFIG_PM_ENABLE
+  esp_pm_config_esp32_t pm = {};
+  pm.max_freq_mhz = (int)mhz;
+  pm.min_freq_mhz = lightSleep ? (int)getXtalFrequencyMhz() : (int)mhz;
+  pm.light_sleep_enable = lightSleep;
+  const esp_err_t err = esp_pm_configure(&pm);
+  if (err == ESP_OK) {
+    sleeping = lightSleep;
+  } else {
+    DBG_WARN("Power: esp_pm_configure failed (%d), fixed clock only\n", (int)err);
+    setCpuFrequencyMhz(mhz);
+  }
+#else
+  setCpuFrequencyMhz(mhz);
+#endif
+  // Modem sleep is the Arduino default; light sleep cannot start without it
+  if (save) WiFi.setSleep(true);
+  powerLightSleep.store(sleeping);
+  if (powerAppliedSave != (int8_t)save) DBG_INFO("Power: %s, CPU %u MHz\n", save ? "save" : "full", (unsigned)mhz);
+  if (powerAppliedSleep != lightSleep && sleeping) DBG_INFO("Power: automatic light sleep on\n");
+  powerAppliedSave = (int8_t)save;
+  powerAppliedSleep = lightSleep;
+}
+
+// Close one estimate window: CPU load from the idle hook, then the current model (POWER_MA_*)
+static void powerSample(uint32_t now) {
+  const uint32_t spanMs = now - powerSampleMs;
+  powerSampleMs = now;
+  if (!spanMs) return;
+  const bool sleeping = powerLightSleep.load();
+  float load[portNUM_PROCESSORS];
+  float meanLoad = 0;
+  for (int c = 0; c < portNUM_PROCESSORS; c++) {
+    const uint32_t idleUs = powerIdleUs[c];
+    const uint32_t idle = idleUs - powerIdleLast[c];
+    powerIdleLast[c] = idleUs;
+    load[c] = sleeping ? -1.0f : constrain(100.0f - idle / (spanMs * 10.0f), 0.0f, 100.0f);
+    meanLoad += max(load[c], 0.0f) / (100.0f * portNUM_PROCESSORS);
+  }
+
+  const float mhz = (float)getCpuFrequencyMhz();
+  float ma = POWER_MA_BOARD;
+  ma += sleeping ? POWER_MA_LIGHT_SLEEP
+                 : POWER_MA_CPU_BASE + mhz * (POWER_MA_CPU_IDLE_PER_MHZ + POWER_MA_CPU_BUSY_PER_MHZ * meanLoad);
+  if (WiFi.isConnected()) ma += POWER_MA_WIFI;
+  if (!panelAsleep.load(std::memory_order_relaxed)) ma += POWER_MA_TFT;
+  ma += POWER_MA_BACKLIGHT * backlightDuty.load(std::memory_order_relaxed) / 255.0f;
+  const double mAs = (double)ma * spanMs / 1000.0;
+
+  portENTER_CRITICAL(&powerMux);
+  for (int c = 0; c < portNUM_PROCESSORS; c++) powerStats.loadPct[c] = load[c];
+  powerStats.estMa = ma;
+  powerStats.mAs += mAs;
+  powerStats.spanMs += spanMs;
+  portEXIT_CRITICAL(&powerMux);
+}
+
+// /api/perf "power"
+static void addPowerJson(JsonObject o) {
+  portENTER_CRITICAL(&powerMux);
+  const PowerStats s = powerStats;
+  portEXIT_CRITICAL(&powerMux);
+  o["mode"] = cfg.powerSave ? "save" : "full";
+  o["cpuMhz"] = getCpuFrequencyMhz();
+  o["lightSleep"] = powerLightSleep.load();
+  o["blanked"] = displayBlank.load();
+  o["panelSleep"] = panelAsleep.load();
+  o["backlightDuty"] = backlightDuty.load();
+  JsonArray load = o["cpuLoad"].to<JsonArray>();
+  for (int c = 0; c < portNUM_PROCESSORS; c++) {
+    if (s.loadPct[c] < 0) load.add(nullptr);
+    else load.add(roundf(s.loadPct[c] * 10) / 10);
+  }
+  o["estMa"] = roundf(s.estMa * 10) / 10;
+  o["avgMa"] = s.spanMs ? roundf((float)(s.mAs * 10000.0 / s.spanMs)) / 10 : 0.0f;
+  o["mAh"] = s.mAs / 3600.0;
+  o["basis"] = "model";   // no current sensor on the board; see POWER_MA_* in config.h
+}
+
+static void initPower() {
+  powerFullMhz = getCpuFrequencyMhz();
+#if TOUCH_IRQ_PIN >= 0
+  pinMode(TOUCH_IRQ_PIN, INPUT);   // input-only pin; PENIRQ has its own pull-up
+#if CONFIG_PM_ENABLE
+  gpio_wakeup_enable((gpio_num_t)TOUCH_IRQ_PIN, GPIO_INTR_LOW_LEVEL);
+  esp_sleep_enable_gpio_wakeup();
+#endif
+#endif
+  for (int c = 0; c < portNUM_PROCESSORS; c++) {
+    if (esp_register_freertos_idle_hook_for_cpu(powerIdleHook, c) != ESP_OK) {
+      DBG_WARN("Power: idle hook on core %d not registered, load reads 100%%\n", c);
+    }
+  }
+  powerSampleMs = millis();
+  powerApply(cfg.powerSave, false);
+}
+
+// loop(): touch wake, night blank, power mode and the estimate window
+static void powerTick() {
+  const uint32_t now = millis();
+  if (touchPressed()) powerWake();
+
+  const ClockSnapshot clk = clockNow();
+  const bool night = cfg.nightBlank && clk.valid && inNightWindow(clk.tm.tm_hour);
+  const bool blank = night && now - powerWakeMs.load() >= POWER_WAKE_MS && !otaRunning();
+  if (displayBlank.exchange(blank) != blank) {
+    if (!blank) wakeRenderer();
+    requestStatePush();
+  }
+  static bool loggedBlank = false;
+  if (blank != loggedBlank) {
+    loggedBlank = blank;
+    DBG_INFO(blank ? "Power: display blank (night)\n" : "Power: display on\n");
+  }
+
+  // Light sleep stops the backlight PWM and the TFT's SPI clock, so only once the panel is off
+  powerApply(cfg.powerSave, cfg.powerSave && blank && panelAsleep.load());
+  if (now - powerSampleMs >= POWER_SAMPLE_MS) powerSample(now);
+}
+
+// =========================
+// Render task
+// =========================
+// Composes and pushes frames on its own FreeRTOS task so HTTP requests, NTP and sensor reads in
+// loop() never delay a frame. This task is the only one touching the TFT, sprite and palette while it
+// runs; other tasks post RENDER_REQ_* bits or pause it (OTA screens).
+//
+// Frame rate adapts: every FRAME_MS (vTaskDelayUntil) while a digit transition runs, otherwise the task
+// blocks until wakeRenderer() or IDLE_FRAME_MS, so a static clock costs one frame per second.
+// While the display is blank the panel sleeps and the task only waits for a wake (no frames at all).
+static std::atomic<bool> renderPauseReq{false};
+static std::atomic<bool> renderPaused{false};
+
+/**
+ * Stop the render task at a frame boundary and hand the TFT to the caller.
+ * Waits up to ~500 ms for the current frame to finish.
+ */
+static void pauseRenderer() {
+  if (!renderTaskHandle) return;
+  renderPauseReq.store(true);
+  xTaskNotifyGive(renderTaskHandle);   // a blank renderer waits without timeout
+  for (int i = 0; i < 50 && !renderPaused.load(); i++) delay(10);
+  if (!renderPaused.load()) DBG_WARN("Render task did not pause in time\n");
+}
+
+// Give the TFT back to the render task; the matrix and status bar are repainted
+static void resumeRenderer() {
+  postRenderRequest(RENDER_REQ_FULL);
+  renderPauseReq.store(false);
+}
 
-  int step = morphStep;
-  if (step > MORPH_STEPS) step = MORPH_STEPS;
+// Apply work posted by other tasks (runs on the render task before each frame)
+static void applyRenderRequests() {
+  uint32_t req = renderRequests.exchange(0, std::memory_order_acquire);
+  if (!req) return;
+  if (req & RENDER_REQ_ROTATION) {
+    applyDisplayRotation();
+    tft.fillScreen(TFT_BLACK);
+    initStatusBar();  // slot widths follow the new screen width
+    req |= RENDER_REQ_FULL;
+  }
+  if (req & RENDER_REQ_PITCH) updateRenderPitch();
+  if (req & RENDER_REQ_PALETTE) paletteValid = false;
+  if (req & RENDER_REQ_FULL) {
+    fbShownValid = false;
+    statusDirty.fetch_or(STATUS_DIRTY_ALL, std::memory_order_relaxed);
+  }
+}
+
+// True while a digit transition needs full-rate frames
+static bool renderAnimating() {
+  portENTER_CRITICAL(&clockMux);
+  const int64_t startUs = morphStartUs;
+  portEXIT_CRITICAL(&clockMux);
+  return esp_timer_get_time() - startUs < (int64_t)MORPH_MS * 1000;
+}
+
+/**
+ * Compose, push and publish one frame
+ * @param paced true if the frame was scheduled on the FRAME_MS grid (counts towards missed frames)
+ */
+static void renderOneFrame(bool paced) {
+  const int64_t frameStart = esp_timer_get_time();
+  perfFrameStart(frameStart, paced);
+  applyRenderRequests();
+  {
+    PerfScope ps(PERF_DRAW_FRAME);
+    drawFrame();
+  }
+  presentFrame();
+  publishFrame();
+  perfRecord(PERF_FRAME, (uint32_t)(esp_timer_get_time() - frameStart));
+}
+
+/**
+ * Panel sleep for night blank (render task only): SLPIN once the backlight is off, SLPOUT before
+ * drawing again (the controller needs 120 ms before the next command). Waking leaves panelAsleep
+ * set; the render task clears it once a fresh frame is in GRAM, so the backlight never shows the
+ * stale one.
+ */
+static void setPanelSleep(bool sleep) {
+  tft.writecommand(sleep ? TFT_SLPIN : TFT_SLPOUT);
+  if (sleep) {
+    panelAsleep.store(true);
+    return;
+  }
+  vTaskDelay(pdMS_TO_TICKS(120));
+  renderRequests.fetch_or(RENDER_REQ_FULL, std::memory_order_relaxed);
+}
+
+// Scroll/rotate step for the status bar between matrix frames (no frame is counted)
+static void statusBarTick() {
+  PerfScope ps(PERF_STATUS_BAR);
+  drawStatusBar();
+}
+
+static void renderTask(void*) {
+  TickType_t lastWake = xTaskGetTickCount();
+  uint32_t lastFrameMs = millis() - IDLE_FRAME_MS;   // first frame straight away
+  bool animating = false;
+  bool firstFrame = true;
+  for (;;) {
+    bool relight = false;
+    if (panelAsleep.load(std::memory_order_relaxed)) {
+      // Blank: nothing to draw until a wake, or until someone wants the TFT (pauseRenderer())
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      if (displayBlank.load() && !renderPauseReq.load()) continue;
+      setPanelSleep(false);
+      lastFrameMs = millis() - IDLE_FRAME_MS;   // frame straight away
+      lastWake = xTaskGetTickCount();
+      animating = false;
+      relight = true;
+    }
 
-  auto drawDigit = [&](int pos, int xx) {
-    if (currT[pos] != prevT[pos] && step < MORPH_STEPS) {
-      // Digit changed → redraw whole digit with spawn morph
-      drawSpawnMorphToTarget(DIGITS[c[pos]], step, xx, y0, digitW);
+    bool frameDue = true;
+    if (animating) {
+      vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(FRAME_MS));
     } else {
-      // Digit unchanged or morph finished → solid draw
-      drawBitmapSolid(DIGITS[c[pos]], xx, y0, digitW, 255);
+      // Sleep until the idle frame, a wake, or the next status bar scroll/rotate step
+      const uint32_t sinceFrame = millis() - lastFrameMs;
+      const uint32_t wait = min<uint32_t>(IDLE_FRAME_MS - min<uint32_t>(sinceFrame, IDLE_FRAME_MS), statusBarDueMs());
+      const bool woken = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(wait)) > 0;
+      frameDue = woken || relight || millis() - lastFrameMs >= IDLE_FRAME_MS;
+      lastWake = xTaskGetTickCount();
     }
-  };
+    renderWakePending.store(false, std::memory_order_relaxed);
+
+    if (renderPauseReq.load()) {
+      if (relight) panelAsleep.store(false);   // whoever paused us draws the screen now
+      renderPaused.store(true);
+      while (renderPauseReq.load()) vTaskDelay(pdMS_TO_TICKS(20));
+      renderPaused.store(false);
+      lastWake = xTaskGetTickCount();
+    }
+
+    if (!frameDue) {
+      statusBarTick();
+      continue;
+    }
+    lastFrameMs = millis();
+    // A frame composed at level 0 leaves the HUB75 planes dark too, so the panel can sleep after it
+    const bool darkFrame = displayBlank.load() && displayLevel.load(std::memory_order_relaxed) == 0;
+    renderOneFrame(animating);
+    animating = renderAnimating();
+    if (relight) {
+      panelAsleep.store(false);
+      dimApplyNow.store(true);   // backlight back on over the fresh frame (loop())
+    }
+    if (darkFrame && displayBlank.load() && !renderPauseReq.load()) setPanelSleep(true);
+    if (firstFrame) {
+      firstFrame = false;
+      bootMark("firstFrame");
+    }
+  }
+}
 
-  // HH with gap between digits
-  drawDigit(0, x0);
-  drawDigit(1, x0 + digitW + gap);
+static void startRenderTask() {
+  DBG_STEP("Starting render task...");
+  BaseType_t ok = xTaskCreatePinnedToCore(renderTask, "render", RENDER_TASK_STACK, nullptr,
+                                          RENDER_TASK_PRIO, &renderTaskHandle, RENDER_TASK_CORE);
+  if (ok != pdPASS) {
+    renderTaskHandle = nullptr;
+    DBG_ERR("Render task create failed, rendering from loop()");
+    return;
+  }
+  DBG_OK("Render task ready.");
+}
+
+
+#ifdef BENCH_FIRMWARE
+// =========================
+// Benchmark firmware (env:cyd_bench)
+// =========================
+// Runs from setup() before WiFi and the render task start, so nothing else competes for the core.
+// Every kernel gets identical input on each iteration; resetting it happens in the untimed prep step.
+static const uint32_t BENCH_ITERS = 50;
+
+static void benchEmit(const BenchResult& r) {
+  char line[192];
+  benchFormat(r, line, sizeof(line));
+  Serial.println(line);
+}
+
+static void benchSetClock(const char* cur, const char* prev, int64_t startUs) {
+  portENTER_CRITICAL(&clockMux);
+  memcpy(currT, cur, 7);
+  memcpy(prevT, prev, 7);
+  morphStartUs = startUs;
+  portEXIT_CRITICAL(&clockMux);
+}
+
+/**
+ * Time the render, morph and serialization hot paths and print one JSON line per kernel
+ * (include/bench.h), framed by benchStart / benchEnd lines
+ */
+static void runBenchmarks() {
+  const uint32_t n = BENCH_ITERS;
+  const int64_t morphUs = (int64_t)MORPH_MS * 1000;
+  const uint8_t savedStyle = cfg.morphStyle;
+  const FontDesc& font = activeFont();
+  const ClockLayout layout = computeLayout(font);
+  uint32_t kernels = 0;
+  auto emit = [&](const BenchResult& r) { benchEmit(r); kernels++; };
+
+  Serial.printf("{\"benchStart\":\"%s\",\"matrix\":[%d,%d],\"pitch\":%d,\"cpuMhz\":%u}\n",
+                FIRMWARE_VERSION, LED_MATRIX_W, LED_MATRIX_H, fbPitch, (unsigned)ESP.getCpuFreqMHz());
+
+  // Frame composition: all six digits halfway through a transition (19:59:59 -> 20:00:00)
+  for (uint8_t style = 0; style < MORPH_STYLE_COUNT; style++) {
+    cfg.morphStyle = style;
+    char name[40];
+    snprintf(name, sizeof(name), "drawFrame.%s", TRANSITIONS[style].name);
+    emit(benchRun(name, n,
+                  [&] {
+                    benchSetClock("200000", "195959", esp_timer_get_time() - morphUs / 2);
+                    invalidateScene();
+                  },
+                  [] { drawFrame(); }));
+  }
+  cfg.morphStyle = savedStyle;
+
+  // ... and the common idle frame: nothing changed, so only the scene copy
+  benchSetClock("123456", "123456", esp_timer_get_time() - 2 * morphUs);
+  drawFrame();
+  emit(benchRun("drawFrame.unchanged", n, [] { drawFrame(); }));
+
+  // Morph kernels on one digit cell (1 -> 8, halfway)
+  static Pt pts[FONT_MAX_GLYPH_PIXELS];
+  emit(benchRun("buildPixelsFromGlyph", n, [&] { buildPixelsFromGlyph(font.digit(8), pts, FONT_MAX_GLYPH_PIXELS); }));
+  if (morphBind(morphBig, font.digit(0))) {
+    emit(benchRun("morphPair.cold", n, [] { morphBig.ready[1] &= (uint16_t)~(1u << 8); },
+                  [] { morphPair(morphBig, 1, 8); }));
+    emit(benchRun("drawParticleMorph", n, [] { fbClear(0); },
+                  [&] { drawParticleMorph(morphBig, 1, 8, 128, 128, layout.cellX[0], layout.y0); }));
+  }
+  TransitionCtx t{};
+  t.fromG = font.digit(1);
+  t.toG = font.digit(8);
+  t.digit0 = font.digit(0);
+  t.from = 1;
+  t.to = 8;
+  t.x0 = layout.cellX[0];
+  t.y0 = layout.y0;
+  t.linQ16 = EASE_ONE_Q16 / 2;
+  t.ease = easeQ8(EASE_OUT_QUAD, t.linQ16);
+  emit(benchRun("transitionSpawn", n, [] { fbClear(0); }, [&] { transitionSpawn(t); }));
+
+  // Renderer: full repaint, then the common case of only the seconds cell changing
+  benchSetClock("123456", "123456", esp_timer_get_time() - 2 * morphUs);
+  drawFrame();
+  if (!paletteValid) rebuildPalette();
+  emit(benchRun("renderFBToTFT.full", n, [] { fbShownValid = false; }, [] { renderFBToTFT(); }));
+  uint32_t tick = 0;
+  emit(benchRun("renderFBToTFT.seconds", n,
+                [&] {
+                  benchSetClock((tick++ & 1) ? "123457" : "123456", "123456", esp_timer_get_time() - 2 * morphUs);
+                  drawFrame();
+                },
+                [] { renderFBToTFT(); }));
+
+  const LedGeometry saved = computeLedGeometry(fbPitch);
+  const LayoutBox v = renderView;
+  const DirtyRect all{v.x, v.y, (int16_t)(v.x + v.w - 1), (int16_t)(v.y + v.h - 1)};
+  uint16_t* sprBuf = (uint16_t*)spr.getPointer();
+  for (uint8_t shape = 0; shape < LED_SHAPE_COUNT; shape++) {
+    LedGeometry g = saved;
+    g.shape = shape;
+    rebuildDotStamp(g);
+    char name[40];
+    if (useSprite && sprBuf && dotStampValid) {
+      snprintf(name, sizeof(name), "blitLedRect.shape%u", shape);
+      emit(benchRun(name, n, [&] { blitLedRect(sprBuf, v.w * fbPitch, v.x, v.y, all, g); }));
+    }
+    if (useSprite) {
+      snprintf(name, sizeof(name), "paintLedRect.shape%u", shape);
+      emit(benchRun(name, n, [&] { paintLedRect(spr, -v.x * fbPitch, -v.y * fbPitch, all, g); }));
+    }
+  }
+  rebuildDotStamp(saved);
+  if (useSprite) {
+    emit(benchRun("pushSprite.full", 10, [] {
+      tft.startWrite();
+      spr.pushSprite((tft.width() - spr.width()) / 2, 0);
+      tft.endWrite();
+    }));
+  }
+
+  // Serialization: /api/state document and mirror frames
+  alignas(8) static uint8_t arenaMem[STATE_JSON_ARENA];
+  static ArenaAllocator arena(arenaMem, sizeof(arenaMem));
+  static char out[STATE_JSON_MAX];
+  emit(benchRun("stateJson", n, [] {
+    arena.reset();
+    JsonDocument doc(&arena);
+    buildStateJson(doc);
+    serializeJson(doc, out, sizeof(out));
+  }));
+  emit(benchRun("stateMsgPack", n, [] {
+    arena.reset();
+    JsonDocument doc(&arena);
+    buildStateJson(doc);
+    serializeMsgPack(doc, out, sizeof(out));
+  }));
+
+  static uint8_t frameA[LED_MATRIX_H][LED_MATRIX_W];
+  static uint8_t frameB[LED_MATRIX_H][LED_MATRIX_W];
+  static uint8_t msg[MIRROR_CODEC_HDR + LED_MATRIX_W * LED_MATRIX_H];
+  benchSetClock("123456", "123456", 0);
+  drawFrame();
+  for (int y = 0; y < LED_MATRIX_H; y++) fbRowBytes(fb[y], frameA[y]);
+  benchSetClock("123457", "123456", esp_timer_get_time() - morphUs / 2);
+  drawFrame();
+  for (int y = 0; y < LED_MATRIX_H; y++) fbRowBytes(fb[y], frameB[y]);
+  emit(benchRun("mirrorEncode.key", n, [] {
+    mirrorEncode(&frameB[0][0], nullptr, 2, 2, LED_MATRIX_W, LED_MATRIX_H, msg);
+  }));
+  emit(benchRun("mirrorEncode.delta", n, [] {
+    mirrorEncode(&frameB[0][0], &frameA[0][0], 2, 1, LED_MATRIX_W, LED_MATRIX_H, msg);
+  }));
+
+  Serial.printf("{\"benchEnd\":%u}\n", (unsigned)kernels);
+  requestFullRedraw();
+}
+#endif
+
+// =========================
+// Boot sequencer
+// =========================
+/**
+ * setup() only does what the first frame needs (config, display, render task) and returns; this
+ * one-shot task then brings up everything that waits on the network or flash, so the clock runs
+ * while WiFiManager connects. loop() leaves OTA, HTTP and the mirror state push alone until
+ * netServicesReady. SNTP starts from loopTask on the first GOT_IP (onWifiEvent()).
+ */
+static std::atomic<bool> netServicesReady{false};
+
+static void startWebServer() {
+  DBG_STEP("Starting WebServer + routes...");
+  serveStaticFiles();
+  server.on("/api/state", HTTP_GET, handleGetState);
+  server.on("/api/config", HTTP_POST, handlePostConfig);
+  server.on("/api/mirror", HTTP_GET, handleGetMirror);
+  server.on("/api/perf", HTTP_GET, handleGetPerf);
+  server.on("/api/timezones", HTTP_GET, handleGetTimezones);
+  server.on("/api/history", HTTP_GET, handleGetHistory);
+  server.on("/api/reset-wifi", HTTP_POST, handleResetWiFi);
+  server.on("/api/wake", HTTP_POST, handlePostWake);
+  server.on("/api/ota", HTTP_POST, handlePostOta, handleOtaUpload);
+  server.on("/api/ota", HTTP_GET, handleGetOta);
+  const char* collect[] = {"If-None-Match", "Accept-Encoding"};
+  server.collectHeaders(collect, 2);
+  server.begin();
+  startHttpTask();
+  DBG_OK("WebServer ready.");
+}
 
-  // :
-  drawBitmapSolid(COLON, x0 + 2*digitW + gap, y0, colonW, 255);
+static void bootNetServices() {
+  DBG_STEP("Mounting LittleFS...");
+  if (!LittleFS.begin(true)) {
+    DBG_ERR("LittleFS mount failed");
+  } else {
+    DBG_OK("LittleFS mounted");
+    initTimezoneCache();
+  }
+  bootMark("littlefs");
 
-  // MM with gap between digits
-  drawDigit(2, x0 + 2*digitW + gap + colonW + gap);
-  drawDigit(3, x0 + 3*digitW + 2*gap + colonW + gap);
+  startWifi();
+  bootMark("wifi");
+  // Connected before the event handler was in place (or the event was missed): SNTP still needs starting
+  if (WiFi.isConnected() && !ntpStarted.load()) ntpRestartPending.store(true);
 
-  // :
-  drawBitmapSolid(COLON, x0 + 4*digitW + 2*gap + colonW + gap, y0, colonW, 255);
+  startOta();
+  startWebServer();
+  startMirrorStream();
+  startTelemetryTask();
 
-  // SS with gap between digits
-  drawDigit(4, x0 + 4*digitW + 2*gap + 2*colonW + 2*gap);
-  drawDigit(5, x0 + 5*digitW + 3*gap + 2*colonW + 2*gap);
+  DBG("Ready. IP: %s\n", WiFi.isConnected() ? WiFi.localIP().toString().c_str() : "0.0.0.0");
+  netServicesReady.store(true);
+  bootMark("netReady");
+}
 
-  if (morphStep < MORPH_STEPS) morphStep++;
+static void bootTask(void*) {
+  bootNetServices();
+  vTaskDelete(nullptr);
 }
 
+static void startBootTask() {
+  BaseType_t ok = xTaskCreatePinnedToCore(bootTask, "boot", BOOT_TASK_STACK, nullptr, BOOT_TASK_PRIO,
+                                          nullptr, BOOT_TASK_CORE);
+  if (ok != pdPASS) {
+    DBG_WARN("Boot task create failed, starting network services inline\n");
+    bootNetServices();
+  }
+}
 
 // =========================
 // Setup / Loop
 // =========================
 void setup() {
   Serial.begin(115200);
-  delay(250);
+  cfgMutex = xSemaphoreCreateRecursiveMutex();
 
   DBGLN("");
   DBGLN("========================================");
@@ -1710,14 +5595,11 @@ void setup() {
 
   DBG("Version: %s\n", FIRMWARE_VERSION);
   DBG("Build: %s %s\n", __DATE__, __TIME__);
-  DBG("LED grid: %dx%d (fb size: %u bytes)\n", LED_MATRIX_W, LED_MATRIX_H, (unsigned)sizeof(fb));
+  DBG("LED grid: %dx%d (fb size: %u bytes x3)\n", LED_MATRIX_W, LED_MATRIX_H, (unsigned)FB_BYTES);
   DBG("TFT_eSPI version check...\n");
 
-  // Initialize RGB LED pins
-  pinMode(LED_R_PIN, OUTPUT);
-  pinMode(LED_G_PIN, OUTPUT);
-  pinMode(LED_B_PIN, OUTPUT);
-  setRGBLed(false, false, false);  // All off initially
+  // Initialize RGB LED pins and the flash timer
+  initRGBLed();
   DBG_OK("RGB LED initialized.");
 
   // Initialize boot button
@@ -1749,7 +5631,6 @@ void setup() {
   // Flash blue to indicate startup
   flashRGBLed(0, 0, 1, 500);
 
-  initBitmaps();
   loadConfig();
 
   // Reset WiFi if button was held during boot
@@ -1761,27 +5642,27 @@ void setup() {
     DBG_OK("WiFi credentials cleared!");
   }
 
-  DBG_STEP("Mounting LittleFS...");
-  if (!LittleFS.begin(true)) {
-    DBG_ERR("LittleFS mount failed");
-  } else {
-    DBG_OK("LittleFS mounted");
-  }
+  // Local time from the first frame (startNtp() sets TZ again once WiFi is up), on the RTC time
+  // kept across a soft reset or the NVS seed after a power loss
+  setenv("TZ", lookupTimezone(cfg.tz), 1);
+  tzset();
+  timeCacheSeed();
+  bootMark("config");
 
   // TFT init
   DBG_STEP("Initialising TFT...");
   tft.init();
   applyDisplayRotation();  // Apply rotation based on config
   tft.fillScreen(TFT_BLACK);
-  setBacklight(cfg.brightness);
+  initBrightness();
   DBG("TFT size (w x h): %d x %d\n", tft.width(), tft.height());
   DBG_OK("TFT ready.");
 
   // Create SMALL sprite for framebuffer rendering (avoid RAM issues)
   DBG_STEP("Creating framebuffer sprite (small)...");
   updateRenderPitch(true);
-  int sprW = LED_MATRIX_W * fbPitch;
-  int sprH = LED_MATRIX_H * fbPitch;
+  int sprW = renderView.w * fbPitch;
+  int sprH = renderView.h * fbPitch;
 
   if (useSprite) {
     int matrixAreaH = tft.height() - STATUS_BAR_H;
@@ -1795,61 +5676,77 @@ void setup() {
   } else {
     DBG_WARN("Sprite create FAILED. Falling back to direct draw (may flicker).");
   }
+  initDmaStrips();
+  initStatusBar();
+  initMorphTables();
+  precomputeMorphTables();
+  startDisplayBackends();
+  bootMark("display");
+#ifdef BENCH_FIRMWARE
+  runBenchmarks();
+#endif
 
-  // WiFi
-  startWifi();
-
-  // Sensor
-  sensorAvailable = testSensor();
-  if (sensorAvailable) {
-    updateSensorData();
-    lastSensorUpdate = millis();
-    DBG_OK("Sensor initialized and reading.");
-    // Green flash for sensor found
-    flashRGBLed(0, 1, 0);
-  } else {
-    DBG_WARN("No sensor detected. Temperature/humidity features disabled.");
-    // Yellow flash (red+green) for no sensor
-    flashRGBLed(1, 1, 0);
-  }
-
-  // NTP
-  startNtp();
-
-  // OTA
-  startOta();
+  initPower();
 
-  // Web
-  DBG_STEP("Starting WebServer + routes...");
-  serveStaticFiles();
-  server.on("/api/state", HTTP_GET, handleGetState);
-  server.on("/api/config", HTTP_POST, handlePostConfig);
-  server.on("/api/mirror", HTTP_GET, handleGetMirror);
-  server.on("/api/timezones", HTTP_GET, handleGetTimezones);
-  server.on("/api/reset-wifi", HTTP_POST, handleResetWiFi);
-  server.begin();
-  DBG_OK("WebServer ready.");
+  // Sensor probe and sampling run on their own task
+  startSensorTask();
 
-  DBG("Ready. IP: %s\n", WiFi.isConnected() ? WiFi.localIP().toString().c_str() : "0.0.0.0");
+  // Clock on screen now; WiFi, NTP, OTA and web follow in the background
+  clockServiceTick();
+  updateClockLogic();
+  startRenderTask();
+  startBootTask();
+  bootMark("setup");
 }
 
 void loop() {
-  ArduinoOTA.handle();
-  server.handleClient();
+  // OTA, the web server and the mirror stream are started by the boot task
+  const bool netReady = netServicesReady.load();
+  if (netReady) {
+    PerfScope ps(PERF_OTA);
+    ArduinoOTA.handle();
+  }
+  // HTTP is served by its own task; only poll here if it could not be created
+  if (netReady && !httpTaskHandle) {
+    PerfScope ps(PERF_HTTP);
+    server.handleClient();
+    webOtaTick();
+  }
 
+  if (ntpRestartPending.exchange(false)) startNtp();
+  clockServiceTick();
   updateClockLogic();
+  timeCacheTick();
+  brightnessTick();
+  powerTick();
+  configPersistTick();
+  if (netReady) mirrorStatePoll();
 
   // Update sensor data periodically
   uint32_t now = millis();
-  if (sensorAvailable && (now - lastSensorUpdate >= SENSOR_UPDATE_INTERVAL)) {
+  if (sensorAvailable && !sensorTaskHandle && (now - lastSensorUpdate >= SENSOR_UPDATE_INTERVAL)) {
+    PerfScope ps(PERF_SENSOR);
     updateSensorData();
     lastSensorUpdate = now;
   }
 
+  // Frames come from the render task; only draw here if it could not be created (same adaptive rate)
   static uint32_t lastFrame = 0;
-  if (now - lastFrame >= FRAME_MS) {
-    lastFrame = now;
-    drawFrame();
-    renderFBToTFT();
+  if (!renderTaskHandle) {
+    const bool animating = renderAnimating();
+    const uint32_t period = animating ? FRAME_MS : IDLE_FRAME_MS;
+    if (renderWakePending.exchange(false) || now - lastFrame >= period) {
+      lastFrame = now;
+      renderOneFrame(animating);
+    } else if (statusBarDueMs() == 0) {
+      statusBarTick();
+    }
+  }
+
+  perfLogVerbose();
+
+  // Power save / blank: block between passes so core 1 can idle (frames come from the render task)
+  if (renderTaskHandle && (cfg.powerSave || displayBlank.load())) {
+    vTaskDelay(pdMS_TO_TICKS(displayBlank.load() ? POWER_BLANK_LOOP_MS : POWER_SAVE_LOOP_MS));
   }
 }
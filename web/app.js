@@ -0,0 +1,813 @@
+/**
+ * CYD RGB LED Matrix (HUB75) Retro Clock - Web Interface JavaScript
+ *
+ * Features:
+ * - Live display mirror rendering with RGB LED Matrix (HUB75) emulation
+ * - Live push stream over WebSocket (frame deltas + state changes), 1 Hz polling fallback
+ * - Instant auto-apply for all configuration changes
+ * - Timezone dropdown with 88 options across 13 regions
+ * - NTP server dropdown with 9 preset servers
+ * - Date format selection (5 formats)
+ * - Debug level runtime adjustment
+ * - System diagnostics with formatted uptime and memory usage (includes firmware version)
+ * - Sensor history chart (binary /api/history)
+ * - Performance panel with per-stage timings (/api/perf)
+ * - Color picker with dirty input tracking to prevent override
+ * - Human-readable formatting utilities
+ */
+
+const $ = (id) => document.getElementById(id);
+
+const canvas = $("mirror");
+const ctx = canvas.getContext("2d");
+ctx.imageSmoothingEnabled = false;
+let mirrorPitch = 1;
+
+const TFT_W = 320;
+const TFT_H = 240;
+const STATUS_BAR_H = 50;  // Must match config.h (bottom status bar)
+let LED_W = 64;             // matrix size, taken from the mirror frame header
+let LED_H = 32;
+const WS_PORT = 81;        // Must match config.h (mirror stream)
+
+// Mirror wire format, must match include/mirror_codec.h
+const MIRROR_MAGIC = 0x4D;
+const MIRROR_VERSION = 1;
+const MIRROR_HDR = 10;
+const MIRROR_ENC = { RAW: 0, BITS: 1, RLE: 2, XOR_RLE: 3, SAME: 4 };
+
+// Perceived level -> linear drive, must match GAMMA_CIE in include/gamma.h
+const GAMMA_CIE = Array.from({ length: 256 }, (_, i) => {
+  const L = i * 100 / 255;
+  const y = L <= 8 ? L / 903.3 : Math.pow((L + 16) / 116, 3);
+  return Math.floor(y * 255 + 0.5);
+});
+
+let mirrorFrame = new Uint8Array(LED_W * LED_H);    // last decoded frame (stream and polling)
+let mirrorSeqHeld = -1;                             // its sequence number, -1 = none
+
+const dirtyInputs = new Set();  // Tracks user-modified fields to prevent override
+let timezonesLoaded = false;
+
+function rgbFromHex(hex) {
+  const v = parseInt(hex.replace("#",""), 16);
+  return { r: (v>>16)&255, g: (v>>8)&255, b: v&255 };
+}
+
+async function fetchState() {
+  const r = await fetch("/api/state", { cache: "no-store" });
+  return r.json();
+}
+
+async function fetchTimezones() {
+  const r = await fetch("/api/timezones", { cache: "no-cache" });  // revalidate via ETag, 304 when unchanged
+  return r.json();
+}
+
+async function populateTimezones() {
+  if (timezonesLoaded) return;
+
+  try {
+    const data = await fetchTimezones();
+    const select = $("tz");
+    select.innerHTML = "";  // Clear loading message
+
+    // Populate with optgroups for each region
+    data.regions.forEach(region => {
+      const optgroup = document.createElement("optgroup");
+      optgroup.label = region.name;
+
+      region.timezones.forEach(tz => {
+        const option = document.createElement("option");
+        option.value = tz.name;
+        option.textContent = tz.name;
+        optgroup.appendChild(option);
+      });
+
+      select.appendChild(optgroup);
+    });
+
+    timezonesLoaded = true;
+    console.log(`Loaded ${data.count} timezones in ${data.regions.length} regions`);
+  } catch (e) {
+    console.error("Failed to load timezones:", e);
+    $("tz").innerHTML = '<option value="">Failed to load timezones</option>';
+  }
+}
+
+function setMsg(s, ok=true) {
+  const el = $("msg");
+  el.textContent = s;
+  el.style.opacity = "0.9";
+  el.style.color = ok ? "#b6f2c2" : "#ffb3b3";
+  setTimeout(()=>{ el.style.opacity = "0.6"; }, 2500);
+}
+
+function formatUptime(seconds) {
+  const days = Math.floor(seconds / 86400);
+  const hours = Math.floor((seconds % 86400) / 3600);
+  const mins = Math.floor((seconds % 3600) / 60);
+  const secs = seconds % 60;
+
+  if (days > 0) return `${days}d ${hours}h ${mins}m`;
+  if (hours > 0) return `${hours}h ${mins}m ${secs}s`;
+  if (mins > 0) return `${mins}m ${secs}s`;
+  return `${secs}s`;
+}
+
+function formatBytes(bytes) {
+  if (bytes < 1024) return `${bytes} B`;
+  if (bytes < 1024 * 1024) return `${(bytes / 1024).toFixed(1)} KB`;
+  return `${(bytes / (1024 * 1024)).toFixed(2)} MB`;
+}
+
+async function setControls(state) {
+  // Time & Network
+  $("time").textContent = state.time;
+  const estimated = state.timeSource === "cache" ? "estimated, " : "";
+  $("date").textContent = state.timeSynced === false ? `${state.date} (${estimated}waiting for NTP)` : state.date;
+  $("wifi").textContent = state.wifi;
+  $("ip").textContent = state.ip;
+
+  // Environment (Sensor Data)
+  if (state.sensorAvailable) {
+    const tempUnit = state.useFahrenheit ? "°F" : "°C";
+    let temp = state.temperature;
+
+    // Convert to Fahrenheit if needed
+    if (state.useFahrenheit) {
+      temp = Math.round(temp * 9 / 5 + 32);
+    }
+
+    $("temperature").textContent = `${temp}${tempUnit}`;
+    $("humidity").textContent = `${state.humidity}%`;
+    $("sensorType").textContent = state.sensorType || "Unknown";
+  } else {
+    $("temperature").textContent = "No sensor";
+    $("humidity").textContent = "--";
+    $("sensorType").textContent = "Not detected";
+  }
+
+  // Hardware (static, but included for completeness)
+  if (state.board) $("board").textContent = state.board;
+  if (state.display) $("display").textContent = state.display;
+  if (state.sensors) $("sensors").textContent = state.sensors;
+  if (state.firmware) {
+    $("firmware").textContent = state.firmware;
+  }
+  if (state.otaEnabled !== undefined) {
+    $("ota").textContent = state.otaEnabled ? "Enabled" : "Disabled";
+  }
+
+  // System Resources
+  if (state.uptime !== undefined) {
+    $("uptime").textContent = formatUptime(state.uptime);
+  }
+  if (state.freeHeap !== undefined) {
+    $("freeHeap").textContent = formatBytes(state.freeHeap);
+  }
+  if (state.heapSize !== undefined && state.freeHeap !== undefined) {
+    const usedHeap = state.heapSize - state.freeHeap;
+    const usagePercent = ((usedHeap / state.heapSize) * 100).toFixed(1);
+    $("heapUsage").textContent = `${formatBytes(usedHeap)} / ${formatBytes(state.heapSize)} (${usagePercent}%)`;
+  }
+  if (state.heapFrag !== undefined) {
+    $("heapFrag").textContent = `${state.heapFrag}% (largest ${formatBytes(state.heapLargest)}, min free ${formatBytes(state.heapMinFree)})`;
+  }
+  if (state.cpuFreq !== undefined) {
+    $("cpuFreq").textContent = `${state.cpuFreq} MHz`;
+  }
+  if (state.displayLevel !== undefined) {
+    const ambient = state.ambient >= 0 ? `${state.ambient} (raw ${state.ambientRaw})` : "--";
+    $("displayLevel").textContent = `${state.displayLevel} / 255, ambient ${ambient}`;
+  }
+  if (state.telemetryMode !== undefined) {
+    $("telemetry").textContent = state.telemetryMode === 0 ? "Off"
+      : `${state.telemetryLinkUp ? "up" : "down"}, ${state.telemetrySent} sent, ${state.telemetryErrors} errors (${state.telemetryId})`;
+  }
+
+  // Debug Level
+  if (document.activeElement !== $("debugLevel") && state.debugLevel !== undefined) {
+    $("debugLevel").value = String(state.debugLevel);
+  }
+
+  // Load timezones on first run
+  await populateTimezones();
+
+  // Config fields
+  if (document.activeElement !== $("tz")) $("tz").value = state.tz || "";
+  if (document.activeElement !== $("ntp")) $("ntp").value = state.ntp || "";
+  if (document.activeElement !== $("use24h")) $("use24h").value = String(state.use24h);
+  if (document.activeElement !== $("dateFormat")) $("dateFormat").value = String(state.dateFormat || 0);
+  if (document.activeElement !== $("useFahrenheit")) $("useFahrenheit").value = String(state.useFahrenheit || false);
+
+  if (!dirtyInputs.has("ledd")) $("ledd").value = state.ledDiameter;
+  if (!dirtyInputs.has("ledg")) $("ledg").value = state.ledGap;
+  if (document.activeElement !== $("ledShape")) $("ledShape").value = String(state.ledShape || 0);
+  if (document.activeElement !== $("fontStyle")) $("fontStyle").value = String(state.fontStyle || 0);
+  if (document.activeElement !== $("morphStyle")) $("morphStyle").value = String(state.morphStyle || 0);
+  if (document.activeElement !== $("viewport")) $("viewport").value = String(state.viewport || 0);
+
+  // Don't update color picker if user is actively selecting or has made changes
+  if (document.activeElement !== $("col") && !dirtyInputs.has("col")) {
+    const col = (state.ledColor >>> 0).toString(16).padStart(6,"0");
+    $("col").value = "#" + col;
+  }
+
+  if (document.activeElement !== $("col2") && !dirtyInputs.has("col2") && state.ledColor2 !== undefined) {
+    $("col2").value = "#" + (state.ledColor2 >>> 0).toString(16).padStart(6,"0");
+  }
+  if (document.activeElement !== $("paletteMode")) $("paletteMode").value = String(state.paletteMode || 0);
+
+  if (!dirtyInputs.has("bl")) $("bl").value = state.brightness;
+  if (document.activeElement !== $("dimMode") && state.dimMode !== undefined) $("dimMode").value = String(state.dimMode);
+  if (!dirtyInputs.has("nightBl") && state.nightBrightness !== undefined) $("nightBl").value = state.nightBrightness;
+  if (!dirtyInputs.has("nightStart") && state.nightStart !== undefined) $("nightStart").value = state.nightStart;
+  if (!dirtyInputs.has("nightEnd") && state.nightEnd !== undefined) $("nightEnd").value = state.nightEnd;
+  if (document.activeElement !== $("nightBlank")) $("nightBlank").value = String(state.nightBlank || false);
+  if (document.activeElement !== $("powerSave")) $("powerSave").value = String(state.powerSave || false);
+  if (!dirtyInputs.has("mirrorFps") && state.mirrorFps !== undefined) $("mirrorFps").value = state.mirrorFps;
+  if (document.activeElement !== $("telemetryMode") && state.telemetryMode !== undefined) $("telemetryMode").value = String(state.telemetryMode);
+  if (!dirtyInputs.has("telemetryHost") && state.telemetryHost !== undefined) $("telemetryHost").value = state.telemetryHost;
+  if (!dirtyInputs.has("telemetryPort") && state.telemetryPort !== undefined) $("telemetryPort").value = state.telemetryPort;
+  if (!dirtyInputs.has("telemetryInterval") && state.telemetryInterval !== undefined) $("telemetryInterval").value = state.telemetryInterval;
+  if (!dirtyInputs.has("telemetryTopic") && state.telemetryTopic !== undefined) $("telemetryTopic").value = state.telemetryTopic;
+
+}
+
+async function fetchMirror() {
+  const url = mirrorSeqHeld >= 0 ? `/api/mirror?fmt=v1&ack=${mirrorSeqHeld}` : "/api/mirror?fmt=v1";
+  const r = await fetch(url, { cache: "no-store" });
+  // A frame we can't apply resets the sequence so the next poll fetches a keyframe
+  const data = await r.arrayBuffer();
+  syncMirrorSize(data);
+  mirrorSeqHeld = decodeMirrorFrame(data, mirrorFrame, mirrorSeqHeld);
+  return mirrorFrame;
+}
+
+// PackBits-style runs; with xor, runs are XORed onto the frame already held
+function rleDecode(src, frame, xor) {
+  let o = 0;
+  for (let i = 0; i < src.length && o < frame.length; ) {
+    const c = src[i++];
+    if (c < 0x80) {
+      for (let k = 0; k <= c && o < frame.length; k++, o++) frame[o] = xor ? frame[o] ^ src[i++] : src[i++];
+    } else {
+      const v = src[i++];
+      for (let k = 0; k < c - 0x80 + 3 && o < frame.length; k++, o++) frame[o] = xor ? frame[o] ^ v : v;
+    }
+  }
+}
+
+// Follow the matrix size in a frame header (chained panels); the held frame no longer applies
+function syncMirrorSize(data) {
+  const msg = new Uint8Array(data, 0, Math.min(data.byteLength, MIRROR_HDR));
+  if (msg.length < MIRROR_HDR || msg[0] !== MIRROR_MAGIC) return;
+  if (msg[8] === LED_W && msg[9] === LED_H) return;
+  LED_W = msg[8];
+  LED_H = msg[9];
+  mirrorFrame = new Uint8Array(LED_W * LED_H);
+  mirrorSeqHeld = -1;
+}
+
+/**
+ * Decode one mirror_codec.h message into frame (in place)
+ * Returns the message's sequence number, or -1 if it can't be applied (unknown version,
+ * size mismatch, or a delta against a frame other than heldSeq).
+ */
+function decodeMirrorFrame(data, frame, heldSeq) {
+  const msg = new Uint8Array(data);
+  if (msg.length < MIRROR_HDR || msg[0] !== MIRROR_MAGIC || msg[1] !== MIRROR_VERSION) return -1;
+  const enc = msg[2];
+  const lit = msg[3];
+  const seq = msg[4] | (msg[5] << 8);
+  const baseSeq = msg[6] | (msg[7] << 8);
+  if (msg[8] * msg[9] !== frame.length) return -1;
+  const p = msg.subarray(MIRROR_HDR);
+
+  switch (enc) {
+    case MIRROR_ENC.RAW:
+      frame.set(p.subarray(0, frame.length));
+      break;
+    case MIRROR_ENC.BITS:
+      for (let i = 0; i < frame.length; i++) frame[i] = (p[i >> 3] & (0x80 >> (i & 7))) ? lit : 0;
+      break;
+    case MIRROR_ENC.RLE:
+      rleDecode(p, frame, false);
+      break;
+    case MIRROR_ENC.XOR_RLE:
+      if (baseSeq !== heldSeq) return -1;
+      rleDecode(p, frame, true);
+      break;
+    case MIRROR_ENC.SAME:
+      if (baseSeq !== heldSeq) return -1;
+      break;
+    default:
+      return -1;
+  }
+  return seq;
+}
+
+async function saveConfig(persist = false) {
+  const state = await fetchState();
+
+  const tz = $("tz").value.trim() || state.tz;
+  const ntp = $("ntp").value.trim() || state.ntp;
+  const use24h = $("use24h").value === "true";
+  const dateFormat = parseInt($("dateFormat").value, 10) || 0;
+  const useFahrenheit = $("useFahrenheit").value === "true";
+  const nightBlank = $("nightBlank").value === "true";
+  const powerSave = $("powerSave").value === "true";
+
+  const ledDiameterRaw = parseInt($("ledd").value, 10);
+  const ledGapRaw = parseInt($("ledg").value, 10);
+  const brightness = parseInt($("bl").value, 10);
+  const dimMode = parseInt($("dimMode").value, 10) || 0;
+  const nightBrightnessRaw = parseInt($("nightBl").value, 10);
+  const nightStartRaw = parseInt($("nightStart").value, 10);
+  const nightEndRaw = parseInt($("nightEnd").value, 10);
+  const mirrorFpsRaw = parseInt($("mirrorFps").value, 10);
+  const telemetryMode = parseInt($("telemetryMode").value, 10) || 0;
+  const telemetryHost = $("telemetryHost").value.trim();
+  const telemetryPortRaw = parseInt($("telemetryPort").value, 10);
+  const telemetryIntervalRaw = parseInt($("telemetryInterval").value, 10);
+  const telemetryTopic = $("telemetryTopic").value.trim() || state.telemetryTopic;
+  const debugLevel = parseInt($("debugLevel").value, 10);
+
+  const { r, g, b } = rgbFromHex($("col").value);
+  const ledColor = (r<<16) | (g<<8) | b;
+  const c2 = rgbFromHex($("col2").value);
+  const ledColor2 = (c2.r<<16) | (c2.g<<8) | c2.b;
+  const paletteMode = parseInt($("paletteMode").value, 10) || 0;
+  const ledShape = parseInt($("ledShape").value, 10) || 0;
+  const fontStyle = parseInt($("fontStyle").value, 10) || 0;
+  const morphStyle = parseInt($("morphStyle").value, 10) || 0;
+  const viewport = parseInt($("viewport").value, 10) || 0;
+
+  const ledDiameter = Number.isFinite(ledDiameterRaw) ? ledDiameterRaw : state.ledDiameter;
+  const ledGap = Number.isFinite(ledGapRaw) ? ledGapRaw : state.ledGap;
+  const mirrorFps = Number.isFinite(mirrorFpsRaw) ? mirrorFpsRaw : state.mirrorFps;
+  const nightBrightness = Number.isFinite(nightBrightnessRaw) ? nightBrightnessRaw : state.nightBrightness;
+  const nightStart = Number.isFinite(nightStartRaw) ? nightStartRaw : state.nightStart;
+  const nightEnd = Number.isFinite(nightEndRaw) ? nightEndRaw : state.nightEnd;
+  const telemetryPort = Number.isFinite(telemetryPortRaw) ? telemetryPortRaw : state.telemetryPort;
+  const telemetryInterval = Number.isFinite(telemetryIntervalRaw) ? telemetryIntervalRaw : state.telemetryInterval;
+  const payload = { tz, ntp, use24h, dateFormat, useFahrenheit, ledDiameter, ledGap, ledShape, fontStyle, morphStyle, viewport, ledColor, ledColor2, paletteMode, brightness, dimMode, nightBrightness, nightStart, nightEnd, nightBlank, powerSave, mirrorFps, telemetryMode, telemetryHost, telemetryPort, telemetryInterval, telemetryTopic, debugLevel, persist };
+
+  const res = await fetch("/api/config", {
+    method: "POST",
+    headers: { "Content-Type": "application/json" },
+    body: JSON.stringify(payload)
+  });
+
+  if (!res.ok) {
+    setMsg("Save failed: " + (await res.text()), false);
+    return;
+  }
+  setMsg("Saved");
+  dirtyInputs.clear();
+}
+
+$("save").addEventListener("click", () => {
+  saveConfig(true).catch(e => setMsg(String(e), false));
+});
+
+// Flip display button handler
+$("flipBtn").addEventListener("click", async () => {
+  try {
+    // Fetch current state to get current flip setting
+    const currentState = await fetchState();
+    const currentFlip = currentState.flipDisplay || false;
+    const newFlip = !currentFlip;
+
+    const res = await fetch("/api/config", {
+      method: "POST",
+      headers: { "Content-Type": "application/json" },
+      body: JSON.stringify({ flipDisplay: newFlip })
+    });
+
+    if (!res.ok) {
+      setMsg("Flip failed: " + (await res.text()), false);
+      return;
+    }
+
+    setMsg(newFlip ? "Display flipped 180°" : "Display orientation normal");
+  } catch (e) {
+    setMsg(String(e), false);
+  }
+});
+
+// Show the clock for a while when night blank has turned the display off
+$("wakeBtn").addEventListener("click", async () => {
+  try {
+    const res = await fetch("/api/wake", { method: "POST" });
+    setMsg(res.ok ? "Display on" : "Wake failed: " + (await res.text()), res.ok);
+  } catch (e) {
+    setMsg(String(e), false);
+  }
+});
+
+// Reset WiFi button handler
+$("resetWifiBtn").addEventListener("click", async () => {
+  if (!confirm("Reset WiFi credentials? Device will restart in AP mode for reconfiguration.")) {
+    return;
+  }
+
+  try {
+    const res = await fetch("/api/reset-wifi", {
+      method: "POST",
+      headers: { "Content-Type": "application/json" }
+    });
+
+    if (!res.ok) {
+      setMsg("WiFi reset failed: " + (await res.text()), false);
+      return;
+    }
+
+    const data = await res.json();
+    setMsg(data.status || "WiFi reset initiated. Device restarting...");
+
+    // Show a message about reconnecting
+    setTimeout(() => {
+      setMsg("Device restarting... Connect to CYD-RetroClock-Setup AP to reconfigure WiFi.");
+    }, 2000);
+  } catch (e) {
+    // Device likely restarted, which is expected
+    setMsg("WiFi reset sent. Device restarting in AP mode...");
+  }
+});
+
+// Per-pixel LED coverage (0..255) for one pitch x pitch cell (matches rebuildDotStamp() in main.cpp)
+function buildDotMask(pitch, dot, inset, shape) {
+  const mask = new Uint8Array(pitch * pitch);
+  const c = inset + dot * 0.5;
+  const radius = dot * 0.5;
+  for (let sy = 0; sy < pitch; sy++) {
+    for (let sx = 0; sx < pitch; sx++) {
+      const inSquare = sx >= inset && sx < inset + dot && sy >= inset && sy < inset + dot;
+      let cov = 0;
+      if (shape === 0 || dot <= 2) {
+        cov = inSquare ? 255 : 0;
+      } else {
+        const d = Math.hypot(sx + 0.5 - c, sy + 0.5 - c);
+        if (shape === 1) {
+          cov = d <= radius ? 255 : 0;
+        } else {
+          const a = radius - d;
+          if (a >= 1) cov = 255;
+          else if (a > 0) cov = (a * 255) | 0;
+        }
+      }
+      mask[sy * pitch + sx] = cov;
+    }
+  }
+  return mask;
+}
+
+function renderMirror(buf, state) {
+  // IMPORTANT: This must exactly match the TFT rendering logic in main.cpp:394-475
+  // The TFT uses cfg.ledDiameter and cfg.ledGap to determine dot size and spacing
+
+  let ledDiameter = parseInt(state.ledDiameter, 10);
+  let ledGap = parseInt(state.ledGap, 10);
+  if (isNaN(ledDiameter)) ledDiameter = 5;
+  if (isNaN(ledGap)) ledGap = 0;
+
+  // Part of the matrix on the TFT (must match computeViewport() in main.cpp): [x, y, w, h]
+  const view = (state.view && state.view.length === 4) ? state.view : [0, 0, LED_W, LED_H];
+  const [vx, vy, vw, vh] = view;
+
+  const matrixAreaH = TFT_H - STATUS_BAR_H;
+  let maxPitch = Math.min(Math.floor(TFT_W / vw), Math.floor(matrixAreaH / vh));
+  if (maxPitch < 1) maxPitch = 1;
+  const pitch = maxPitch;
+  mirrorPitch = pitch;
+
+  if (canvas.width !== TFT_W || canvas.height !== TFT_H) {
+    canvas.width = TFT_W;
+    canvas.height = TFT_H;
+  }
+
+  // Match the TFT rendering logic exactly (main.cpp:405-419)
+  let gapWanted = ledGap;
+  if (gapWanted < 0) gapWanted = 0;
+  if (gapWanted > pitch - 1) gapWanted = pitch - 1;
+
+  let dot = pitch - gapWanted;
+  let maxDot = ledDiameter;
+  if (maxDot < 1) maxDot = 1;
+  if (dot > maxDot) dot = maxDot;
+  if (dot < 1) dot = 1;
+
+  const gap = pitch - dot;
+  const inset = Math.floor((pitch - dot) / 2);
+
+  // Palette bands (must match rebuildPalette() in main.cpp): band = rowBand[y] + colBand[x]
+  const bandColors = (state.paletteColors && state.paletteColors.length)
+    ? state.paletteColors.map(c => c >>> 0)
+    : [state.ledColor >>> 0];
+  const bands = bandColors.length;
+  const mode = state.paletteMode || 0;
+  const rowBand = new Array(LED_H).fill(0);
+  const colBand = new Array(LED_W).fill(0);
+  if (mode === 1 || mode === 3) {
+    for (let y = 0; y < LED_H; y++) rowBand[y] = Math.floor((y * bands) / LED_H);
+  } else if (mode === 2 && state.paletteCells) {
+    const cells = state.paletteCells;
+    for (let i = 0; i + 1 < cells.length; i++) {
+      for (let x = cells[i]; x < cells[i + 1]; x++) colBand[x] = Math.min(i, bands - 1);
+    }
+  }
+
+  const mask = buildDotMask(pitch, dot, inset, parseInt(state.ledShape, 10) || 0);
+  // Night dimming below the backlight floor lives in the palette (buildPaletteBand() in main.cpp)
+  const paletteLevel = state.paletteLevel !== undefined ? state.paletteLevel : 255;
+
+  ctx.fillStyle = "#000";
+  ctx.fillRect(0, 0, TFT_W, TFT_H);
+
+  const sprW = vw * pitch;
+  const sprH = vh * pitch;
+  const x0 = Math.floor((TFT_W - sprW) / 2);
+  const y0 = Math.floor((matrixAreaH - sprH) / 2);
+
+  // CRITICAL: The C++ framebuffer is declared as fb[LED_MATRIX_H][LED_MATRIX_W]
+  // which means fb[y][x], so in linear memory it's row-major: [row0][row1][row2]...
+  // Index calculation: buf[y * LED_W + x]
+
+  // Stamp each LED into an ImageData using the same dot mask as blitLedRect()
+  const img = ctx.createImageData(sprW, sprH);
+  const px = img.data;
+  for (let y = vy; y < vy + vh && y < LED_H; y++) {
+    for (let x = vx; x < vx + vw && x < LED_W; x++) {
+      const idx = y * LED_W + x;
+      const v = buf[idx];
+      if (!v) continue;
+
+
+      const base = bandColors[rowBand[y] + colBand[x]];
+      const baseR = (base >> 16) & 255;
+      const baseG = (base >> 8) & 255;
+      const baseB = base & 255;
+      for (let sy = 0; sy < pitch; sy++) {
+        for (let sx = 0; sx < pitch; sx++) {
+          const cov = mask[sy * pitch + sx];
+          if (!cov) continue;
+          const vv = cov === 255 ? v : (v * (cov + 1)) >> 8;
+          const drive = GAMMA_CIE[((vv * paletteLevel + 127) / 255) | 0];
+          const o = (((y - vy) * pitch + sy) * sprW + ((x - vx) * pitch + sx)) * 4;
+          px[o] = (baseR * drive / 255) | 0;
+          px[o + 1] = (baseG * drive / 255) | 0;
+          px[o + 2] = (baseB * drive / 255) | 0;
+        }
+      }
+    }
+  }
+  for (let i = 3; i < px.length; i += 4) px[i] = 255;
+  ctx.putImageData(img, x0, y0);
+
+  // Draw status bar only if STATUS_BAR_H > 0
+  if (STATUS_BAR_H > 0) {
+    const barY = TFT_H - STATUS_BAR_H;
+    if (barY >= 0) {
+      ctx.fillStyle = "#000";
+      ctx.fillRect(0, barY, TFT_W, STATUS_BAR_H);
+      ctx.strokeStyle = "#2a3a52";
+      ctx.beginPath();
+      ctx.moveTo(0, barY + 0.5);
+      ctx.lineTo(TFT_W, barY + 0.5);
+      ctx.stroke();
+
+      // Line 1: Temperature and Humidity (matching TFT display)
+      let sensorLine;
+      if (state.sensorAvailable) {
+        const displayTemp = state.useFahrenheit
+          ? Math.round(state.temperature * 9 / 5 + 32)
+          : state.temperature;
+        const tempUnit = state.useFahrenheit ? '°F' : '°C';
+        sensorLine = `Temp: ${displayTemp}${tempUnit}  Humidity: ${state.humidity}%`;
+      } else {
+        sensorLine = "Sensor: Not detected";
+      }
+      ctx.fillStyle = "#8ef1ff";
+      ctx.font = "14px monospace";
+      ctx.textBaseline = "top";
+      ctx.fillText(sensorLine, 6, barY + 6);
+      ctx.fillStyle = "#c8d6e6";
+      ctx.fillText(`${state.date}  ${state.tz}`, 6, barY + 26);
+    }
+  }
+}
+
+// Auto-apply on any config field change (instant feedback)
+["tz", "ntp", "use24h", "dateFormat", "useFahrenheit", "ledd", "ledg", "ledShape", "fontStyle", "morphStyle", "viewport", "col", "col2", "paletteMode", "bl", "dimMode", "nightBl", "nightStart", "nightEnd", "nightBlank", "powerSave", "mirrorFps", "telemetryMode", "telemetryHost", "telemetryPort", "telemetryInterval", "telemetryTopic", "debugLevel"].forEach((id) => {
+  const el = $(id);
+
+  // Immediate save on change for dropdowns and text inputs
+  el.addEventListener("change", () => {
+    dirtyInputs.add(id);
+    saveConfig().catch(e => setMsg(String(e), false));
+  });
+
+  // For number/color inputs, also apply on input (real-time updates as you drag/type)
+  if (["ledd", "ledg", "col", "col2", "bl", "nightBl"].includes(id)) {
+    el.addEventListener("input", () => {
+      dirtyInputs.add(id);
+      saveConfig().catch(e => setMsg(String(e), false));
+    });
+  }
+});
+
+async function fetchPerf(reset = false) {
+  const r = await fetch(reset ? "/api/perf?reset=1" : "/api/perf", { cache: "no-store" });
+  return r.json();
+}
+
+function renderPerf(perf) {
+  const budgetUs = perf.frameMs * 1000;
+  $("perfFrames").textContent = perf.frames;
+  $("perfMissed").textContent = perf.missedFrames;
+  $("perfFps").textContent = `${perf.fps.toFixed(1)} (${perf.activeFrames} active / ${perf.idleFrames} idle)`;
+  $("perfBudget").textContent = `${perf.frameMs} ms (idle ${perf.idleFrameMs} ms)`;
+  $("perfNvs").textContent = `${perf.nvsWrites} keys / ${perf.nvsSaves} saves${perf.configPending ? " (pending)" : ""}`;
+  $("perfBuild").textContent = `${perf.firmware} (${perf.build})`;
+  if (perf.power) {
+    const p = perf.power;
+    const load = p.cpuLoad.map(l => l === null ? "sleep" : `${l}%`).join(" / ");
+    const state = p.blanked ? ", blank" : "";
+    $("perfPower").textContent = `${p.estMa} mA now, ${p.avgMa} mA avg, ${p.mAh.toFixed(1)} mAh (${p.mode}, ${p.cpuMhz} MHz, load ${load}${state})`;
+  }
+
+  const rows = perf.stages.map(s => {
+    // Highlight stages whose worst case alone would blow the frame budget
+    const cls = s.max > budgetUs ? ' class="over"' : "";
+    return `<tr><td>${s.name}</td><td>${s.count}/${s.total}</td><td>${s.min}</td>` +
+           `<td>${s.avg}</td><td>${s.p99}</td><td${cls}>${s.max}</td></tr>`;
+  });
+  $("perfBody").innerHTML = rows.join("");
+}
+
+$("perfResetBtn").addEventListener("click", () => {
+  fetchPerf(true).then(renderPerf).catch(e => setMsg(String(e), false));
+});
+
+// =========================
+// Sensor history (/api/history)
+// =========================
+const HIST_NONE = -32768;
+
+async function fetchHistory() {
+  const r = await fetch("/api/history", { cache: "no-store" });
+  return r.arrayBuffer();
+}
+
+// Parse the binary history: 12-byte header, then int16 triples (temp*10, hum*10, (hPa-1000)*10)
+function parseHistory(buf) {
+  const v = new DataView(buf);
+  if (buf.byteLength < 12 || v.getUint8(0) !== 0x53 || v.getUint8(1) !== 0x48 || v.getUint8(2) !== 1) return null;
+  const count = v.getUint16(4, true);
+  const h = { periodS: v.getUint16(6, true), ageS: v.getUint32(8, true), temp: [], hum: [] };
+  for (let i = 0; i < count && 12 + i * 6 + 6 <= buf.byteLength; i++) {
+    const t = v.getInt16(12 + i * 6, true);
+    const u = v.getInt16(14 + i * 6, true);
+    h.temp.push(t === HIST_NONE ? null : t / 10);
+    h.hum.push(u === HIST_NONE ? null : u / 10);
+  }
+  return h;
+}
+
+function plotSeries(ctx, data, min, max, w, h, color) {
+  const span = Math.max(max - min, 1);
+  const step = w / Math.max(data.length - 1, 1);
+  ctx.strokeStyle = color;
+  ctx.lineWidth = 1.5;
+  ctx.beginPath();
+  let pen = false;
+  data.forEach((y, i) => {
+    if (y === null) { pen = false; return; }
+    const px = i * step;
+    const py = h - 6 - (y - min) / span * (h - 12);
+    if (pen) ctx.lineTo(px, py); else ctx.moveTo(px, py);
+    pen = true;
+  });
+  ctx.stroke();
+}
+
+function renderHistory(buf) {
+  const h = parseHistory(buf);
+  if (!h) return;
+  const fahr = $("useFahrenheit").value === "true";
+  const temp = h.temp.map(t => (t === null || !fahr) ? t : t * 9 / 5 + 32);
+  const range = (a) => {
+    const vals = a.filter(x => x !== null);
+    return vals.length ? [Math.min(...vals), Math.max(...vals)] : null;
+  };
+  const tr = range(temp);
+  const hr = range(h.hum);
+  const unit = fahr ? "°F" : "°C";
+  $("historyTemp").textContent = tr ? `${tr[0].toFixed(1)} – ${tr[1].toFixed(1)}${unit}` : "--";
+  $("historyHum").textContent = hr ? `${hr[0].toFixed(0)} – ${hr[1].toFixed(0)}%` : "--";
+  $("historyCount").textContent = `${temp.length} × ${h.periodS / 60} min`;
+
+  const canvas = $("historyChart");
+  const ctx = canvas.getContext("2d");
+  ctx.clearRect(0, 0, canvas.width, canvas.height);
+  if (tr) plotSeries(ctx, temp, tr[0] - 0.5, tr[1] + 0.5, canvas.width, canvas.height, "#ff8a65");
+  if (hr) plotSeries(ctx, h.hum, hr[0] - 2, hr[1] + 2, canvas.width, canvas.height, "#4fc3f7");
+}
+
+function refreshHistory() {
+  fetchHistory().then(renderHistory).catch(e => console.warn(e));
+}
+
+// =========================
+// Mirror stream (WebSocket push)
+// =========================
+let streamSocket = null;
+let streamLive = false;
+let streamState = null;
+let mirrorDirty = false;
+let clockBase = null;  // { secs, at } from the last pushed state, so the time field keeps ticking
+let polling = false;
+
+function applyMirrorMessage(data) {
+  syncMirrorSize(data);
+  mirrorSeqHeld = decodeMirrorFrame(data, mirrorFrame, mirrorSeqHeld);
+  if (mirrorSeqHeld < 0) {
+    // Out of sync with the device: reconnect to get a keyframe
+    if (streamSocket) streamSocket.close();
+    return;
+  }
+  mirrorDirty = true;
+}
+
+function applyStreamState(state) {
+  streamState = state;
+  setControls(state);
+  mirrorDirty = true;
+  const m = /^(\d+):(\d+):(\d+)$/.exec(state.time || "");
+  clockBase = m ? { secs: (+m[1]) * 3600 + (+m[2]) * 60 + (+m[3]), at: performance.now() } : null;
+}
+
+function connectStream() {
+  const ws = new WebSocket(`ws://${location.hostname}:${WS_PORT}/`);
+  streamSocket = ws;
+  ws.binaryType = "arraybuffer";
+  ws.onopen = () => { streamLive = true; };
+  ws.onmessage = (ev) => {
+    if (typeof ev.data === "string") applyStreamState(JSON.parse(ev.data));
+    else applyMirrorMessage(ev.data);
+  };
+  ws.onclose = () => {
+    // Polling takes over until the stream is back
+    const wasLive = streamLive;
+    streamLive = false;
+    streamSocket = null;
+    if (wasLive) tick();
+    setTimeout(connectStream, 3000);
+  };
+  ws.onerror = () => ws.close();
+}
+
+function drawLoop() {
+  if (streamLive && mirrorDirty && streamState) {
+    mirrorDirty = false;
+    renderMirror(mirrorFrame, streamState);
+  }
+  requestAnimationFrame(drawLoop);
+}
+
+// State is only pushed on change; advance the displayed time locally in between
+setInterval(() => {
+  if (!streamLive || !clockBase) return;
+  const t = (clockBase.secs + Math.floor((performance.now() - clockBase.at) / 1000)) % 86400;
+  const pad = (n) => String(n).padStart(2, "0");
+  $("time").textContent = `${pad(Math.floor(t / 3600))}:${pad(Math.floor(t / 60) % 60)}:${pad(t % 60)}`;
+}, 250);
+
+// Perf panel is pulled on its own slower cadence
+setInterval(() => { fetchPerf().then(renderPerf).catch(e => console.warn(e)); }, 2000);
+
+// History gains one point every few minutes
+setInterval(refreshHistory, 60000);
+refreshHistory();
+
+async function tick() {
+  if (streamLive || polling) return;  // stream delivers state and frames
+  polling = true;
+  try {
+    const state = await fetchState();
+    setControls(state);
+    const buf = await fetchMirror();
+    renderMirror(buf, state);
+  } catch (e) {
+    console.warn(e);
+  } finally {
+    polling = false;
+    if (!streamLive) setTimeout(tick, 1000);
+  }
+}
+
+tick();
+connectStream();
+requestAnimationFrame(drawLoop);